@@ -0,0 +1,317 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Google Benchmark suite for the RWS client, run against the bundled RWS simulator.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "Poco/Exception.h"
+#include "Poco/Net/Context.h"
+
+#include "abb_librws/rws_interface.h"
+#include "abb_librws/rws_rapid.h"
+#include "bench_allocations.h"
+#include "rws_simulator.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Struct definitions: BenchmarkEnvironment
+ */
+
+/**
+ * \brief A struct for the benchmarks' environment, i.e. a simulated controller on the loopback interface and a client.
+ *
+ * The simulator serves HTTPS (the library's clients only speak HTTPS), with the certificate and key given by the
+ * ABB_LIBRWS_BENCH_CERT and ABB_LIBRWS_BENCH_KEY environment variables, or a self-signed pair generated with openssl.
+ */
+struct BenchmarkEnvironment
+{
+  /**
+   * \brief A constructor, which starts the simulator and connects the client.
+   */
+  BenchmarkEnvironment()
+  {
+    RWSSimulator::Options options;
+    const char* certificate = std::getenv("ABB_LIBRWS_BENCH_CERT");
+    const char* key = std::getenv("ABB_LIBRWS_BENCH_KEY");
+
+    if (certificate && key)
+    {
+      options.certificate_file = certificate;
+      options.private_key_file = key;
+    }
+    else
+    {
+      std::filesystem::path directory = std::filesystem::temp_directory_path();
+      options.certificate_file = (directory / "abb_librws_bench_cert.pem").string();
+      options.private_key_file = (directory / "abb_librws_bench_key.pem").string();
+
+      std::string command = "openssl req -x509 -newkey rsa:2048 -nodes -subj /CN=localhost -days 1"
+                            " -keyout \"" + options.private_key_file + "\" -out \"" + options.certificate_file + "\"" +
+                            " > " + (directory / "abb_librws_bench_openssl.log").string() + " 2>&1";
+
+      if (std::system(command.c_str()) != 0)
+      {
+        error = "failed to generate a certificate (set ABB_LIBRWS_BENCH_CERT and ABB_LIBRWS_BENCH_KEY)";
+        return;
+      }
+    }
+
+    try
+    {
+      p_simulator.reset(new RWSSimulator(options));
+      p_simulator->start();
+      p_simulator->setRAPIDSymbol("T_ROB1", "Bench", "target",
+                                  "[[515,0,712],[0.5,0,0.866025,0],[0,0,0,0],"
+                                  "[9E+09,9E+09,9E+09,9E+09,9E+09,9E+09]]",
+                                  "robtarget");
+
+      Poco::Net::Context::Ptr p_context = new Poco::Net::Context(Poco::Net::Context::CLIENT_USE, "", "", "",
+                                                                 Poco::Net::Context::VERIFY_NONE);
+      p_interface.reset(new RWSInterface("127.0.0.1", p_simulator->getPort(), p_context));
+
+      // Warm up (i.e. connect and authenticate).
+      if (p_interface->getIOSignal("BENCH_DI").empty())
+      {
+        error = "the client failed to communicate with the simulator";
+      }
+    }
+    catch (const Poco::Exception& e)
+    {
+      error = "failed to start the simulator: " + e.displayText();
+    }
+  }
+
+  /**
+   * \brief The simulated controller.
+   */
+  std::unique_ptr<RWSSimulator> p_simulator;
+
+  /**
+   * \brief The client.
+   */
+  std::unique_ptr<RWSInterface> p_interface;
+
+  /**
+   * \brief The reason the environment isn't usable (empty if it is).
+   */
+  std::string error;
+};
+
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief A function for retrieving the (shared) benchmark environment.
+ *
+ * \return BenchmarkEnvironment& reference to the environment.
+ */
+static BenchmarkEnvironment& getEnvironment()
+{
+  static BenchmarkEnvironment environment;
+  return environment;
+}
+
+/**
+ * \brief A function for running a benchmark's iterations, and reporting latency percentiles and allocations per call.
+ *
+ * Reported counters: p50_us, p90_us and p99_us (latency percentiles), allocs_per_call (heap allocations made by the
+ * call on the calling thread, i.e. excluding the simulator's threads and any helper threads of the client pool) and
+ * items_per_second (throughput).
+ *
+ * \param state for the benchmark's state.
+ * \param call for the measured call (returns if it succeeded).
+ */
+template <typename Call>
+static void measure(benchmark::State& state, Call call)
+{
+  BenchmarkEnvironment& environment = getEnvironment();
+
+  if (!environment.error.empty())
+  {
+    state.SkipWithError(environment.error.c_str());
+    return;
+  }
+
+  std::vector<double> latencies;
+  latencies.reserve(1 << 16);
+  size_t allocations = 0;
+  size_t failures = 0;
+
+  for (auto _ : state)
+  {
+    size_t allocations_before = getAllocationCount();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    bool success = call(environment);
+
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    allocations += getAllocationCount() - allocations_before;
+
+    latencies.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+    failures += (success ? 0 : 1);
+  }
+
+  if (!latencies.empty())
+  {
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_us"] = latencies[latencies.size() * 50 / 100];
+    state.counters["p90_us"] = latencies[latencies.size() * 90 / 100];
+    state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+    state.counters["allocs_per_call"] = double(allocations) / latencies.size();
+    state.counters["failures"] = double(failures);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+/***********************************************************************************************************************
+ * Benchmarks
+ */
+
+static void BM_GetIOSignal(benchmark::State& state)
+{
+  measure(state, [](BenchmarkEnvironment& environment)
+  {
+    return !environment.p_interface->getIOSignal("BENCH_DI").empty();
+  });
+}
+BENCHMARK(BM_GetIOSignal)->UseRealTime();
+
+static void BM_SetIOSignal(benchmark::State& state)
+{
+  bool high = false;
+
+  measure(state, [&high](BenchmarkEnvironment& environment)
+  {
+    high = !high;
+    return environment.p_interface->setIOSignal("BENCH_DO", high ? "1" : "0");
+  });
+}
+BENCHMARK(BM_SetIOSignal)->UseRealTime();
+
+static void BM_GetRAPIDSymbolDataNum(benchmark::State& state)
+{
+  RAPIDNum value;
+
+  measure(state, [&value](BenchmarkEnvironment& environment)
+  {
+    return environment.p_interface->getRAPIDSymbolData("T_ROB1", "Bench", "counter", &value);
+  });
+}
+BENCHMARK(BM_GetRAPIDSymbolDataNum)->UseRealTime();
+
+static void BM_GetRAPIDSymbolDataRobTarget(benchmark::State& state)
+{
+  RobTarget value;
+
+  measure(state, [&value](BenchmarkEnvironment& environment)
+  {
+    return environment.p_interface->getRAPIDSymbolData("T_ROB1", "Bench", "target", &value);
+  });
+}
+BENCHMARK(BM_GetRAPIDSymbolDataRobTarget)->UseRealTime();
+
+static void BM_GetMechanicalUnitRobTarget(benchmark::State& state)
+{
+  RobTarget value;
+
+  measure(state, [&value](BenchmarkEnvironment& environment)
+  {
+    return environment.p_interface->getMechanicalUnitRobTarget(SystemConstants::General::MECHANICAL_UNIT_ROB_1,
+                                                                &value);
+  });
+}
+BENCHMARK(BM_GetMechanicalUnitRobTarget)->UseRealTime();
+
+static void BM_CollectRuntimeInfo(benchmark::State& state)
+{
+  measure(state, [](BenchmarkEnvironment& environment)
+  {
+    return environment.p_interface->collectRuntimeInfo().rws_connected;
+  });
+}
+BENCHMARK(BM_CollectRuntimeInfo)->UseRealTime();
+
+static void BM_SubscriptionEvents(benchmark::State& state)
+{
+  BenchmarkEnvironment& environment = getEnvironment();
+  bool subscribed = false;
+
+  if (environment.error.empty())
+  {
+    RWSClient::SubscriptionResources resources;
+    resources.addIOSignal("BENCH_EVENT", RWSClient::SubscriptionResources::MEDIUM);
+    subscribed = environment.p_interface->startSubscription(resources);
+  }
+
+  bool high = false;
+
+  // Each iteration changes the signal in the simulator, and waits for the client to receive the event.
+  measure(state, [&high, subscribed](BenchmarkEnvironment& environment)
+  {
+    high = !high;
+    environment.p_simulator->setIOSignal("BENCH_EVENT", high ? "1" : "0");
+    return subscribed && environment.p_interface->waitForSubscriptionEvent();
+  });
+
+  if (subscribed)
+  {
+    environment.p_interface->endSubscription();
+  }
+}
+BENCHMARK(BM_SubscriptionEvents)->UseRealTime();
+
+} // end namespace rws
+} // end namespace abb
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Global operator new/delete replacements that count heap allocations for the benchmarks and tests.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "bench_allocations.h"
+
+/**
+ * \brief The number of heap allocations made by the current thread.
+ *
+ * Counted per thread, so that allocations of other threads in the process (e.g. the in-process simulator's server
+ * threads) aren't attributed to the measured calls.
+ */
+static thread_local size_t allocation_count = 0;
+
+/**
+ * \brief The number of bytes allocated on the heap by the current thread.
+ */
+static thread_local size_t allocated_bytes = 0;
+
+void* operator new(std::size_t size)
+{
+  ++allocation_count;
+  allocated_bytes += size;
+
+  if (void* p = std::malloc(size == 0 ? 1 : size))
+  {
+    return p;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+size_t getAllocationCount()
+{
+  return allocation_count;
+}
+
+size_t getAllocatedBytes()
+{
+  return allocated_bytes;
+}
+
+} // end namespace rws
+} // end namespace abb
@@ -0,0 +1,74 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Per-thread heap allocation counters used by the benchmarks and tests.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_BENCH_ALLOCATIONS_H
+#define RWS_BENCH_ALLOCATIONS_H
+
+#include <cstddef>
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A function for retrieving the number of heap allocations made by the calling thread.
+ *
+ * The count is kept (per thread) by the global operator new replacement in bench_allocations.cpp, which must be linked
+ * into the benchmark (or test) executable.
+ *
+ * \return size_t containing the number of allocations.
+ */
+size_t getAllocationCount();
+
+/**
+ * \brief A function for retrieving the number of bytes allocated on the heap by the calling thread.
+ *
+ * E.g. for checking that a (large) request body isn't copied, since a copy allocates at least the body's size.
+ *
+ * \return size_t containing the number of bytes (freed memory is not subtracted).
+ */
+size_t getAllocatedBytes();
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
@@ -0,0 +1,416 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Google Benchmark suite for RAPID data parsing and serialization.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "abb_librws/rws_rapid.h"
+#include "abb_librws/rws_rapid_schema.h"
+#include "abb_librws/rws_state_machine_interface.h"
+#include "bench_allocations.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Struct definitions: RecordProbe
+ */
+
+/**
+ * \brief A struct for exposing a RAPID record's (protected) string helpers to the benchmarks.
+ */
+struct RecordProbe : public RAPIDRecord
+{
+  /**
+   * \brief A default constructor.
+   */
+  RecordProbe() : RAPIDRecord("probe") {}
+
+  using RAPIDRecord::countCharInString;
+  using RAPIDRecord::extractDelimitedSubstrings;
+};
+
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief A function for retrieving a representative value string of a RAPID record type.
+ *
+ * The custom StateMachine records use the string constructed from a default instance.
+ *
+ * \return std::string containing the value string.
+ */
+template <typename T>
+static std::string getSample()
+{
+  return T().constructString();
+}
+
+template <>
+std::string getSample<RobTarget>()
+{
+  return "[[515,0,712],[0.5,0,0.866025,0],[0,0,0,0],[9E+09,9E+09,9E+09,9E+09,9E+09,9E+09]]";
+}
+
+template <>
+std::string getSample<JointTarget>()
+{
+  return "[[0,0,0,0,30,0],[9E+09,9E+09,9E+09,9E+09,9E+09,9E+09]]";
+}
+
+template <>
+std::string getSample<ToolData>()
+{
+  return "[TRUE,[[0,0,100],[1,0,0,0]],[1,[0,0,1],[1,0,0,0],0,0,0]]";
+}
+
+template <>
+std::string getSample<WObjData>()
+{
+  return "[FALSE,TRUE,\"\",[[0,0,0],[1,0,0,0]],[[0,0,0],[1,0,0,0]]]";
+}
+
+template <>
+std::string getSample<LoadData>()
+{
+  return "[1,[0,0,1],[1,0,0,0],0,0,0]";
+}
+
+template <>
+std::string getSample<SpeedData>()
+{
+  return "[1000,30,1000,1000]";
+}
+
+template <>
+std::string getSample<RAPIDTypedRecord<rapid::RobTarget>>()
+{
+  return getSample<RobTarget>();
+}
+
+template <>
+std::string getSample<RAPIDTypedRecord<rapid::JointTarget>>()
+{
+  return getSample<JointTarget>();
+}
+
+template <>
+std::string getSample<RAPIDTypedRecord<rapid::ToolData>>()
+{
+  return getSample<ToolData>();
+}
+
+/**
+ * \brief A function for reporting the heap allocations per operation of a benchmark.
+ *
+ * \param state for the benchmark's state.
+ * \param allocations for the total number of allocations made by the measured operations.
+ */
+static void reportAllocations(benchmark::State& state, const size_t allocations)
+{
+  state.counters["allocs_per_op"] = benchmark::Counter(double(allocations),
+                                                       benchmark::Counter::kAvgIterations);
+}
+
+/***********************************************************************************************************************
+ * Benchmarks
+ */
+
+template <typename T>
+static void BM_Parse(benchmark::State& state)
+{
+  const std::string sample = getSample<T>();
+  T record;
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    record.parseString(sample);
+    benchmark::DoNotOptimize(record);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+}
+
+template <typename T>
+static void BM_Construct(benchmark::State& state)
+{
+  T record;
+  record.parseString(getSample<T>());
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    std::string value = record.constructString();
+    benchmark::DoNotOptimize(value);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+}
+
+template <typename T>
+static void BM_RoundTrip(benchmark::State& state)
+{
+  std::string value = getSample<T>();
+  T record;
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    record.parseString(value);
+    value = record.constructString();
+    benchmark::DoNotOptimize(value);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+}
+
+#define RWS_RAPID_BENCHMARKS(T) \
+  BENCHMARK_TEMPLATE(BM_Parse, T); \
+  BENCHMARK_TEMPLATE(BM_Construct, T); \
+  BENCHMARK_TEMPLATE(BM_RoundTrip, T)
+
+RWS_RAPID_BENCHMARKS(RobTarget);
+RWS_RAPID_BENCHMARKS(JointTarget);
+RWS_RAPID_BENCHMARKS(ToolData);
+RWS_RAPID_BENCHMARKS(WObjData);
+RWS_RAPID_BENCHMARKS(LoadData);
+RWS_RAPID_BENCHMARKS(SpeedData);
+RWS_RAPID_BENCHMARKS(RWSStateMachineInterface::EGMSettings);
+RWS_RAPID_BENCHMARKS(RWSStateMachineInterface::SGSettings);
+RWS_RAPID_BENCHMARKS(RAPIDTypedRecord<rapid::RobTarget>);
+RWS_RAPID_BENCHMARKS(RAPIDTypedRecord<rapid::JointTarget>);
+RWS_RAPID_BENCHMARKS(RAPIDTypedRecord<rapid::ToolData>);
+
+static void BM_ExtractDelimitedSubstrings(benchmark::State& state)
+{
+  const std::string sample = getSample<RobTarget>();
+  RecordProbe probe;
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    std::vector<std::string> substrings = probe.extractDelimitedSubstrings(sample);
+    benchmark::DoNotOptimize(substrings);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+}
+BENCHMARK(BM_ExtractDelimitedSubstrings);
+
+static void BM_CountCharInString(benchmark::State& state)
+{
+  const std::string sample = getSample<RobTarget>();
+  RecordProbe probe;
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    unsigned int count = probe.countCharInString(sample, '[');
+    benchmark::DoNotOptimize(count);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+}
+BENCHMARK(BM_CountCharInString);
+
+static void BM_ParseNum(benchmark::State& state)
+{
+  RAPIDNum value;
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    value.parseString("0.866025");
+    benchmark::DoNotOptimize(value);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+}
+BENCHMARK(BM_ParseNum);
+
+static void BM_ConstructNum(benchmark::State& state)
+{
+  RAPIDNum value(0.866025f);
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    std::string result = value.constructString();
+    benchmark::DoNotOptimize(result);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+}
+BENCHMARK(BM_ConstructNum);
+
+/**
+ * \brief Creates the value string of a num array, e.g. a buffer of weld seam points.
+ *
+ * \param size for the number of elements.
+ *
+ * \return std::string containing the value string.
+ */
+static std::string getNumArraySample(const size_t size)
+{
+  RAPIDArray<float> array(size);
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    array.set(i, 0.001f * float(i * 7919 % 1000003) - 500.0f);
+  }
+
+  return array.constructString();
+}
+
+static void reportThroughput(benchmark::State& state, const std::string& sample)
+{
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(sample.size()));
+  state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template <typename T>
+static void BM_ParseNumArray(benchmark::State& state)
+{
+  const std::string sample = getNumArraySample(state.range(0));
+  RAPIDArray<T> array(0, "num");
+  array.parseString(sample);
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    array.parseString(sample);
+    benchmark::DoNotOptimize(array);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+  reportThroughput(state, sample);
+}
+BENCHMARK_TEMPLATE(BM_ParseNumArray, float)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_ParseNumArray, double)->Arg(10000);
+
+static void BM_ParseNumArrayKernel(benchmark::State& state, const RAPIDParser::DelimiterKernel kernel)
+{
+  if (!RAPIDParser::setDelimiterKernel(kernel))
+  {
+    state.SkipWithError("the kernel isn't supported by the build or the CPU");
+    return;
+  }
+
+  const std::string sample = getNumArraySample(state.range(0));
+  RAPIDArray<float> array(0, "num");
+
+  for (auto _ : state)
+  {
+    array.parseString(sample);
+    benchmark::DoNotOptimize(array);
+  }
+
+  RAPIDParser::setDelimiterKernel(RAPIDParser::AUTOMATIC);
+  reportThroughput(state, sample);
+}
+BENCHMARK_CAPTURE(BM_ParseNumArrayKernel, scalar, RAPIDParser::SCALAR)->Arg(10000);
+BENCHMARK_CAPTURE(BM_ParseNumArrayKernel, sse2, RAPIDParser::SSE2)->Arg(10000);
+BENCHMARK_CAPTURE(BM_ParseNumArrayKernel, avx2, RAPIDParser::AVX2)->Arg(10000);
+
+static void BM_ParseNumArrayPerElement(benchmark::State& state)
+{
+  const std::string sample = getNumArraySample(state.range(0));
+  std::vector<float> values;
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    RAPIDParser parser(sample);
+    values.clear();
+
+    if (parser.expect('['))
+    {
+      do
+      {
+        float value = 0;
+        parseRAPIDValue(parser, value);
+        values.push_back(value);
+      }
+      while (!parser.hasFailed() && parser.accept(','));
+    }
+
+    benchmark::DoNotOptimize(values);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+  reportThroughput(state, sample);
+}
+BENCHMARK(BM_ParseNumArrayPerElement)->Arg(10000);
+
+static void BM_ParseNumArraySubstrings(benchmark::State& state)
+{
+  const std::string sample = getNumArraySample(state.range(0));
+  RecordProbe probe;
+  std::vector<RAPIDNum> values(state.range(0));
+  size_t allocations_before = getAllocationCount();
+
+  for (auto _ : state)
+  {
+    std::vector<std::string> substrings = probe.extractDelimitedSubstrings(sample);
+
+    for (size_t i = 0; i < substrings.size() && i < values.size(); ++i)
+    {
+      values[i].parseString(substrings[i]);
+    }
+
+    benchmark::DoNotOptimize(values);
+  }
+
+  reportAllocations(state, getAllocationCount() - allocations_before);
+  reportThroughput(state, sample);
+}
+BENCHMARK(BM_ParseNumArraySubstrings)->Arg(10000);
+
+} // end namespace rws
+} // end namespace abb
+
+BENCHMARK_MAIN();
@@ -46,7 +46,9 @@
 #ifndef RWS_CLIENT_H
 #define RWS_CLIENT_H
 
-#include <deque>
+#include <chrono>
+#include <map>
+#include <memory>
 #include <sstream>
 #include <vector>
 #include <iostream>
@@ -54,8 +56,13 @@
 #include "Poco/DOM/DOMParser.h"
 
 #include "rws_common.h"
+#include "rws_endpoint_statistics.h"
+#include "rws_endpoints.h"
+#include "rws_flight_recorder.h"
 #include "rws_rapid.h"
+#include "rws_rapid_value.h"
 #include "rws_poco_client.h"
+#include "rws_request_log.h"
 
 namespace abb
 {
@@ -68,6 +75,12 @@ namespace rws
  *
  * See http://developercenter.robotstudio.com/webservice/api_reference for details about RWS.
  *
+ * Thread safety: The methods may be called concurrently from several threads. Each call builds its request, evaluation
+ * conditions and XML parser locally, the shared state (log, caches and subscription group id) is protected by mutexes,
+ * and each response cache hit parses its own XML document (i.e. the callers never share a document). Note that the
+ * requests are still serialized on the client's single HTTP session, so use several clients (e.g. a RWSClientPool) if
+ * the requests should run in parallel. See tests/rws_client_stress_test.cpp.
+ *
  * TODO:
  * - Flesh out the subscription functionality. E.g. implement a "subscription manager".
  *
@@ -95,10 +108,15 @@ public:
      */
     std::string error_message;
 
+    /**
+     * \brief The HTTP status of the response (zero if no response was received).
+     */
+    int http_status;
+
     /**
      * \brief A default constructor.
      */
-    RWSResult() : success(false) {}
+    RWSResult() : success(false), http_status(0) {}
   };
 
   /**
@@ -112,7 +130,7 @@ public:
      * \param module specifying the name of the RAPID module containing the symbol.
      * \param name specifying the name of the RAPID symbol.
      */
-    RAPIDSymbolResource(const std::string module, const std::string name)
+    RAPIDSymbolResource(const std::string& module, const std::string& name)
     :
     module(module),
     name(name)
@@ -141,7 +159,7 @@ public:
      * \param module specifying the name of the RAPID module containing the symbol.
      * \param name specifying the name of the RAPID symbol.
      */
-    RAPIDResource(const std::string task, const std::string module, const std::string name)
+    RAPIDResource(const std::string& task, const std::string& module, const std::string& name)
     :
     task(task),
     module(module),
@@ -154,7 +172,7 @@ public:
      * \param task specifying the name of the RAPID task containing the symbol.
      * \param symbol specifying the names of the RAPID module and the the symbol.
      */
-    RAPIDResource(const std::string task, const RAPIDSymbolResource symbol)
+    RAPIDResource(const std::string& task, const RAPIDSymbolResource& symbol)
     :
     task(task),
     module(symbol.module),
@@ -175,6 +193,85 @@ public:
      * \brief The RAPID symbol name.
      */
     std::string name;
+
+    /**
+     * \brief Operator for ordering resources (e.g. when used as keys in a map).
+     *
+     * \param other for the resource to compare with.
+     *
+     * \return bool indicating if this resource is ordered before the other resource.
+     */
+    bool operator<(const RAPIDResource& other) const
+    {
+      if (task != other.task)
+      {
+        return task < other.task;
+      }
+
+      if (module != other.module)
+      {
+        return module < other.module;
+      }
+
+      return name < other.name;
+    }
+  };
+
+  /**
+   * \brief A struct for containing the metadata (i.e. properties) of a RAPID symbol.
+   */
+  struct RAPIDSymbolMetadata
+  {
+    /**
+     * \brief A default constructor.
+     */
+    RAPIDSymbolMetadata() : number_of_dimensions(0) {}
+
+    /**
+     * \brief The RAPID data type (e.g. "num" or "robtarget").
+     */
+    std::string data_type;
+
+    /**
+     * \brief The RAPID symbol type, i.e. the storage class (e.g. "per" for persistent data).
+     */
+    std::string symbol_type;
+
+    /**
+     * \brief The number of array dimensions (zero if the symbol is not an array).
+     */
+    unsigned int number_of_dimensions;
+
+    /**
+     * \brief The array dimensions, as reported by the robot controller (e.g. "3 2").
+     */
+    std::string dimensions;
+
+    /**
+     * \brief The URL of the RAPID data type (e.g. "RAPID/robtarget" or "RAPID/T_ROB1/MyModule/myrecord").
+     */
+    std::string type_url;
+  };
+
+  /**
+   * \brief A struct for containing statistics about the response cache.
+   */
+  struct ResponseCacheStatistics
+  {
+    /**
+     * \brief A default constructor.
+     */
+    ResponseCacheStatistics() : hits(0), misses(0) {}
+
+    /**
+     * \brief The number of requests answered from the cache.
+     */
+    Poco::UInt64 hits;
+
+    /**
+     * \brief The number of cacheable requests that were sent to the robot controller.
+     */
+    Poco::UInt64 misses;
   };
   
   /**
@@ -188,8 +285,8 @@ public:
      * \param filename specifying the name of the file.
      * \param directory specifying the directory of the file on the robot controller (set to $home by default).
      */
-    FileResource(const std::string filename,
-                 const std::string directory = SystemConstants::RWS::Identifiers::HOME_DIRECTORY)
+    FileResource(const std::string& filename,
+                 const std::string& directory = SystemConstants::RWS::Identifiers::HOME_DIRECTORY)
     :
     filename(filename),
     directory(directory)
@@ -243,7 +340,7 @@ public:
        * \param resource_uri for the URI of the resource.
        * \param priority for the priority of the subscription.
        */
-      SubscriptionResource(const std::string resource_uri, const Priority priority)
+      SubscriptionResource(const std::string& resource_uri, const Priority priority)
       :
       resource_uri(resource_uri),
       priority(priority)
@@ -256,7 +353,7 @@ public:
      * \param resource_uri for the URI of the resource.
      * \param priority for the priority of the subscription.
      */
-    void add(const std::string resource_uri, const Priority priority);
+    void add(const std::string& resource_uri, const Priority priority);
   
     /**
      * \brief A method to add information about a IO signal subscription resource.
@@ -264,7 +361,7 @@ public:
      * \param iosignal for the IO signal's name.
      * \param priority for the priority of the subscription.
      */
-    void addIOSignal(const std::string iosignal, const Priority priority);
+    void addIOSignal(const std::string& iosignal, const Priority priority);
   
     /**
      * \brief A method to add information about a RAPID persistant symbol subscription resource.
@@ -272,14 +369,14 @@ public:
      * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
      * \param priority for the priority of the subscription.
      */
-    void addRAPIDPersistantVariable(const RAPIDResource resource, const Priority priority);
+    void addRAPIDPersistantVariable(const RAPIDResource& resource, const Priority priority);
   
     /**
      * \brief A method for retrieving the contained subscription resources information.
      *
      * \return std::vector<SubscriptionResource> containing information of the subscription resources.
      */
-    std::vector<SubscriptionResource> getResources() { return resources_; }
+    const std::vector<SubscriptionResource>& getResources() const { return resources_; }
 
   private:
     /**
@@ -293,15 +390,18 @@ public:
    *
    * \param ip_address specifying the robot controller's IP address.
    */
-  RWSClient(const std::string ip_address, const Poco::Net::Context::Ptr ptrContext)
+  RWSClient(const std::string& ip_address, const Poco::Net::Context::Ptr ptrContext)
   :
   POCOClient(ip_address,
              SystemConstants::General::DEFAULT_PORT_NUMBER,
              SystemConstants::General::DEFAULT_USERNAME,
              SystemConstants::General::DEFAULT_PASSWORD,
              ptrContext
-             )
-  {}
+             ),
+  log_(LOG_SIZE, DEFAULT_LOG_CAPTURE_LIMIT)
+  {
+    setDefaultResponseCacheTTLs();
+  }
   
   /**
    * \brief A constructor.
@@ -310,15 +410,18 @@ public:
    * \param username for the username to the RWS authentication process.
    * \param password for the password to the RWS authentication process.
    */
-  RWSClient(const std::string ip_address, const std::string username, const std::string password, const Poco::Net::Context::Ptr ptrContext)
+  RWSClient(const std::string& ip_address, const std::string& username, const std::string& password, const Poco::Net::Context::Ptr ptrContext)
   :
   POCOClient(ip_address,
              SystemConstants::General::DEFAULT_PORT_NUMBER,
              username,
              password,
              ptrContext
-             )
-  {}
+             ),
+  log_(LOG_SIZE, DEFAULT_LOG_CAPTURE_LIMIT)
+  {
+    setDefaultResponseCacheTTLs();
+  }
 
   /**
    * \brief A constructor.
@@ -326,14 +429,17 @@ public:
    * \param ip_address specifying the robot controller's IP address.
    * \param port for the port used by the RWS server.
    */
-  RWSClient(const std::string ip_address, const unsigned short port, const Poco::Net::Context::Ptr ptrContext)
+  RWSClient(const std::string& ip_address, const unsigned short port, const Poco::Net::Context::Ptr ptrContext)
   :
   POCOClient(ip_address,
              port,
              SystemConstants::General::DEFAULT_USERNAME,
              SystemConstants::General::DEFAULT_PASSWORD,
-             ptrContext)
-  {}
+             ptrContext),
+  log_(LOG_SIZE, DEFAULT_LOG_CAPTURE_LIMIT)
+  {
+    setDefaultResponseCacheTTLs();
+  }
 
   /**
    * \brief A constructor.
@@ -343,18 +449,21 @@ public:
    * \param username for the username to the RWS authentication process.
    * \param password for the password to the RWS authentication process.
    */
-  RWSClient(const std::string ip_address,
+  RWSClient(const std::string& ip_address,
             const unsigned short port,
-            const std::string username,
-            const std::string password,
+            const std::string& username,
+            const std::string& password,
             const Poco::Net::Context::Ptr ptrContext)
   :
   POCOClient(ip_address,
              port,
              username,
              password,
-             ptrContext)
-  {}
+             ptrContext),
+  log_(LOG_SIZE, DEFAULT_LOG_CAPTURE_LIMIT)
+  {
+    setDefaultResponseCacheTTLs();
+  }
 
   /**
    * \brief A destructor.
@@ -372,7 +481,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult getConfigurationInstances(const std::string topic, const std::string type);
+  RWSResult getConfigurationInstances(const std::string& topic, const std::string& type);
 
   /**
    * \brief A method for retrieving the value of an IO signal.
@@ -381,7 +490,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult getIOSignal(const std::string iosignal);
+  RWSResult getIOSignal(const std::string& iosignal);
   
   /**
    * \brief A method for retrieving the current jointtarget values of a mechanical unit.
@@ -390,7 +499,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult getMechanicalUnitJointTarget(const std::string mechunit);
+  RWSResult getMechanicalUnitJointTarget(const std::string& mechunit);
   
   /**
    * \brief A method for retrieving the current robtarget values of a mechanical unit.
@@ -399,7 +508,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult getMechanicalUnitRobTarget(const std::string mechunit);
+  RWSResult getMechanicalUnitRobTarget(const std::string& mechunit);
 
   /**
    * \brief A method for retrieving the data of a RAPID symbol.
@@ -408,17 +517,21 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult getRAPIDSymbolData(const RAPIDResource resource);
+  RWSResult getRAPIDSymbolData(const RAPIDResource& resource);
 
   /**
    * \brief A method for retrieving the data of a RAPID symbol (parsed into a struct representing the RAPID data).
    *
+   * Note: The symbol's cached metadata is checked against the data. A type mismatch or a parse failure (e.g. after a
+   *       module load redeclared the symbol) is retried once with fresh metadata.
+   *
    * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
-   * \param p_data for containing the retrieved data.
+   * \param p_data for containing the retrieved data (left unchanged if the retrieval or the parsing fails).
    *
-   * \return RWSResult containing the result.
+   * \return RWSResult containing the result. Note: Fails (with the error position) if the value string couldn't be
+   *         parsed.
    */
-  RWSResult getRAPIDSymbolData(const RAPIDResource resource, RAPIDSymbolDataAbstract* p_data);
+  RWSResult getRAPIDSymbolData(const RAPIDResource& resource, RAPIDSymbolDataAbstract* p_data);
 
   /**
    * \brief A method for retrieving the properties of a RAPID symbol.
@@ -427,7 +540,91 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult getRAPIDSymbolProperties(const RAPIDResource resource);
+  RWSResult getRAPIDSymbolProperties(const RAPIDResource& resource);
+
+  /**
+   * \brief A method for retrieving the data of a RAPID symbol, parsed into a dynamic RAPID value.
+   *
+   * The value is replaced by one with the symbol's type descriptor, which is retrieved from the robot controller and
+   * cached. A parse failure (e.g. after a module load redeclared the symbol with other dimensions) is retried once with
+   * fresh metadata and type descriptors.
+   *
+   * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
+   * \param p_value for storing the retrieved RAPID value (left unchanged if the retrieval or the parsing fails).
+   *
+   * \return RWSResult containing the result. Note: Fails if the value string couldn't be parsed.
+   */
+  RWSResult getRAPIDSymbolData(const RAPIDResource& resource, RAPIDValue* p_value);
+
+  /**
+   * \brief A method for retrieving the descriptor of a RAPID data type, e.g. of a user-defined record.
+   *
+   * Note: The descriptors are cached per type URL, so only the first call for a type makes requests to the robot
+   * controller (one for the type's properties, and one for the components of each not yet cached record type).
+   *
+   * \param type_url specifying the type's URL (e.g. "RAPID/robtarget" or "RAPID/T_ROB1/MyModule/myrecord").
+   * \param p_descriptor for storing the retrieved descriptor.
+   *
+   * \return RWSResult containing the result.
+   */
+  RWSResult getRAPIDTypeDescriptor(const std::string& type_url,
+                                   std::shared_ptr<const RAPIDTypeDescriptor>* p_descriptor);
+
+  /**
+   * \brief A method for constructing the name, which addresses a component of a RAPID symbol (e.g. "name{2}.trans").
+   *
+   * The path is e.g. that of a RAPIDSnapshot::Change, i.e. {1, 0, 0, 0} addresses "name{2,1}.trans.x" of a
+   * two-dimensional pose array.
+   *
+   * \param symbol_name specifying the symbol's name.
+   * \param metadata specifying the symbol's metadata.
+   * \param descriptor specifying the descriptor of the symbol's data type.
+   * \param path specifying the component's (zero-based) indices, from the symbol's top level.
+   * \param p_name for storing the name.
+   *
+   * \return bool indicating if the component can be addressed (e.g. not if only a part of a multidimensional index is
+   *         given, since such a row can't be addressed on its own).
+   */
+  static bool getRAPIDComponentName(const std::string& symbol_name,
+                                    const RAPIDSymbolMetadata& metadata,
+                                    const RAPIDTypeDescriptor& descriptor,
+                                    const std::vector<size_t>& path,
+                                    std::string* p_name);
+
+  /**
+   * \brief A method for retrieving the metadata of a RAPID symbol.
+   *
+   * Note: The metadata is cached, so only the first call for a symbol makes a request to the robot controller.
+   *
+   * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
+   * \param p_metadata for containing the retrieved metadata.
+   *
+   * \return RWSResult containing the result. The XML document is only set if a request was made.
+   */
+  RWSResult getRAPIDSymbolMetadata(const RAPIDResource& resource, RAPIDSymbolMetadata* p_metadata);
+
+  /**
+   * \brief A method for preloading the metadata cache, e.g. for symbols that are read periodically.
+   *
+   * \param resources specifying the RAPID resources.
+   *
+   * \return bool indicating if the metadata of all the symbols were retrieved.
+   */
+  bool preloadRAPIDSymbolMetadata(const std::vector<RAPIDResource>& resources);
+
+  /**
+   * \brief A method for invalidating all cached RAPID symbol metadata (and RAPID type descriptors).
+   *
+   * Note: This should be called if RAPID modules have been loaded or unloaded.
+   */
+  void invalidateRAPIDSymbolMetadata();
+
+  /**
+   * \brief A method for invalidating the cached metadata of a RAPID symbol.
+   *
+   * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
+   */
+  void invalidateRAPIDSymbolMetadata(const RAPIDResource& resource);
 
   /**
    * \brief A method for retrieving the execution state of RAPID.
@@ -443,7 +640,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult getRAPIDModulesInfo(const std::string task);
+  RWSResult getRAPIDModulesInfo(const std::string& task);
 
   /**
    * \brief A method for retrieving the RAPID tasks that are defined in the robot controller system.
@@ -481,7 +678,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult setIOSignal(const std::string iosignal, const std::string value);
+  RWSResult setIOSignal(const std::string& iosignal, const std::string& value);
 
   /**
    * \brief A method for setting the data of a RAPID symbol.
@@ -491,7 +688,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult setRAPIDSymbolData(const RAPIDResource resource, const std::string data);
+  RWSResult setRAPIDSymbolData(const RAPIDResource& resource, const std::string& data);
    
   /**
    * \brief A method for setting the data of a RAPID symbol (based on the provided struct representing the RAPID data).
@@ -501,7 +698,28 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult setRAPIDSymbolData(const RAPIDResource resource, RAPIDSymbolDataAbstract& data);
+  RWSResult setRAPIDSymbolData(const RAPIDResource& resource, RAPIDSymbolDataAbstract& data);
+
+  /**
+   * \brief A method for writing only the changes of a RAPID symbol's data, compared to a snapshot of its last read or
+   *        written value.
+   *
+   * Nothing is written if nothing has changed. Up to max_component_writes changed components are written one by one,
+   * addressed as record components and/or array elements (e.g. "name{2}.trans"), with the component names taken from
+   * the symbol's type descriptor. Otherwise, or if a component can't be addressed or written, the complete value is
+   * written. The snapshot is updated after a successful write.
+   *
+   * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
+   * \param data for the RAPID symbol's new data.
+   * \param p_snapshot for the snapshot to compare with (a complete value is written if null or empty).
+   * \param max_component_writes for the maximum number of changed components to write one by one.
+   *
+   * \return RWSResult containing the result (of the last write).
+   */
+  RWSResult setRAPIDSymbolData(const RAPIDResource& resource,
+                               RAPIDSymbolDataAbstract& data,
+                               RAPIDSnapshot* p_snapshot,
+                               const size_t max_component_writes = 8);
   
   /**
    * \brief A method for starting RAPID execution in the robot controller.
@@ -543,14 +761,14 @@ public:
    * 
    * \return RWSResult containing the result.
    */
-  RWSResult setLeadThroughOn(const std::string mechUnit);
+  RWSResult setLeadThroughOn(const std::string& mechUnit);
 
   /**
    * \brief A method for turning off the compliance lead through.
    * 
    * \return RWSResult containing the result.
    */
-  RWSResult setLeadThroughOff(const std::string mechUnit);
+  RWSResult setLeadThroughOff(const std::string& mechUnit);
 
   /**
    * \brief A method for retrieving a file from the robot controller.
@@ -562,7 +780,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult getFile(const FileResource resource, std::string* p_file_content);
+  RWSResult getFile(const FileResource& resource, std::string* p_file_content);
 
   /**
    * \brief A method for uploading a file to the robot controller.
@@ -572,7 +790,17 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult uploadFile(const FileResource resource, const std::string file_content);
+  RWSResult uploadFile(const FileResource& resource, const std::string& file_content);
+
+  /**
+   * \brief A method for uploading a file to the robot controller, without copying the file's content.
+   *
+   * \param resource specifying the file's directory and name.
+   * \param file_content for the file's content (moved into the request).
+   *
+   * \return RWSResult containing the result.
+   */
+  RWSResult uploadFile(const FileResource& resource, std::string&& file_content);
 
   /**
    * \brief A method for deleting a file from the robot controller.
@@ -581,7 +809,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult deleteFile(const FileResource resource);
+  RWSResult deleteFile(const FileResource& resource);
 
   /**
    * \brief A method for starting for a subscription.
@@ -590,7 +818,7 @@ public:
    *
    * \return RWSResult containing the result.
    */
-  RWSResult startSubscription(const SubscriptionResources resources);
+  RWSResult startSubscription(const SubscriptionResources& resources);
       
   /**
    * \brief A method for waiting for a subscription event.
@@ -677,155 +905,287 @@ public:
    */
   std::string getLogTextLatestEvent(const bool verbose = false);
 
-private:
   /**
-   * \brief A struct for representing conditions, for the evaluation of an attempted RWS communication.
+   * \brief Method for retrieving the internal log's records (e.g. for statistics).
+   *
+   * \return std::vector<RWSRequestLog::Record> containing the records, the most recent first.
    */
-  struct EvaluationConditions
-  {
-    /**
-     * \brief A default constructor.
-     */
-    EvaluationConditions() : parse_message_into_xml(false) {};
-    
-    /**
-     * \brief A method for reseting the conditions.
-     */
-    void reset()
-    {
-      parse_message_into_xml = false;
-      accepted_outcomes.clear();
-    }
-    
-    /**
-     * \brief Indication for if the received message should be parsed into a xml document.
-     */
-    bool parse_message_into_xml;
-    
-    /**
-     * \brief Vector containing the accepted HTTP outcomes.
-     */
-    std::vector<Poco::Net::HTTPResponse::HTTPStatus> accepted_outcomes;
-  };
-  
+  std::vector<RWSRequestLog::Record> getLogRecords() { return log_.getRecords(); }
+
   /**
-   * \brief Method for checking a communication result against the accepted outcomes.
+   * \brief Method for setting how many bytes of each response's content are kept in the internal log.
    *
-   * \param result containing the result of the check.
-   * \param poco_result containing the POCO result.
-   * \param conditions containing the conditions for the evaluation.
+   * \note This clears the log.
+   *
+   * \param capture_limit for the number of bytes (zero disables the capture).
    */
-  void checkAcceptedOutcomes(RWSResult* result, const POCOResult& poco_result, const EvaluationConditions& conditions);
-  
+  void setLogCaptureLimit(const size_t capture_limit) { log_.setCaptureLimit(capture_limit); }
+
   /**
-   * \brief Method for evaluating the result from a POCO communication.
+   * \brief Method for enabling the flight recorder, i.e. recording of all communication into a memory-mapped file.
    *
-   * \param poco_result for the POCO result to evaluate.
-   * \param conditions specifying the conditions for the evaluation.
+   * \param path for the recording file's path (an existing recording with the same capacity is appended to).
+   * \param capacity for the number of records kept in the file.
    *
-   * \return RWSResult containing the evaluated result.
+   * \return bool indicating if the recording file could be opened or not.
+   */
+  bool enableFlightRecorder(const std::string& path, const size_t capacity = DEFAULT_FLIGHT_RECORDER_CAPACITY);
+
+  /**
+   * \brief Method for disabling the flight recorder.
+   */
+  void disableFlightRecorder();
+
+  /**
+   * \brief Method for retrieving the per-endpoint request statistics (latency histograms and phase timings).
+   *
+   * Note: Responses answered from the response cache are not included.
+   *
+   * \return std::vector<RWSEndpointStatistics::Snapshot> containing a snapshot for each requested endpoint.
+   */
+  std::vector<RWSEndpointStatistics::Snapshot> getEndpointStatistics() const
+  {
+    return endpoint_statistics_.getSnapshots();
+  }
+
+  /**
+   * \brief Method for resetting the per-endpoint request statistics.
    */
-  RWSResult evaluatePOCOResult(const POCOResult& poco_result, const EvaluationConditions& conditions);
+  void resetEndpointStatistics() { endpoint_statistics_.reset(); }
 
   /**
-   * \brief Method for generating a configuration URI path.
+   * \brief A method for setting the time-to-live of cached responses, for resources below a path.
    *
-   * \param topic for the configuration topic.
-   * \param type for the configuration type (belonging to the topic).
+   * Only responses of (mostly) static resources are cached, i.e. the RobotWare system, the configuration instances,
+   * and the RAPID tasks and modules. The longest matching path decides the time-to-live.
    *
-   * \return std::string containing the path.
+   * \param resource for the resource path (e.g. "/rw/system").
+   * \param ttl for the time-to-live [microseconds]. Zero disables caching for the resources.
    */
-  std::string generateConfigurationPath(const std::string& topic, const std::string& type);
+  void setResponseCacheTTL(const std::string& resource, const Poco::Int64 ttl);
 
   /**
-   * \brief Method for generating an IO signal URI path.
+   * \brief A method for invalidating all cached responses, e.g. after a restart of the robot controller.
+   */
+  void invalidateResponseCache();
+
+  /**
+   * \brief A method for invalidating the cached responses of resources below a path.
    *
-   * \param iosignal for the signal's name.
+   * \param resource for the resource path (e.g. "/rw/rapid/tasks").
+   */
+  void invalidateResponseCache(const std::string& resource);
+
+  /**
+   * \brief A method for retrieving statistics about the response cache.
    *
-   * \return std::string containing the path.
+   * \return ResponseCacheStatistics containing the statistics.
+   */
+  ResponseCacheStatistics getResponseCacheStatistics();
+
+  /**
+   * \brief Static constant for the default time-to-live of cached RobotWare system and configuration responses
+   *        [microseconds].
+   */
+  static const Poco::Int64 DEFAULT_SYSTEM_CACHE_TTL = 60e6;
+
+  /**
+   * \brief Static constant for the default time-to-live of cached RAPID task and module responses [microseconds].
    */
-  std::string generateIOSignalPath(const std::string& iosignal);
+  static const Poco::Int64 DEFAULT_RAPID_CACHE_TTL = 5e6;
+
+  /**
+   * \brief Static constant for the default number of records kept by the flight recorder.
+   */
+  static const size_t DEFAULT_FLIGHT_RECORDER_CAPACITY = 4096;
+
+private:
+  /**
+   * \brief Method for checking a communication result against the endpoint's accepted outcomes.
+   *
+   * \param result containing the result of the check.
+   * \param poco_result containing the POCO result.
+   * \param endpoint describing the endpoint (e.g. the accepted HTTP statuses).
+   */
+  void checkAcceptedOutcomes(RWSResult* result, const POCOResult& poco_result, const EndpointDescriptor& endpoint);
   
   /**
-   * \brief Method for generating a mechanical unit resource URI path.
+   * \brief Method for evaluating the result from a POCO communication.
    *
-   * \param mechunit for the mechanical unit's name.
+   * \param poco_result for the POCO result to evaluate.
+   * \param endpoint describing the endpoint (e.g. the accepted HTTP statuses and the parse mode).
    *
-   * \return std::string containing the path.
+   * \return RWSResult containing the evaluated result.
    */
-  std::string generateMechanicalUnitPath(const std::string& mechunit);
+  RWSResult evaluatePOCOResult(const POCOResult& poco_result, const EndpointDescriptor& endpoint);
 
   /**
-   * \brief Method for generating a RAPID data resource URI path.
+   * \brief Method for executing a RWS operation, as described by an endpoint descriptor.
    *
-   * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
+   * The response may be answered from the response cache (if the endpoint is cacheable), and the request may be
+   * retried (according to the endpoint's retry class).
+   *
+   * \param endpoint describing the endpoint.
+   * \param arguments for the arguments of the endpoint's path template.
+   * \param content for the request content (moved into the request).
    *
-   * \return std::string containing the path.
+   * \return RWSResult containing the evaluated (or cached) result.
    */
-  std::string generateRAPIDDataPath(const RAPIDResource& resource);
-  
+  RWSResult execute(const EndpointDescriptor& endpoint,
+                    std::initializer_list<std::string_view> arguments = {},
+                    std::string content = std::string());
+
   /**
-   * \brief Method for generating a RAPID properties resource URI path.
+   * \brief Method for sending a HTTP request for an endpoint, with retries according to the endpoint's retry class.
    *
-   * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
+   * \param endpoint describing the endpoint.
+   * \param uri for the URI (path and query).
+   * \param content for the request content (moved into the request, and recovered from the result between retries).
    *
-   * \return std::string containing the path.
+   * \return POCOResult containing the result.
    */
-  std::string generateRAPIDPropertiesPath(const RAPIDResource& resource);
+  POCOResult sendRequest(const EndpointDescriptor& endpoint,
+                         const std::string& uri,
+                         std::string content = std::string());
 
   /**
-   * \brief Method for generating a file resource URI path.
+   * \brief Method for looking up the response cache time-to-live of a URI.
    *
-   * \param resource specifying the file's directory and name.
+   * \param uri for the URI (path and query).
    *
-   * \return std::string containing the path.
+   * \return Poco::Int64 containing the time-to-live [microseconds]. Zero if the response should not be cached.
    */
-  std::string generateFilePath(const FileResource& resource);
-  
+  Poco::Int64 lookupResponseCacheTTL(const std::string& uri);
+
+  /**
+   * \brief Method for setting the default response cache time-to-lives.
+   */
+  void setDefaultResponseCacheTTLs();
+
   /**
    * \brief Static constant for the log's size.
    */
   static const size_t LOG_SIZE = 20;
 
+  /**
+   * \brief Static constant for the default number of response content bytes kept per logged request.
+   */
+  static const size_t DEFAULT_LOG_CAPTURE_LIMIT = 1024;
+
+  /**
+   * \brief Static constant for the number of retries of requests that failed due to communication errors.
+   */
+  static const int MAX_TRANSPORT_RETRIES = 1;
+
   /**
    * \brief Static constant for the default RWS subscription timeout [microseconds].
    */
   static const Poco::Int64 DEFAULT_SUBSCRIPTION_TIMEOUT = 40e6;
 
   /**
-   * \brief Container for logging communication results.
+   * \brief A method for resolving the descriptor of a RAPID data type (and of its components).
+   *
+   * \param type_url specifying the type's URL.
+   * \param depth specifying the current nesting depth (to stop on cyclic type definitions).
+   * \param p_descriptor for storing the resolved descriptor.
+   *
+   * \return RWSResult containing the result.
    */
-  std::deque<POCOResult> log_;
+  RWSResult resolveRAPIDTypeDescriptor(const std::string& type_url,
+                                       const int depth,
+                                       std::shared_ptr<const RAPIDTypeDescriptor>* p_descriptor);
 
   /**
-   * \brief Container for building the request URIs.
+   * \brief Static constant for the maximum nesting depth of RAPID data types.
    */
-  std::string uri_;
+  static const int MAX_RAPID_TYPE_DEPTH = 32;
 
   /**
-   * \brief Container for building the request content.
+   * \brief A mutex for protecting the RAPID symbol metadata cache.
    */
-  std::string content_;
-  
+  Poco::Mutex symbol_metadata_mutex_;
+
   /**
-   * \brief A subscription group id.
+   * \brief Cache of RAPID symbol metadata, to avoid a properties request for each typed RAPID read.
    */
-  std::string subscription_group_id_;
-  
+  std::map<RAPIDResource, RAPIDSymbolMetadata> symbol_metadata_;
+
+  /**
+   * \brief A mutex for protecting the RAPID type descriptor cache.
+   */
+  Poco::Mutex type_descriptors_mutex_;
+
+  /**
+   * \brief Cache of RAPID type descriptors, by type URL.
+   */
+  std::map<std::string, std::shared_ptr<const RAPIDTypeDescriptor>> type_descriptors_;
+
+  /**
+   * \brief A struct for representing a cached response.
+   */
+  struct CachedResponse
+  {
+    /**
+     * \brief The response's content (parsed again on each hit, since a XML document must not be shared between
+     *        threads).
+     */
+    std::string content;
+
+    /**
+     * \brief The response's HTTP status.
+     */
+    int http_status;
+
+    /**
+     * \brief The time point when the response expires.
+     */
+    std::chrono::steady_clock::time_point expiry;
+  };
+
+  /**
+   * \brief A mutex for protecting the response cache.
+   */
+  Poco::Mutex response_cache_mutex_;
+
+  /**
+   * \brief The response time-to-lives [microseconds], keyed by resource path.
+   */
+  std::map<std::string, Poco::Int64> response_cache_ttls_;
+
   /**
-   * \brief Container for building the subscription content.
+   * \brief The cached responses, keyed by URI.
    */
-  std::stringstream subscription_content_;
+  std::map<std::string, CachedResponse> response_cache_;
 
   /**
-   * \brief Container for specifying conditions for evaluating the result of a POCO communication.
+   * \brief Statistics about the response cache.
    */
-  EvaluationConditions evaluation_conditions_;
+  ResponseCacheStatistics response_cache_statistics_;
 
   /**
-   * \brief A Document Object Model parser, for parsing into a XML document.
+   * \brief Container for logging communication results.
+   */
+  RWSRequestLog log_;
+
+  /**
+   * \brief The flight recorder (if enabled). Accessed atomically, so that it can be swapped during communication.
+   */
+  std::shared_ptr<RWSFlightRecorder> flight_recorder_;
+
+  /**
+   * \brief Per-endpoint request statistics.
+   */
+  RWSEndpointStatistics endpoint_statistics_;
+
+  /**
+   * \brief A subscription group id.
+   */
+  std::string subscription_group_id_;
+  
+  /**
+   * \brief A mutex for protecting the subscription group id.
    */
-  Poco::XML::DOMParser xml_parser_;
+  Poco::Mutex subscription_mutex_;
 };
 
 } // end namespace rws
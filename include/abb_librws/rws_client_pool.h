@@ -0,0 +1,314 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A pool of RWS clients that runs independent requests concurrently.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_CLIENT_POOL_H
+#define RWS_CLIENT_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rws_client.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for a pool of RWS clients, which all connect to the same robot controller.
+ *
+ * Each pooled client has its own HTTP connection and RWS session, so requests made through different clients can be
+ * in flight at the same time. The clients are created lazily, the first time they are needed.
+ *
+ * Note: A pooled client is only used by one thread at a time. Mastership and subscriptions are bound to the RWS
+ *       session that requested them, so they should not be mixed with pooled requests.
+ */
+class RWSClientPool
+{
+public:
+  /**
+   * \brief A class for an exclusive lease of a pooled client. The client is returned to the pool on destruction.
+   */
+  class Lease
+  {
+  public:
+    /**
+     * \brief A move constructor.
+     *
+     * \param other for the lease to take over.
+     */
+    Lease(Lease&& other) : p_pool_(other.p_pool_), p_client_(other.p_client_)
+    {
+      other.p_pool_ = 0;
+      other.p_client_ = 0;
+    }
+
+    /**
+     * \brief A destructor.
+     */
+    ~Lease();
+
+    /**
+     * \brief A method for retrieving the leased client.
+     *
+     * \return RWSClient& for the leased client.
+     */
+    RWSClient& client() { return *p_client_; }
+
+    /**
+     * \brief Operator for accessing the leased client.
+     *
+     * \return RWSClient* for the leased client.
+     */
+    RWSClient* operator->() { return p_client_; }
+
+  private:
+    friend class RWSClientPool;
+
+    /**
+     * \brief A constructor.
+     *
+     * \param p_pool for the pool that owns the client.
+     * \param p_client for the leased client.
+     */
+    Lease(RWSClientPool* p_pool, RWSClient* p_client) : p_pool_(p_pool), p_client_(p_client) {}
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    /**
+     * \brief The pool that owns the client.
+     */
+    RWSClientPool* p_pool_;
+
+    /**
+     * \brief The leased client.
+     */
+    RWSClient* p_client_;
+  };
+
+  /**
+   * \brief Typedef for a job, which is executed with a leased client.
+   */
+  typedef std::function<void(RWSClient&)> Job;
+
+  /**
+   * \brief A constructor.
+   *
+   * \param ip_address specifying the robot controller's IP address.
+   * \param port for the port used by the RWS server.
+   * \param username for the username to the RWS authentication process.
+   * \param password for the password to the RWS authentication process.
+   * \param ptrContext for the SSL context used by the clients.
+   * \param max_size for the maximum number of clients in the pool.
+   */
+  RWSClientPool(const std::string& ip_address,
+                const unsigned short port,
+                const std::string& username,
+                const std::string& password,
+                const Poco::Net::Context::Ptr ptrContext,
+                const size_t max_size = DEFAULT_MAX_SIZE)
+  :
+  ip_address_(ip_address),
+  port_(port),
+  username_(username),
+  password_(password),
+  ptrContext_(ptrContext),
+  max_size_(max_size < 1 ? 1 : max_size)
+  {}
+
+  /**
+   * \brief A method for setting the maximum number of clients in the pool.
+   *
+   * Note: Already created clients are kept, even if the new maximum is smaller.
+   *
+   * \param max_size for the maximum number of clients (at least one).
+   */
+  void setMaxSize(const size_t max_size);
+
+  /**
+   * \brief A method for retrieving the maximum number of clients in the pool.
+   *
+   * \return size_t containing the maximum number of clients.
+   */
+  size_t getMaxSize();
+
+  /**
+   * \brief A method for leasing a client. Blocks until a client is available.
+   *
+   * \return Lease for the leased client.
+   */
+  Lease acquire();
+
+  /**
+   * \brief A method for executing jobs concurrently, on up to the pool's maximum number of clients.
+   *
+   * The method returns when all jobs have been executed. A single job (or a pool of size one) is executed on the
+   * calling thread.
+   *
+   * Note: If a job throws, no further jobs are started, and the first exception is rethrown on the calling thread
+   *       once all workers have finished.
+   *
+   * \param jobs for the jobs to execute.
+   */
+  void execute(const std::vector<Job>& jobs);
+
+  /**
+   * \brief A struct for containing statistics about the pool (e.g. for metrics).
+   */
+  struct Statistics
+  {
+    /**
+     * \brief The number of leases.
+     */
+    Poco::UInt64 acquisitions;
+
+    /**
+     * \brief The number of leases that had to wait for a client to be returned.
+     */
+    Poco::UInt64 waits;
+
+    /**
+     * \brief The summed time spent waiting for clients [microseconds].
+     */
+    Poco::Int64 total_wait;
+
+    /**
+     * \brief The number of clients created by the pool.
+     */
+    size_t clients;
+  };
+
+  /**
+   * \brief A method for retrieving statistics about the pool.
+   *
+   * \return Statistics containing the statistics.
+   */
+  Statistics getStatistics();
+
+  /**
+   * \brief Static constant for the default maximum number of clients in the pool.
+   */
+  static const size_t DEFAULT_MAX_SIZE = 4;
+
+private:
+  /**
+   * \brief A method for returning a leased client to the pool.
+   *
+   * \param p_client for the client to return.
+   */
+  void release(RWSClient* p_client);
+
+  /**
+   * \brief The robot controller's IP address.
+   */
+  const std::string ip_address_;
+
+  /**
+   * \brief The port used by the RWS server.
+   */
+  const unsigned short port_;
+
+  /**
+   * \brief The username to the RWS authentication process.
+   */
+  const std::string username_;
+
+  /**
+   * \brief The password to the RWS authentication process.
+   */
+  const std::string password_;
+
+  /**
+   * \brief The SSL context used by the clients.
+   */
+  const Poco::Net::Context::Ptr ptrContext_;
+
+  /**
+   * \brief The maximum number of clients in the pool.
+   */
+  size_t max_size_;
+
+  /**
+   * \brief A mutex for protecting the pool's containers.
+   */
+  std::mutex mutex_;
+
+  /**
+   * \brief Condition for signaling that a client has been returned to the pool.
+   */
+  std::condition_variable client_returned_;
+
+  /**
+   * \brief All clients created by the pool.
+   */
+  std::vector<std::unique_ptr<RWSClient>> clients_;
+
+  /**
+   * \brief The clients that are currently not leased.
+   */
+  std::vector<RWSClient*> idle_clients_;
+
+  /**
+   * \brief The number of leases.
+   */
+  std::atomic<Poco::UInt64> acquisitions_{0};
+
+  /**
+   * \brief The number of leases that had to wait for a client.
+   */
+  std::atomic<Poco::UInt64> waits_{0};
+
+  /**
+   * \brief The summed time spent waiting for clients [microseconds].
+   */
+  std::atomic<Poco::Int64> total_wait_{0};
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
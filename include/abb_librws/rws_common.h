@@ -387,11 +387,21 @@ struct SystemConstants
        */
   inline static const XMLAttribute CLASS_DATTYP = XMLAttribute("class", "dattyp");
       
+      /**
+       * \brief Class & dimensions.
+       */
+  inline static const XMLAttribute CLASS_DIM = XMLAttribute("class", "dim");
+
       /**
        * \brief Class & ios-signal.
        */
   inline static const XMLAttribute CLASS_IOS_SIGNAL = XMLAttribute("class", "ios-signal");
 
+      /**
+       * \brief Class & ios-signalstate-ev.
+       */
+  inline static const XMLAttribute CLASS_IOS_SIGNALSTATE_EV = XMLAttribute("class", "ios-signalstate-ev");
+
       /**
        * \brief Class & lvalue.
        */
@@ -407,6 +417,11 @@ struct SystemConstants
        */
   inline static const XMLAttribute CLASS_NAME = XMLAttribute("class", "name");
 
+      /**
+       * \brief Class & number of dimensions.
+       */
+  inline static const XMLAttribute CLASS_NDIM = XMLAttribute("class", "ndim");
+
       /**
        * \brief Class & operation mode.
        */
@@ -432,6 +447,11 @@ struct SystemConstants
        */
   inline static const XMLAttribute CLASS_STATE = XMLAttribute("class", "state");
       
+      /**
+       * \brief Class & symbol type.
+       */
+  inline static const XMLAttribute CLASS_SYMTYP = XMLAttribute("class", "symtyp");
+
       /**
        * \brief Class & sys-system-li.
        */
@@ -442,6 +462,11 @@ struct SystemConstants
        */
   inline static const XMLAttribute CLASS_TYPE = XMLAttribute("class", "type");
 
+      /**
+       * \brief Class & type URL.
+       */
+  inline static const XMLAttribute CLASS_TYPURL = XMLAttribute("class", "typurl");
+
       /**
        * \brief Class & value.
        */
@@ -488,6 +513,11 @@ struct SystemConstants
        */
   inline static const std::string IOS_SIGNAL                     = "ios-signal";
 
+      /**
+       * \brief IO signal state event.
+       */
+  inline static const std::string IOS_SIGNALSTATE_EV             = "ios-signalstate-ev";
+
       /**
        * \brief Motion task.
        */
@@ -0,0 +1,251 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Per-endpoint request statistics, i.e. latency histograms and phase timing totals.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_ENDPOINT_STATISTICS_H
+#define RWS_ENDPOINT_STATISTICS_H
+
+#include <atomic>
+#include <vector>
+
+#include "Poco/Types.h"
+
+#include "rws_endpoints.h"
+#include "rws_poco_client.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for per-endpoint request statistics, i.e. latency histograms and phase timing totals.
+ *
+ * The statistics are kept in atomic counters (indexed by the endpoint ids), so that adding a request is lock-free.
+ */
+class RWSEndpointStatistics
+{
+public:
+  /**
+   * \brief Static constant for the number of latency histogram buckets.
+   */
+  static const size_t NUMBER_OF_BUCKETS = 16;
+
+  /**
+   * \brief Static constant for the upper bounds of the latency histogram buckets [microseconds]. The last bucket
+   *        (i.e. above the last bound) is unbounded.
+   */
+  static constexpr Poco::Int64 BUCKET_UPPER_BOUNDS[NUMBER_OF_BUCKETS - 1] =
+    {500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000, 2000000, 5000000, 10000000, 30000000};
+
+  /**
+   * \brief Static constant for the number of response status classes. Index zero is for communications without a
+   *        (HTTP) response, e.g. timeouts, and index n for nxx statuses.
+   */
+  static const size_t NUMBER_OF_STATUS_CLASSES = 6;
+
+  /**
+   * \brief A struct for a snapshot of an endpoint's statistics.
+   */
+  struct Snapshot
+  {
+    /**
+     * \brief The endpoint's id.
+     */
+    EndpointDescriptor::Id endpoint;
+
+    /**
+     * \brief The endpoint's name.
+     */
+    const char* name;
+
+    /**
+     * \brief The number of requests.
+     */
+    Poco::UInt64 count;
+
+    /**
+     * \brief The number of requests that failed (i.e. communication errors, or unexpected HTTP statuses).
+     */
+    Poco::UInt64 failures;
+
+    /**
+     * \brief The number of requests per response status class (see NUMBER_OF_STATUS_CLASSES).
+     */
+    Poco::UInt64 statuses[NUMBER_OF_STATUS_CLASSES];
+
+    /**
+     * \brief The latency histogram, i.e. the number of requests per bucket (see BUCKET_UPPER_BOUNDS).
+     */
+    Poco::UInt64 buckets[NUMBER_OF_BUCKETS];
+
+    /**
+     * \brief The summed durations of the requests [microseconds].
+     */
+    Poco::Int64 total_duration;
+
+    /**
+     * \brief The summed phase timings of the requests (the start time is not used).
+     */
+    POCOClient::POCOResult::Timing total_timing;
+
+    /**
+     * \brief A method for estimating a latency percentile from the histogram.
+     *
+     * \param quantile for the quantile (e.g. 0.99).
+     *
+     * \return Poco::Int64 containing the upper bound of the bucket containing the quantile [microseconds], or -1 if
+     *         there are no requests, or if the quantile is in the unbounded bucket.
+     */
+    Poco::Int64 getPercentile(const double quantile) const;
+  };
+
+  /**
+   * \brief A default constructor.
+   */
+  RWSEndpointStatistics() { reset(); }
+
+  /**
+   * \brief A method for adding a request's result to the statistics.
+   *
+   * \param endpoint describing the endpoint that was requested.
+   * \param poco_result containing the result of the communication.
+   * \param success indicating if the request succeeded or not.
+   */
+  void add(const EndpointDescriptor& endpoint, const POCOClient::POCOResult& poco_result, const bool success);
+
+  /**
+   * \brief A method for retrieving snapshots of the statistics.
+   *
+   * \return std::vector<Snapshot> containing a snapshot for each endpoint that has been requested.
+   */
+  std::vector<Snapshot> getSnapshots() const;
+
+  /**
+   * \brief A method for resetting the statistics.
+   */
+  void reset();
+
+  /**
+   * \brief A method for finding the latency histogram bucket of a duration.
+   *
+   * \param duration for the duration [microseconds].
+   *
+   * \return size_t containing the bucket's index.
+   */
+  static size_t findBucket(const Poco::Int64 duration);
+
+private:
+  /**
+   * \brief A struct for an endpoint's counters.
+   */
+  struct Counters
+  {
+    /**
+     * \brief The number of requests.
+     */
+    std::atomic<Poco::UInt64> count;
+
+    /**
+     * \brief The number of failed requests.
+     */
+    std::atomic<Poco::UInt64> failures;
+
+    /**
+     * \brief The number of requests per response status class.
+     */
+    std::atomic<Poco::UInt64> statuses[NUMBER_OF_STATUS_CLASSES];
+
+    /**
+     * \brief The latency histogram.
+     */
+    std::atomic<Poco::UInt64> buckets[NUMBER_OF_BUCKETS];
+
+    /**
+     * \brief The summed durations [microseconds].
+     */
+    std::atomic<Poco::Int64> duration;
+
+    /**
+     * \brief The summed mutex waits [microseconds].
+     */
+    std::atomic<Poco::Int64> lock_wait;
+
+    /**
+     * \brief The summed connection times [microseconds].
+     */
+    std::atomic<Poco::Int64> connect;
+
+    /**
+     * \brief The summed send times [microseconds].
+     */
+    std::atomic<Poco::Int64> send;
+
+    /**
+     * \brief The summed server times [microseconds].
+     */
+    std::atomic<Poco::Int64> server;
+
+    /**
+     * \brief The summed receive times [microseconds].
+     */
+    std::atomic<Poco::Int64> receive;
+
+    /**
+     * \brief The summed authentication times [microseconds].
+     */
+    std::atomic<Poco::Int64> authentication;
+
+    /**
+     * \brief The summed number of HTTP exchanges.
+     */
+    std::atomic<Poco::Int64> exchanges;
+  };
+
+  /**
+   * \brief The counters, indexed by the endpoint ids.
+   */
+  Counters counters_[EndpointDescriptor::NUMBER_OF_ENDPOINTS];
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
@@ -0,0 +1,496 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Descriptors of the Robot Web Services endpoints used by the RWS client.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_ENDPOINTS_H
+#define RWS_ENDPOINTS_H
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+#include "Poco/Types.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A struct for describing a RWS operation (i.e. an endpoint), at compile time.
+ *
+ * The descriptors are used by RWSClient's generic executor, which makes the request, evaluates the response, and
+ * applies retries and caching as described.
+ */
+struct EndpointDescriptor
+{
+  /**
+   * \brief An enum for identifying the endpoints (e.g. as indices into per-endpoint statistics).
+   */
+  enum Id
+  {
+    GET_CONFIGURATION_INSTANCES,
+    GET_IO_SIGNAL,
+    GET_MECHUNIT_JOINTTARGET,
+    GET_MECHUNIT_ROBTARGET,
+    GET_RAPID_EXECUTION,
+    GET_RAPID_MODULES_INFO,
+    GET_RAPID_TASKS,
+    GET_ROBOTWARE_SYSTEM,
+    GET_PANEL_CTRLSTATE,
+    GET_PANEL_OPMODE,
+    GET_RAPID_SYMBOL_DATA,
+    GET_RAPID_SYMBOL_PROPERTIES,
+    GET_RAPID_TYPE_PROPERTIES,
+    SEARCH_RAPID_SYMBOLS,
+    SET_IO_SIGNAL,
+    SET_RAPID_SYMBOL_DATA,
+    START_RAPID_EXECUTION,
+    STOP_RAPID_EXECUTION,
+    RESET_RAPID_PROGRAM_POINTER,
+    SET_PANEL_CTRLSTATE,
+    SET_LEAD_THROUGH,
+    GET_FILE,
+    UPLOAD_FILE,
+    DELETE_FILE,
+    START_SUBSCRIPTION,
+    CONNECT_SUBSCRIPTION,
+    WAIT_FOR_SUBSCRIPTION_EVENT,
+    END_SUBSCRIPTION,
+    LOGOUT,
+    REGISTER_USER,
+    REQUEST_MASTERSHIP,
+    RELEASE_MASTERSHIP,
+    NUMBER_OF_ENDPOINTS ///< Not an endpoint, only the number of endpoints.
+  };
+
+  /**
+   * \brief An enum for the request methods.
+   */
+  enum Method
+  {
+    METHOD_GET,      ///< HTTP GET.
+    METHOD_POST,     ///< HTTP POST.
+    METHOD_PUT,      ///< HTTP PUT.
+    METHOD_DELETE,   ///< HTTP DELETE.
+    METHOD_WEBSOCKET ///< WebSocket connection or frame.
+  };
+
+  /**
+   * \brief An enum for how the response should be parsed.
+   */
+  enum ParseMode
+  {
+    PARSE_NONE, ///< The response is not parsed.
+    PARSE_XML   ///< The response is parsed into a XML document.
+  };
+
+  /**
+   * \brief An enum for when a request may be retried.
+   */
+  enum RetryClass
+  {
+    RETRY_NEVER,              ///< The request is never retried.
+    RETRY_ON_TRANSPORT_ERROR  ///< The request is retried once if the communication failed (e.g. a timeout).
+  };
+
+  /**
+   * \brief A method for mapping an accepted HTTP status (1xx to 4xx, with at most 15 as the last two digits) to a bit.
+   *
+   * \param status for the HTTP status.
+   *
+   * \return Poco::UInt64 containing the status' bit (zero if the status can't be represented).
+   */
+  static constexpr Poco::UInt64 statusBit(const int status)
+  {
+    return (status >= 100 && status < 500 && status % 100 < 16 ?
+            Poco::UInt64(1) << ((status / 100 - 1) * 16 + status % 100) : 0);
+  }
+
+  /**
+   * \brief A method for checking if a HTTP status is accepted by the endpoint.
+   *
+   * \param status for the HTTP status.
+   *
+   * \return bool indicating if the status is accepted.
+   */
+  constexpr bool accepts(const int status) const
+  {
+    return (accepted_statuses & statusBit(status)) != 0;
+  }
+
+  /**
+   * \brief The endpoint's id.
+   */
+  Id id;
+
+  /**
+   * \brief The endpoint's name (e.g. for logs and statistics).
+   */
+  const char* name;
+
+  /**
+   * \brief The request method.
+   */
+  Method method;
+
+  /**
+   * \brief The path template, where each "{}" is replaced by an argument.
+   */
+  const char* path_template;
+
+  /**
+   * \brief The accepted HTTP statuses, as a bitmask (see statusBit(...)).
+   */
+  Poco::UInt64 accepted_statuses;
+
+  /**
+   * \brief How the response should be parsed.
+   */
+  ParseMode parse_mode;
+
+  /**
+   * \brief Indicator for if the request can be repeated without changing the outcome.
+   */
+  bool idempotent;
+
+  /**
+   * \brief When the request may be retried.
+   */
+  RetryClass retry_class;
+
+  /**
+   * \brief Indicator for if the response may be answered from the response cache.
+   */
+  bool cacheable;
+};
+
+/**
+ * \brief The descriptors of the RWS operations used by RWSClient.
+ *
+ * Note: The paths mirror SystemConstants::RWS::Resources, but are kept as literals so the descriptors can be constexpr.
+ */
+struct Endpoints
+{
+  /**
+   * \brief Typedef for the endpoint descriptor.
+   */
+  typedef EndpointDescriptor E;
+
+  /**
+   * \brief Accepted status: 101 Switching Protocols.
+   */
+  static constexpr Poco::UInt64 SWITCHING_PROTOCOLS = E::statusBit(101);
+
+  /**
+   * \brief Accepted status: 200 OK.
+   */
+  static constexpr Poco::UInt64 OK = E::statusBit(200);
+
+  /**
+   * \brief Accepted status: 201 Created.
+   */
+  static constexpr Poco::UInt64 CREATED = E::statusBit(201);
+
+  /**
+   * \brief Accepted status: 204 No Content.
+   */
+  static constexpr Poco::UInt64 NO_CONTENT = E::statusBit(204);
+
+  /**
+   * \brief Retrieve the instances of a configuration type (arguments: topic and type).
+   */
+  static constexpr E GET_CONFIGURATION_INSTANCES =
+    {E::GET_CONFIGURATION_INSTANCES, "getConfigurationInstances", E::METHOD_GET, "/rw/cfg/{}/{}/instances",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, true};
+
+  /**
+   * \brief Retrieve an IO signal (argument: signal name).
+   */
+  static constexpr E GET_IO_SIGNAL =
+    {E::GET_IO_SIGNAL, "getIOSignal", E::METHOD_GET, "/rw/iosystem/signals/{}",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve a mechanical unit's joint target (argument: mechanical unit name).
+   */
+  static constexpr E GET_MECHUNIT_JOINTTARGET =
+    {E::GET_MECHUNIT_JOINTTARGET, "getMechanicalUnitJointTarget", E::METHOD_GET,
+     "/rw/motionsystem/mechunits/{}/jointtarget",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve a mechanical unit's robot target (argument: mechanical unit name).
+   */
+  static constexpr E GET_MECHUNIT_ROBTARGET =
+    {E::GET_MECHUNIT_ROBTARGET, "getMechanicalUnitRobTarget", E::METHOD_GET,
+     "/rw/motionsystem/mechunits/{}/robtarget",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve the RAPID execution state.
+   */
+  static constexpr E GET_RAPID_EXECUTION =
+    {E::GET_RAPID_EXECUTION, "getRAPIDExecution", E::METHOD_GET, "/rw/rapid/execution",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve the RAPID modules of a task (argument: task name).
+   */
+  static constexpr E GET_RAPID_MODULES_INFO =
+    {E::GET_RAPID_MODULES_INFO, "getRAPIDModulesInfo", E::METHOD_GET, "/rw/rapid/tasks/{}/modules",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, true};
+
+  /**
+   * \brief Retrieve the RAPID tasks.
+   */
+  static constexpr E GET_RAPID_TASKS =
+    {E::GET_RAPID_TASKS, "getRAPIDTasks", E::METHOD_GET, "/rw/rapid/tasks",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, true};
+
+  /**
+   * \brief Retrieve the RobotWare system information.
+   */
+  static constexpr E GET_ROBOTWARE_SYSTEM =
+    {E::GET_ROBOTWARE_SYSTEM, "getRobotWareSystem", E::METHOD_GET, "/rw/system",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, true};
+
+  /**
+   * \brief Retrieve the controller state.
+   */
+  static constexpr E GET_PANEL_CTRLSTATE =
+    {E::GET_PANEL_CTRLSTATE, "getPanelControllerState", E::METHOD_GET, "/rw/panel/ctrl-state",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve the operation mode.
+   */
+  static constexpr E GET_PANEL_OPMODE =
+    {E::GET_PANEL_OPMODE, "getPanelOperationMode", E::METHOD_GET, "/rw/panel/opmode",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve a RAPID symbol's data (arguments: task, module and symbol names).
+   */
+  static constexpr E GET_RAPID_SYMBOL_DATA =
+    {E::GET_RAPID_SYMBOL_DATA, "getRAPIDSymbolData", E::METHOD_GET, "/rw/rapid/symbol/RAPID/{}/{}/{}/data",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve a RAPID symbol's properties (arguments: task, module and symbol names).
+   */
+  static constexpr E GET_RAPID_SYMBOL_PROPERTIES =
+    {E::GET_RAPID_SYMBOL_PROPERTIES, "getRAPIDSymbolProperties", E::METHOD_GET,
+     "/rw/rapid/symbol/RAPID/{}/{}/{}/properties",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve a RAPID data type's properties (argument: the type's URL, e.g. "RAPID/robtarget").
+   */
+  static constexpr E GET_RAPID_TYPE_PROPERTIES =
+    {E::GET_RAPID_TYPE_PROPERTIES, "getRAPIDTypeProperties", E::METHOD_GET, "/rw/rapid/symbol/{}/properties",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Search for RAPID symbols, e.g. the components of a record type (the search parameters are the content).
+   */
+  static constexpr E SEARCH_RAPID_SYMBOLS =
+    {E::SEARCH_RAPID_SYMBOLS, "searchRAPIDSymbols", E::METHOD_POST, "/rw/rapid/symbols/search",
+     OK, E::PARSE_XML, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Set an IO signal (argument: signal name).
+   */
+  static constexpr E SET_IO_SIGNAL =
+    {E::SET_IO_SIGNAL, "setIOSignal", E::METHOD_POST, "/rw/iosystem/signals/{}/set-value",
+     NO_CONTENT, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Set a RAPID symbol's data (arguments: task, module and symbol names).
+   */
+  static constexpr E SET_RAPID_SYMBOL_DATA =
+    {E::SET_RAPID_SYMBOL_DATA, "setRAPIDSymbolData", E::METHOD_POST, "/rw/rapid/symbol/RAPID/{}/{}/{}/data",
+     NO_CONTENT, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Start RAPID execution.
+   */
+  static constexpr E START_RAPID_EXECUTION =
+    {E::START_RAPID_EXECUTION, "startRAPIDExecution", E::METHOD_POST, "/rw/rapid/execution/start",
+     NO_CONTENT, E::PARSE_NONE, false, E::RETRY_NEVER, false};
+
+  /**
+   * \brief Stop RAPID execution.
+   */
+  static constexpr E STOP_RAPID_EXECUTION =
+    {E::STOP_RAPID_EXECUTION, "stopRAPIDExecution", E::METHOD_POST, "/rw/rapid/execution/stop",
+     NO_CONTENT, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Reset the RAPID program pointer.
+   */
+  static constexpr E RESET_RAPID_PROGRAM_POINTER =
+    {E::RESET_RAPID_PROGRAM_POINTER, "resetRAPIDProgramPointer", E::METHOD_POST, "/rw/rapid/execution/resetpp",
+     NO_CONTENT, E::PARSE_NONE, false, E::RETRY_NEVER, false};
+
+  /**
+   * \brief Set the controller state (e.g. motors on).
+   */
+  static constexpr E SET_PANEL_CTRLSTATE =
+    {E::SET_PANEL_CTRLSTATE, "setPanelControllerState", E::METHOD_POST, "/rw/panel/ctrl-state",
+     NO_CONTENT, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Set a mechanical unit's lead through state (argument: mechanical unit name).
+   */
+  static constexpr E SET_LEAD_THROUGH =
+    {E::SET_LEAD_THROUGH, "setLeadThrough", E::METHOD_POST, "/rw/motionsystem/mechunits/{}/lead-through",
+     NO_CONTENT, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Retrieve a file (arguments: directory and file name).
+   */
+  static constexpr E GET_FILE =
+    {E::GET_FILE, "getFile", E::METHOD_GET, "/fileservice/{}/{}",
+     OK, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Upload a file (arguments: directory and file name).
+   */
+  static constexpr E UPLOAD_FILE =
+    {E::UPLOAD_FILE, "uploadFile", E::METHOD_PUT, "/fileservice/{}/{}",
+     OK | CREATED, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Delete a file (arguments: directory and file name).
+   */
+  static constexpr E DELETE_FILE =
+    {E::DELETE_FILE, "deleteFile", E::METHOD_DELETE, "/fileservice/{}/{}",
+     OK | NO_CONTENT, E::PARSE_NONE, false, E::RETRY_NEVER, false};
+
+  /**
+   * \brief Start a subscription.
+   */
+  static constexpr E START_SUBSCRIPTION =
+    {E::START_SUBSCRIPTION, "startSubscription", E::METHOD_POST, "/subscription",
+     CREATED, E::PARSE_NONE, false, E::RETRY_NEVER, false};
+
+  /**
+   * \brief Connect a WebSocket to a subscription group (argument: subscription group id).
+   */
+  static constexpr E CONNECT_SUBSCRIPTION =
+    {E::CONNECT_SUBSCRIPTION, "connectSubscription", E::METHOD_WEBSOCKET, "/poll/{}",
+     SWITCHING_PROTOCOLS, E::PARSE_NONE, false, E::RETRY_NEVER, false};
+
+  /**
+   * \brief Receive a subscription event (WebSocket frame).
+   */
+  static constexpr E WAIT_FOR_SUBSCRIPTION_EVENT =
+    {E::WAIT_FOR_SUBSCRIPTION_EVENT, "waitForSubscriptionEvent", E::METHOD_WEBSOCKET, "",
+     OK, E::PARSE_XML, false, E::RETRY_NEVER, false};
+
+  /**
+   * \brief End a subscription (argument: subscription group id).
+   */
+  static constexpr E END_SUBSCRIPTION =
+    {E::END_SUBSCRIPTION, "endSubscription", E::METHOD_DELETE, "/subscription/{}",
+     OK, E::PARSE_NONE, false, E::RETRY_NEVER, false};
+
+  /**
+   * \brief Log out.
+   */
+  static constexpr E LOGOUT =
+    {E::LOGOUT, "logout", E::METHOD_GET, "/logout",
+     OK, E::PARSE_XML, false, E::RETRY_NEVER, false};
+
+  /**
+   * \brief Register a user (local or remote).
+   */
+  static constexpr E REGISTER_USER =
+    {E::REGISTER_USER, "registerUser", E::METHOD_POST, "/users",
+     OK | CREATED, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Request mastership of the edit domain.
+   */
+  static constexpr E REQUEST_MASTERSHIP =
+    {E::REQUEST_MASTERSHIP, "requestMasterShip", E::METHOD_POST, "/rw/mastership/edit/request",
+     NO_CONTENT, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+
+  /**
+   * \brief Release mastership of the edit domain.
+   */
+  static constexpr E RELEASE_MASTERSHIP =
+    {E::RELEASE_MASTERSHIP, "releaseMasterShip", E::METHOD_POST, "/rw/mastership/edit/release",
+     NO_CONTENT, E::PARSE_NONE, true, E::RETRY_ON_TRANSPORT_ERROR, false};
+};
+
+/**
+ * \brief A function for expanding an endpoint's path template, i.e. replacing each "{}" with the next argument.
+ *
+ * \param path_template for the path template.
+ * \param arguments for the arguments.
+ *
+ * \return std::string containing the expanded path.
+ */
+std::string expandEndpointPath(const char* path_template, std::initializer_list<std::string_view> arguments);
+
+/**
+ * \brief A function for looking up an endpoint's descriptor by its id.
+ *
+ * \param id for the endpoint's id (must be less than EndpointDescriptor::NUMBER_OF_ENDPOINTS).
+ *
+ * \return const EndpointDescriptor& reference to the endpoint's descriptor.
+ */
+const EndpointDescriptor& getEndpointDescriptor(const EndpointDescriptor::Id id);
+
+/**
+ * \brief A function for mapping a request method to a std::string (e.g. "GET").
+ *
+ * \param method for the request method.
+ *
+ * \return const char* containing the mapped method.
+ */
+const char* mapEndpointMethod(const EndpointDescriptor::Method method);
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
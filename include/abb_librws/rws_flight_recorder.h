@@ -0,0 +1,179 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Recording of RWS traffic into a memory-mapped ring file, which outlives the process.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_FLIGHT_RECORDER_H
+#define RWS_FLIGHT_RECORDER_H
+
+#include <string>
+#include <vector>
+
+#include "Poco/SharedMemory.h"
+#include "Poco/Types.h"
+
+#include "rws_endpoints.h"
+#include "rws_poco_client.h"
+#include "rws_request_log.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for recording RWS traffic into a memory-mapped ring file, which outlives the process.
+ *
+ * Each exchange is stored as a compact record (see RWSRequestLog::Record), together with the first bytes of the
+ * response's content. Writers claim a slot with an atomic sequence counter, and publish the slot by storing its
+ * sequence number last, i.e. recording is lock-free. Since the file is mapped (shared), the recorded data is kept
+ * by the operating system if the process crashes, and a slot that was being written during the crash is skipped
+ * when the file is read.
+ *
+ * Note: The ring's capacity should be (much) larger than the number of concurrent writers, otherwise a slow writer
+ *       can be lapped by another writer of the same slot.
+ */
+class RWSFlightRecorder
+{
+public:
+  /**
+   * \brief Static constant for the number of response content bytes kept per record.
+   */
+  static const size_t CAPTURE_SIZE = 256;
+
+  /**
+   * \brief A struct for a record read from a flight recorder file.
+   */
+  struct Entry
+  {
+    /**
+     * \brief The record's sequence number (i.e. the order in which the records were made).
+     */
+    Poco::UInt64 sequence;
+
+    /**
+     * \brief The record.
+     */
+    RWSRequestLog::Record record;
+
+    /**
+     * \brief The captured response content.
+     */
+    std::string capture;
+  };
+
+  /**
+   * \brief A constructor, which opens (or creates) and maps the file.
+   *
+   * An existing file with the same layout is appended to, otherwise the file is (re)initialized.
+   *
+   * \param path for the file's path.
+   * \param capacity for the number of records kept in the file.
+   *
+   * \throw Poco::Exception if the file can't be created or mapped.
+   */
+  RWSFlightRecorder(const std::string& path, const size_t capacity);
+
+  /**
+   * \brief A method for recording a communication result.
+   *
+   * \param endpoint describing the endpoint that was requested.
+   * \param poco_result containing the result of the communication.
+   */
+  void add(const EndpointDescriptor& endpoint, const POCOClient::POCOResult& poco_result);
+
+  /**
+   * \brief A method for retrieving the file's path.
+   *
+   * \return const std::string& reference to the path.
+   */
+  const std::string& getPath() const { return path_; }
+
+  /**
+   * \brief A method for reading the (completely written) records of a flight recorder file.
+   *
+   * \param path for the file's path.
+   *
+   * \return std::vector<Entry> containing the records, the oldest first.
+   *
+   * \throw Poco::Exception if the file can't be mapped, or isn't a flight recorder file.
+   */
+  static std::vector<Entry> read(const std::string& path);
+
+private:
+  /**
+   * \brief Forward declaration of the file's header.
+   */
+  struct FileHeader;
+
+  /**
+   * \brief Forward declaration of a slot in the file.
+   */
+  struct Slot;
+
+  /**
+   * \brief The file's path.
+   */
+  std::string path_;
+
+  /**
+   * \brief The file's mapping.
+   */
+  Poco::SharedMemory memory_;
+
+  /**
+   * \brief The mapped file's header.
+   */
+  FileHeader* p_header_;
+
+  /**
+   * \brief The mapped file's slots.
+   */
+  Slot* p_slots_;
+
+  /**
+   * \brief The number of slots.
+   */
+  size_t capacity_;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
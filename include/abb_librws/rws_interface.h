@@ -46,7 +46,14 @@
 #ifndef RWS_INTERFACE_H
 #define RWS_INTERFACE_H
 
+#include <chrono>
+#include <map>
+#include <mutex>
+
 #include "rws_client.h"
+#include "rws_client_pool.h"
+#include "rws_mastership_manager.h"
+#include "rws_metrics.h"
 
 namespace abb
 {
@@ -54,6 +61,9 @@ namespace rws
 {
 /**
  * \brief A class for wrapping a Robot Web Services (RWS) client in a more user friendly interface.
+ *
+ * Thread safety: The methods may be called concurrently from several threads (see RWSClient). Calls are served by
+ * the interface's own RWS session, except for the batch and snapshot methods, which use the client pool.
  */
 class RWSInterface
 {
@@ -205,18 +215,236 @@ public:
     bool rws_connected;
   };
 
+  /**
+   * \brief A struct for specifying a requested IO signal write.
+   */
+  struct IOSignalWrite
+  {
+    /**
+     * \brief A constructor.
+     *
+     * \param name for the name of the IO signal.
+     * \param value for the IO signal's new value.
+     */
+    IOSignalWrite(const std::string& name, const std::string& value)
+    :
+    name(name),
+    value(value)
+    {}
+
+    /**
+     * \brief The IO signal's name.
+     */
+    std::string name;
+
+    /**
+     * \brief The IO signal's new value.
+     */
+    std::string value;
+  };
+
+  /**
+   * \brief A struct for containing the outcome of a requested IO signal write.
+   */
+  struct IOSignalWriteResult
+  {
+    /**
+     * \brief An enum for the possible outcomes.
+     */
+    enum Outcome
+    {
+      WRITTEN,            ///< The value was written to the robot controller.
+      SKIPPED_UNCHANGED,  ///< The write was skipped, since the last known value was the same.
+      SKIPPED_SUPERSEDED, ///< The write was skipped, since a later write in the same batch targets the same signal.
+      FAILED              ///< The write was attempted, but failed.
+    };
+
+    /**
+     * \brief A constructor.
+     *
+     * \param write for the requested write.
+     */
+    IOSignalWriteResult(const IOSignalWrite& write)
+    :
+    name(write.name),
+    value(write.value),
+    outcome(FAILED)
+    {}
+
+    /**
+     * \brief The IO signal's name.
+     */
+    std::string name;
+
+    /**
+     * \brief The requested value.
+     */
+    std::string value;
+
+    /**
+     * \brief The outcome of the write.
+     */
+    Outcome outcome;
+
+    /**
+     * \brief Container for an error message (if the write failed).
+     */
+    std::string error_message;
+  };
+
+  /**
+   * \brief A struct for specifying a RAPID symbol access (i.e. a read or a write) in a batch.
+   */
+  struct RAPIDSymbolAccess
+  {
+    /**
+     * \brief A constructor.
+     *
+     * \param resource specifying the RAPID task, module and symbol names for the RAPID resource.
+     * \param p_data for the data to read into, or write from. It must outlive the batch call.
+     */
+    RAPIDSymbolAccess(const RWSClient::RAPIDResource& resource, RAPIDSymbolDataAbstract* p_data)
+    :
+    resource(resource),
+    p_data(p_data)
+    {}
+
+    /**
+     * \brief The RAPID resource.
+     */
+    RWSClient::RAPIDResource resource;
+
+    /**
+     * \brief The data to read into, or write from.
+     */
+    RAPIDSymbolDataAbstract* p_data;
+  };
+
+  /**
+   * \brief A struct for containing the outcome of a RAPID symbol access in a batch.
+   */
+  struct RAPIDSymbolAccessResult
+  {
+    /**
+     * \brief An enum for the possible outcomes.
+     */
+    enum Outcome
+    {
+      SUCCEEDED,     ///< The access succeeded.
+      FAILED,        ///< The access was attempted, but failed.
+      NOT_ATTEMPTED, ///< The access was not attempted, since an all-or-nothing batch was aborted.
+      ROLLED_BACK    ///< The write succeeded, but was rolled back since an all-or-nothing batch was aborted.
+    };
+
+    /**
+     * \brief A default constructor.
+     */
+    RAPIDSymbolAccessResult() : outcome(NOT_ATTEMPTED) {}
+
+    /**
+     * \brief The outcome of the access.
+     */
+    Outcome outcome;
+
+    /**
+     * \brief Container for an error message (if the access failed, or a rollback failed).
+     */
+    std::string error_message;
+  };
+
+  /**
+   * \brief A struct for specifying what to sample in a controller state snapshot.
+   */
+  struct SnapshotRequest
+  {
+    /**
+     * \brief The mechanical units' joint targets to sample (keyed by mechanical unit name). The targets must outlive
+     *        the snapshot call.
+     */
+    std::map<std::string, JointTarget*> jointtargets;
+
+    /**
+     * \brief The mechanical units' robot targets to sample (keyed by mechanical unit name). The targets must outlive
+     *        the snapshot call.
+     */
+    std::map<std::string, RobTarget*> robtargets;
+
+    /**
+     * \brief The names of the IO signals to sample.
+     */
+    std::vector<std::string> iosignals;
+
+    /**
+     * \brief The RAPID symbols to sample.
+     */
+    std::vector<RAPIDSymbolAccess> rapid_symbols;
+  };
+
+  /**
+   * \brief A struct for containing a controller state snapshot.
+   */
+  struct Snapshot
+  {
+    /**
+     * \brief A default constructor.
+     */
+    Snapshot() : skew(0), complete(false) {}
+
+    /**
+     * \brief The runtime information.
+     */
+    RuntimeInfo runtime_info;
+
+    /**
+     * \brief The sampled IO signal values (keyed by IO signal name). Failed samples are left out.
+     */
+    std::map<std::string, std::string> iosignals;
+
+    /**
+     * \brief The outcome of each RAPID symbol sample (in the same order as requested).
+     */
+    std::vector<RAPIDSymbolAccessResult> rapid_symbols;
+
+    /**
+     * \brief Descriptions of the samples that failed.
+     */
+    std::vector<std::string> errors;
+
+    /**
+     * \brief The snapshot's time stamp, i.e. the middle of the sampling window.
+     */
+    std::chrono::system_clock::time_point timestamp;
+
+    /**
+     * \brief The time between the first and the last sample [microseconds]. Each sample is taken as the middle of
+     *        its request.
+     */
+    Poco::Int64 skew;
+
+    /**
+     * \brief Indicator for if all samples succeeded.
+     */
+    bool complete;
+  };
+
   /**
    * \brief A constructor.
    *
    * \param ip_address specifying the robot controller's IP address.
    */
-  RWSInterface(const std::string ip_address, const Poco::Net::Context::Ptr ptrContext)
+  RWSInterface(const std::string& ip_address, const Poco::Net::Context::Ptr ptrContext)
   :
   rws_client_(ip_address,
               SystemConstants::General::DEFAULT_PORT_NUMBER,
               SystemConstants::General::DEFAULT_USERNAME,
               SystemConstants::General::DEFAULT_PASSWORD,
-              ptrContext)
+              ptrContext),
+  client_pool_(ip_address,
+               SystemConstants::General::DEFAULT_PORT_NUMBER,
+               SystemConstants::General::DEFAULT_USERNAME,
+               SystemConstants::General::DEFAULT_PASSWORD,
+               ptrContext),
+  mastership_manager_(rws_client_)
   {}
 
   /**
@@ -226,13 +454,19 @@ public:
    * \param username for the username to the RWS authentication process.
    * \param password for the password to the RWS authentication process.
    */
-  RWSInterface(const std::string ip_address, const std::string username, const std::string password, const Poco::Net::Context::Ptr ptrContext)
+  RWSInterface(const std::string& ip_address, const std::string& username, const std::string& password, const Poco::Net::Context::Ptr ptrContext)
   :
   rws_client_(ip_address,
               SystemConstants::General::DEFAULT_PORT_NUMBER,
               username,
               password,
-              ptrContext)
+              ptrContext),
+  client_pool_(ip_address,
+               SystemConstants::General::DEFAULT_PORT_NUMBER,
+               username,
+               password,
+               ptrContext),
+  mastership_manager_(rws_client_)
   {}
 
   /**
@@ -241,13 +475,19 @@ public:
    * \param ip_address specifying the robot controller's IP address.
    * \param port for the port used by the RWS server.
    */
-  RWSInterface(const std::string ip_address, const unsigned short port, const Poco::Net::Context::Ptr ptrContext)
+  RWSInterface(const std::string& ip_address, const unsigned short port, const Poco::Net::Context::Ptr ptrContext)
   :
   rws_client_(ip_address,
               port,
               SystemConstants::General::DEFAULT_USERNAME,
               SystemConstants::General::DEFAULT_PASSWORD,
-              ptrContext)
+              ptrContext),
+  client_pool_(ip_address,
+               port,
+               SystemConstants::General::DEFAULT_USERNAME,
+               SystemConstants::General::DEFAULT_PASSWORD,
+               ptrContext),
+  mastership_manager_(rws_client_)
   {}
 
   /**
@@ -258,17 +498,23 @@ public:
    * \param username for the username to the RWS authentication process.
    * \param password for the password to the RWS authentication process.
    */
-  RWSInterface(const std::string ip_address,
+  RWSInterface(const std::string& ip_address,
                const unsigned short port,
-               const std::string username,
-               const std::string password,
+               const std::string& username,
+               const std::string& password,
                const Poco::Net::Context::Ptr ptrContext)
   :
   rws_client_(ip_address,
               port,
               username,
               password,
-              ptrContext)
+              ptrContext),
+  client_pool_(ip_address,
+               port,
+               username,
+               password,
+               ptrContext),
+  mastership_manager_(rws_client_)
   {}
 
   /**
@@ -278,6 +524,18 @@ public:
    */
   RuntimeInfo collectRuntimeInfo();
 
+  /**
+   * \brief A method for collecting a snapshot of the robot controller's state.
+   *
+   * The runtime information, and the requested mechanical unit targets, IO signals and RAPID symbols, are sampled
+   * concurrently via the client pool, to keep the sampling window (i.e. the skew) as small as possible.
+   *
+   * \param request specifying what to sample (besides the runtime information).
+   *
+   * \return Snapshot containing the snapshot.
+   */
+  Snapshot collectSnapshot(const SnapshotRequest& request = SnapshotRequest());
+
   /**
    * \brief A method for collecting static information (at least during runtime) of the robot controller.
    *
@@ -299,7 +557,7 @@ public:
    *
    * \return std::string containing the IO signal's value (empty if not found).
    */
-  std::string getIOSignal(const std::string iosignal);
+  std::string getIOSignal(const std::string& iosignal);
 
   /**
    * \brief A method for retrieving the current jointtarget values of a mechanical unit.
@@ -309,7 +567,7 @@ public:
    *
    * \return bool indicating if the communication was successful or not. Note: No checks are made for "correct parsing".
    */
-  bool getMechanicalUnitJointTarget(const std::string mechunit, JointTarget* p_jointtarget);
+  bool getMechanicalUnitJointTarget(const std::string& mechunit, JointTarget* p_jointtarget);
 
   /**
    * \brief A method for retrieving the current robtarget values of a mechanical unit.
@@ -319,7 +577,7 @@ public:
    *
    * \return bool indicating if the communication was successful or not. Note: No checks are made for "correct parsing".
    */
-  bool getMechanicalUnitRobTarget(const std::string mechunit, RobTarget* p_robtarget);
+  bool getMechanicalUnitRobTarget(const std::string& mechunit, RobTarget* p_robtarget);
 
   /**
    * \brief A method for retrieving the data of a RAPID symbol in raw text format.
@@ -344,9 +602,9 @@ public:
    *
    * \return bool indicating if the communication was successful or not. Note: No checks are made for "correct parsing".
    */
-  bool getRAPIDSymbolData(const std::string task,
-                          const std::string module,
-                          const std::string name,
+  bool getRAPIDSymbolData(const std::string& task,
+                          const std::string& module,
+                          const std::string& name,
                           RAPIDSymbolDataAbstract* p_data);
 
   /**
@@ -358,15 +616,65 @@ public:
    *
    * \return bool indicating if the communication was successful or not. Note: No checks are made for "correct parsing".
    */
-  bool getRAPIDSymbolData(const std::string task,
-                          const RWSClient::RAPIDSymbolResource symbol,
+  bool getRAPIDSymbolData(const std::string& task,
+                          const RWSClient::RAPIDSymbolResource& symbol,
                           RAPIDSymbolDataAbstract* p_data);
+
+  /**
+   * \brief A method for retrieving the data of a RAPID symbol, and taking a snapshot of it (for later delta writes).
+   *
+   * \param task for the name of the RAPID task containing the RAPID symbol.
+   * \param module for the name of the RAPID module containing the RAPID symbol.
+   * \param name for the name of the RAPID symbol.
+   * \param p_data for storing the retrieved RAPID symbol data.
+   * \param p_snapshot for storing the snapshot of the retrieved data (left unchanged if the retrieval fails).
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool getRAPIDSymbolData(const std::string& task,
+                          const std::string& module,
+                          const std::string& name,
+                          RAPIDSymbolDataAbstract* p_data,
+                          RAPIDSnapshot* p_snapshot);
+
+  /**
+   * \brief A method for retrieving the data of a RAPID symbol, and taking a snapshot of it (for later delta writes).
+   *
+   * \param task for the name of the RAPID task containing the RAPID symbol.
+   * \param symbol indicating the RAPID symbol resource (name and module).
+   * \param p_data for storing the retrieved RAPID symbol data.
+   * \param p_snapshot for storing the snapshot of the retrieved data (left unchanged if the retrieval fails).
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool getRAPIDSymbolData(const std::string& task,
+                          const RWSClient::RAPIDSymbolResource& symbol,
+                          RAPIDSymbolDataAbstract* p_data,
+                          RAPIDSnapshot* p_snapshot);
+
+  /**
+   * \brief A method for retrieving the data of a RAPID symbol, of any type (e.g. a user-defined record).
+   *
+   * The value is parsed with the symbol's type descriptor, which is retrieved from the robot controller the first
+   * time the type is used (and then cached).
+   *
+   * \param task for the name of the RAPID task containing the RAPID symbol.
+   * \param module for the name of the RAPID module containing the RAPID symbol.
+   * \param name for the name of the RAPID symbol.
+   * \param p_value for storing the retrieved RAPID value.
+   *
+   * \return bool indicating if the value was retrieved and parsed.
+   */
+  bool getRAPIDSymbolData(const std::string& task,
+                          const std::string& module,
+                          const std::string& name,
+                          RAPIDValue* p_value);
   /**
    * \brief A method for retrieving information about the RAPID modules of a RAPID task defined in the robot controller.
    *
    * \return std::vector<RAPIDModuleInfo> containing the RAPID modules information.
    */
-  std::vector<RAPIDModuleInfo> getRAPIDModulesInfo(const std::string task);
+  std::vector<RAPIDModuleInfo> getRAPIDModulesInfo(const std::string& task);
 
   /**
    * \brief A method for retrieving information about the RAPID tasks defined in the robot controller.
@@ -411,9 +719,43 @@ public:
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool setIOSignal(const std::string iosignal, const std::string value);
+  bool setIOSignal(const std::string& iosignal, const std::string& value);
+
+  /**
+   * \brief A method for setting the values of several IO signals, over the interface's pool of clients.
+   *
+   * Multiple writes to the same signal are coalesced, so only the last one is sent. If requested, writes are skipped
+   * when the value equals the signal's last known value. The last known values are updated by successful reads and
+   * writes (via this interface), and by IO signal subscription events received via "waitForSubscriptionEvent(...)".
+   *
+   * Note: The last known values are only trustworthy if no other party writes the signals, or if the signals are
+   *       subscribed to. Use "clearIOSignalStates()" to forget them.
+   *
+   * \param writes for the requested writes.
+   * \param skip_unchanged indicating if writes of unchanged values should be skipped.
+   *
+   * \return std::vector<IOSignalWriteResult> containing the outcome of each requested write (in the same order).
+   */
+  std::vector<IOSignalWriteResult> setIOSignals(const std::vector<IOSignalWrite>& writes,
+                                                const bool skip_unchanged = true);
 
-  bool pulseIOSignal(const std::string iosignal, const int lenght);
+  /**
+   * \brief A method for forgetting all last known IO signal values.
+   */
+  void clearIOSignalStates();
+
+  /**
+   * \brief A method for pulsing an IO signal. The calling thread is blocked for the duration of the pulse.
+   *
+   * Note: The pulse width seen by the robot controller drifts with the request latency. Use a RWSIOScheduler
+   *       (with the interface's client pool) for asynchronous, latency compensated, pulses.
+   *
+   * \param iosignal for the name of the IO signal.
+   * \param lenght for the pulse width [microseconds].
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool pulseIOSignal(const std::string& iosignal, const int lenght);
 
     /**
    * \brief A method for setting the data of a RAPID symbol via raw text format.
@@ -455,9 +797,9 @@ public:
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool setRAPIDSymbolData(const std::string task,
-                          const std::string module,
-                          const std::string name,
+  bool setRAPIDSymbolData(const std::string& task,
+                          const std::string& module,
+                          const std::string& name,
                           RAPIDSymbolDataAbstract& data);
 
   /**
@@ -469,10 +811,123 @@ public:
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool setRAPIDSymbolData(const std::string task,
-                          const RWSClient::RAPIDSymbolResource symbol,
+  bool setRAPIDSymbolData(const std::string& task,
+                          const RWSClient::RAPIDSymbolResource& symbol,
                           RAPIDSymbolDataAbstract& data);
 
+  /**
+   * \brief A method for writing only the changes of a RAPID symbol's data, since its snapshot was taken.
+   *
+   * Nothing is written if nothing has changed, and only the changed components are written if they can be addressed
+   * on their own (see RWSClient::setRAPIDSymbolData). This also leaves concurrent changes of the other components, in
+   * the robot controller, untouched. The snapshot is updated after a successful write.
+   *
+   * \param task for the name of the RAPID task containing the RAPID symbol.
+   * \param module for the name of the RAPID module containing the RAPID symbol.
+   * \param name for the name of the RAPID symbol.
+   * \param data containing the RAPID symbol's new data.
+   * \param p_snapshot for the snapshot of the last read or written data (the complete data is written if null or empty).
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool setRAPIDSymbolData(const std::string& task,
+                          const std::string& module,
+                          const std::string& name,
+                          RAPIDSymbolDataAbstract& data,
+                          RAPIDSnapshot* p_snapshot);
+
+  /**
+   * \brief A method for writing only the changes of a RAPID symbol's data, since its snapshot was taken.
+   *
+   * \param task for the name of the RAPID task containing the RAPID symbol.
+   * \param symbol indicating the RAPID symbol resource (name and module).
+   * \param data containing the RAPID symbol's new data.
+   * \param p_snapshot for the snapshot of the last read or written data (the complete data is written if null or empty).
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool setRAPIDSymbolData(const std::string& task,
+                          const RWSClient::RAPIDSymbolResource& symbol,
+                          RAPIDSymbolDataAbstract& data,
+                          RAPIDSnapshot* p_snapshot);
+
+  /**
+   * \brief A method for reading the data of several RAPID symbols, concurrently via the client pool.
+   *
+   * \param reads for the RAPID symbols to read, and the data objects to parse the values into.
+   *
+   * \return std::vector<RAPIDSymbolAccessResult> containing the outcome of each read (in the same order).
+   */
+  std::vector<RAPIDSymbolAccessResult> getRAPIDSymbolsData(const std::vector<RAPIDSymbolAccess>& reads);
+
+  /**
+   * \brief A method for writing the data of several RAPID symbols.
+   *
+   * The writes are made in order via the interface's own RWS session, since that is the session which holds any
+   * mastership. For all-or-nothing batches, the current values are first read (concurrently via the client pool), the
+   * batch is aborted at the first failed write, and the already made writes are then restored to their old values.
+   *
+   * \param writes for the RAPID symbols to write, and the data objects holding the new values.
+   * \param all_or_nothing indicating if the batch should be rolled back if any write fails.
+   *
+   * \return std::vector<RAPIDSymbolAccessResult> containing the outcome of each write (in the same order).
+   */
+  std::vector<RAPIDSymbolAccessResult> setRAPIDSymbolsData(const std::vector<RAPIDSymbolAccess>& writes,
+                                                           const bool all_or_nothing = false);
+
+  /**
+   * \brief A method for reading the data of a one-dimensional RAPID array, or a range of its elements.
+   *
+   * The complete array is read with a single request. A range of up to max_element_reads elements is read element by
+   * element (i.e. "name{index}"), with the elements split into chunks that are read concurrently via the client pool.
+   * A larger range is sliced out of the complete array, which is then read with a single request. The array grows to
+   * hold the range, if needed (the added elements outside the range are unmodified, and not loaded), and the read
+   * elements are marked as unmodified and loaded. The array is left unchanged if any element can't be read or parsed.
+   *
+   * \param task for the name of the RAPID task containing the RAPID symbol.
+   * \param module for the name of the RAPID module containing the RAPID symbol.
+   * \param name for the name of the RAPID symbol.
+   * \param p_array for storing the read elements.
+   * \param first for the (zero-based) index of the first element to read.
+   * \param count for the number of elements to read (zero reads all elements from first, or the complete array).
+   * \param max_element_reads for the maximum number of elements in a range to read element by element.
+   * \param p_error_message for storing a description of a failure, e.g. which element failed (optional).
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool getRAPIDArrayData(const std::string& task,
+                         const std::string& module,
+                         const std::string& name,
+                         RAPIDArrayAbstract* p_array,
+                         const size_t first = 0,
+                         const size_t count = 0,
+                         const size_t max_element_reads = 16,
+                         std::string* p_error_message = 0);
+
+  /**
+   * \brief A method for writing the modified elements of a one-dimensional RAPID array.
+   *
+   * Nothing is written if no element has been modified. Up to max_element_writes modified elements are written element
+   * by element (which leaves the other elements untouched in the robot controller), otherwise the complete array is
+   * written with a single request. The complete array is never written while any element hasn't been loaded (see
+   * RAPIDArrayAbstract::isLoaded), since that would overwrite the robot controller's values with default values, i.e.
+   * the modified elements are then always written element by element. The written elements are marked as unmodified.
+   * Use RAPIDArrayAbstract::markModified to write a specific range.
+   *
+   * \param task for the name of the RAPID task containing the RAPID symbol.
+   * \param module for the name of the RAPID module containing the RAPID symbol.
+   * \param name for the name of the RAPID symbol.
+   * \param array containing the RAPID array's elements.
+   * \param max_element_writes for the maximum number of modified elements to write element by element.
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool setRAPIDArrayData(const std::string& task,
+                         const std::string& module,
+                         const std::string& name,
+                         RAPIDArrayAbstract& array,
+                         const size_t max_element_writes = 16);
+
   /**
    * \brief A method for starting RAPID execution in the robot controller.
    *
@@ -513,14 +968,14 @@ public:
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool setLeadThroughOn(const std::string mechUnit);
+  bool setLeadThroughOn(const std::string& mechUnit);
 
    /**
    * \brief A method for turning off the robot compliance lead through.
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool setLeadThroughOff(const std::string mechUnit);
+  bool setLeadThroughOff(const std::string& mechUnit);
 
   /**
    * \brief A method for retrieving a file from the robot controller.
@@ -532,7 +987,7 @@ public:
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool getFile(const RWSClient::FileResource resource, std::string* p_file_content);
+  bool getFile(const RWSClient::FileResource& resource, std::string* p_file_content);
 
   /**
    * \brief A method for uploading a file to the robot controller.
@@ -542,7 +997,17 @@ public:
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool uploadFile(const RWSClient::FileResource resource, const std::string file_content);
+  bool uploadFile(const RWSClient::FileResource& resource, const std::string& file_content);
+
+  /**
+   * \brief A method for uploading a file to the robot controller, without copying the file's content.
+   *
+   * \param resource specifying the file's directory and name.
+   * \param file_content for the file's content (moved into the request).
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool uploadFile(const RWSClient::FileResource& resource, std::string&& file_content);
 
   /**
    * \brief A method for deleting a file from the robot controller.
@@ -551,7 +1016,7 @@ public:
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool deleteFile(const RWSClient::FileResource resource);
+  bool deleteFile(const RWSClient::FileResource& resource);
 
   /**
    * \brief A method for starting for a subscription.
@@ -560,7 +1025,7 @@ public:
    *
    * \return bool indicating if the communication was successful or not.
    */
-  bool startSubscription(const RWSClient::SubscriptionResources resources);
+  bool startSubscription(const RWSClient::SubscriptionResources& resources);
 
   /**
    * \brief A method for waiting for a subscription event (use if the event content is irrelevant).
@@ -614,6 +1079,7 @@ public:
   /**
    * \brief Method for request a mastership on rw domain.
    *
+   * Note: Prefer acquireMastership(), which shares the mastership between call sites and threads.
    */
   bool requestMasterShip();
 
@@ -623,6 +1089,118 @@ public:
    */
   bool releaseMasterShip();
 
+  /**
+   * \brief A method for preloading the RAPID symbol metadata cache (used by typed RAPID reads).
+   *
+   * \param resources specifying the RAPID resources.
+   *
+   * \return bool indicating if the metadata of all the symbols were retrieved.
+   */
+  bool preloadRAPIDSymbolMetadata(const std::vector<RWSClient::RAPIDResource>& resources)
+  {
+    return rws_client_.preloadRAPIDSymbolMetadata(resources);
+  }
+
+  /**
+   * \brief A method for invalidating the RAPID symbol metadata cache, e.g. after RAPID modules have been (un)loaded.
+   */
+  void invalidateRAPIDSymbolMetadata()
+  {
+    rws_client_.invalidateRAPIDSymbolMetadata();
+  }
+
+  /**
+   * \brief A method for invalidating the cached responses of static resources (e.g. RAPID tasks and modules).
+   *
+   * Note: This should be called after the robot controller has been restarted, or RAPID modules (un)loaded.
+   */
+  void invalidateResponseCache()
+  {
+    rws_client_.invalidateResponseCache();
+  }
+
+  /**
+   * \brief A method for retrieving statistics about the response cache.
+   *
+   * \return RWSClient::ResponseCacheStatistics containing the statistics.
+   */
+  RWSClient::ResponseCacheStatistics getResponseCacheStatistics()
+  {
+    return rws_client_.getResponseCacheStatistics();
+  }
+
+  /**
+   * \brief A method for enabling the flight recorder, i.e. recording of all communication into a memory-mapped file.
+   *
+   * Note: Only the main RWS session is recorded, not the pooled sessions.
+   *
+   * \param path for the recording file's path (an existing recording with the same capacity is appended to).
+   * \param capacity for the number of records kept in the file.
+   *
+   * \return bool indicating if the recording file could be opened or not.
+   */
+  bool enableFlightRecorder(const std::string& path,
+                            const size_t capacity = RWSClient::DEFAULT_FLIGHT_RECORDER_CAPACITY)
+  {
+    return rws_client_.enableFlightRecorder(path, capacity);
+  }
+
+  /**
+   * \brief A method for disabling the flight recorder.
+   */
+  void disableFlightRecorder()
+  {
+    rws_client_.disableFlightRecorder();
+  }
+
+  /**
+   * \brief A method for retrieving the per-endpoint request statistics (latency histograms and phase timings).
+   *
+   * Note: Only the main RWS session's requests are included, not the pooled sessions'.
+   *
+   * \return std::vector<RWSEndpointStatistics::Snapshot> containing a snapshot for each requested endpoint.
+   */
+  std::vector<RWSEndpointStatistics::Snapshot> getEndpointStatistics() const
+  {
+    return rws_client_.getEndpointStatistics();
+  }
+
+  /**
+   * \brief A method for registering the interface's RWS session, and its client pool, in a metrics registry.
+   *
+   * Note: The interface must outlive the registration (or be removed from the registry before it is destroyed).
+   *
+   * \param metrics for the metrics registry.
+   * \param name for the name to register the interface under (used as the "client" label).
+   */
+  void registerMetrics(RWSMetrics& metrics, const std::string& name)
+  {
+    metrics.add(name, rws_client_, &client_pool_);
+  }
+
+  /**
+   * \brief A method for acquiring a scoped mastership lease (on the edit domain).
+   *
+   * The mastership is held while any lease is alive, and released after an idle period when the last lease is gone.
+   * While leases are alive, RAPID writes that fail are retried once after the mastership has been requested again.
+   *
+   * \return RWSMastershipManager::Lease for the lease. It should be checked with isHeld().
+   */
+  RWSMastershipManager::Lease acquireMastership()
+  {
+    return mastership_manager_.acquire();
+  }
+
+  /**
+   * \brief A method for retrieving the mastership manager.
+   *
+   * \return RWSMastershipManager& for the mastership manager.
+   */
+  RWSMastershipManager& getMastershipManager()
+  {
+    return mastership_manager_;
+  }
+
   /**
    * \brief A method for retrieving the internal log as a text string.
    *
@@ -651,6 +1229,16 @@ public:
     rws_client_.setHTTPTimeout(timeout);
   }
 
+  /**
+   * \brief A method for retrieving the pool of clients, used for concurrent requests.
+   *
+   * \return RWSClientPool& for the pool of clients.
+   */
+  RWSClientPool& getClientPool()
+  {
+    return client_pool_;
+  }
+
 protected:
   /**
    * \brief A method for comparing a single text content (from a XML document node) with a specific string value.
@@ -669,6 +1257,83 @@ protected:
    * \brief The RWS client used to communicate with the robot controller.
    */
   RWSClient rws_client_;
+
+  /**
+   * \brief A pool of RWS clients, used for concurrent requests.
+   */
+  RWSClientPool client_pool_;
+
+  /**
+   * \brief Manager for sharing the mastership of the RWS client's session.
+   */
+  RWSMastershipManager mastership_manager_;
+
+private:
+  /**
+   * \brief A method for executing a write, which requires mastership.
+   *
+   * If the write is rejected for missing mastership (i.e. "403 Forbidden") while mastership leases are alive, then the
+   * mastership is assumed to have been lost on the controller side. It is then requested again, and the write is
+   * retried once. Other failures (e.g. invalid values or unknown resources) are not retried.
+   *
+   * \param write for the write to execute.
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool writeWithMastership(const std::function<RWSClient::RWSResult()>& write);
+
+  /**
+   * \brief A method for parsing a mechanical unit's joint target from a RWS result.
+   *
+   * \param rws_result for the RWS result of the joint target request.
+   * \param p_jointtarget for storing the parsed joint target.
+   */
+  void parseMechanicalUnitJointTarget(const RWSClient::RWSResult& rws_result, JointTarget* p_jointtarget);
+
+  /**
+   * \brief A method for parsing a mechanical unit's robot target from a RWS result.
+   *
+   * \param rws_result for the RWS result of the robot target request.
+   * \param p_robtarget for storing the parsed robot target.
+   */
+  void parseMechanicalUnitRobTarget(const RWSClient::RWSResult& rws_result, RobTarget* p_robtarget);
+
+  /**
+   * \brief A method for retrieving the key, under which an IO signal's last known value is stored.
+   *
+   * Signals can be named with or without their network and device (e.g. "Local/DRV_1/DO1" or "DO1"), so the key is
+   * the signal's name alone (which is unique in a robot controller).
+   *
+   * \param iosignal for the name (or path) of the IO signal.
+   *
+   * \return std::string containing the key.
+   */
+  static std::string getIOSignalStateKey(const std::string& iosignal);
+
+  /**
+   * \brief A method for storing the last known value of an IO signal.
+   *
+   * \param iosignal for the name (or path) of the IO signal.
+   * \param value for the IO signal's value.
+   */
+  void storeIOSignalState(const std::string& iosignal, const std::string& value);
+
+  /**
+   * \brief A method for storing the IO signal values contained in a subscription event.
+   *
+   * \param rws_result for containing the subscription event.
+   */
+  void storeIOSignalStates(const RWSClient::RWSResult& rws_result);
+
+  /**
+   * \brief A mutex for protecting the last known IO signal values.
+   */
+  std::mutex iosignal_states_mutex_;
+
+  /**
+   * \brief The last known IO signal values.
+   */
+  std::map<std::string, std::string> iosignal_states_;
 };
 
 } // end namespace rws
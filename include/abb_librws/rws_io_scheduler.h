@@ -0,0 +1,432 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A timer-wheel scheduler for timed and pulsed IO signal writes.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_IO_SCHEDULER_H
+#define RWS_IO_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "rws_client_pool.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for scheduling timed IO signal actions (e.g. pulses, delayed sets and periodic toggles).
+ *
+ * The actions are kept in a timer wheel, which is serviced by a dedicated thread. That thread only hands the due
+ * actions over to a set of worker threads (one per pooled client), so a slow request on one signal doesn't delay the
+ * edges of other signals. Actions on the same signal are executed one at a time, in the order they became due. The
+ * requests are made with clients leased from a client pool, so the caller's thread (and client) is never blocked.
+ *
+ * The falling edge of a pulse is scheduled from the measured latency of the rising edge request, and the expected
+ * latency of the falling edge request, so that the pulse width seen by the robot controller matches the requested
+ * width as well as possible. The estimated actual width is reported for each pulse.
+ */
+class RWSIOScheduler
+{
+public:
+  /**
+   * \brief A struct for containing a report about an executed pulse.
+   */
+  struct PulseReport
+  {
+    /**
+     * \brief A default constructor.
+     */
+    PulseReport() : requested_width(0), actual_width(0), rise_latency(0), fall_latency(0), success(false) {}
+
+    /**
+     * \brief The IO signal's name.
+     */
+    std::string iosignal;
+
+    /**
+     * \brief The requested pulse width [microseconds].
+     */
+    Poco::Int64 requested_width;
+
+    /**
+     * \brief The estimated actual pulse width [microseconds], i.e. from the middle of the rising edge request to the
+     *        middle of the falling edge request.
+     */
+    Poco::Int64 actual_width;
+
+    /**
+     * \brief The measured latency of the rising edge request [microseconds].
+     */
+    Poco::Int64 rise_latency;
+
+    /**
+     * \brief The measured latency of the falling edge request [microseconds].
+     */
+    Poco::Int64 fall_latency;
+
+    /**
+     * \brief Indicator for if both edges were successfully written.
+     */
+    bool success;
+  };
+
+  /**
+   * \brief Typedef for a callback, which is called (on one of the scheduler's worker threads) after each pulse.
+   */
+  typedef std::function<void(const PulseReport&)> PulseCallback;
+
+  /**
+   * \brief A constructor.
+   *
+   * \param client_pool for the pool of clients used for the requests.
+   * \param tick for the resolution of the timer wheel [microseconds].
+   */
+  RWSIOScheduler(RWSClientPool& client_pool, const Poco::Int64 tick = DEFAULT_TICK);
+
+  /**
+   * \brief A destructor.
+   *
+   * Pulses that have risen are ended right away (i.e. their falling edges are set without waiting for the rest of
+   * the pulse width), so that no output is left high. Other pending actions are discarded.
+   */
+  ~RWSIOScheduler();
+
+  /**
+   * \brief A method for scheduling a pulse (i.e. set to high, and then back to low).
+   *
+   * \param iosignal for the IO signal's name.
+   * \param width for the pulse width [microseconds].
+   * \param delay for the delay until the pulse starts [microseconds].
+   *
+   * \return Poco::UInt64 containing an id for the scheduled action.
+   */
+  Poco::UInt64 pulse(const std::string& iosignal, const Poco::Int64 width, const Poco::Int64 delay = 0);
+
+  /**
+   * \brief A method for scheduling a delayed set of an IO signal.
+   *
+   * \param iosignal for the IO signal's name.
+   * \param value for the IO signal's new value.
+   * \param delay for the delay until the value is set [microseconds].
+   *
+   * \return Poco::UInt64 containing an id for the scheduled action.
+   */
+  Poco::UInt64 setDelayed(const std::string& iosignal, const std::string& value, const Poco::Int64 delay);
+
+  /**
+   * \brief A method for scheduling periodic toggles of a digital IO signal (starting with setting it to high).
+   *
+   * \param iosignal for the IO signal's name.
+   * \param period for the time between two toggles [microseconds].
+   * \param count for the number of toggles. Zero means until cancelled.
+   *
+   * \return Poco::UInt64 containing an id for the scheduled action.
+   */
+  Poco::UInt64 togglePeriodically(const std::string& iosignal, const Poco::Int64 period, const unsigned int count = 0);
+
+  /**
+   * \brief A method for cancelling a scheduled action. An already started pulse is still completed, and ids of
+   *        finished (or unknown) actions are ignored.
+   *
+   * \param id for the action's id.
+   */
+  void cancel(const Poco::UInt64 id);
+
+  /**
+   * \brief A method for setting a callback, which is called after each pulse.
+   *
+   * \param callback for the callback.
+   */
+  void setPulseCallback(const PulseCallback& callback);
+
+  /**
+   * \brief A method for retrieving (and clearing) the reports of the pulses executed since the last call.
+   *
+   * \return std::vector<PulseReport> containing the reports.
+   */
+  std::vector<PulseReport> getPulseReports();
+
+  /**
+   * \brief Static constant for the default resolution of the timer wheel [microseconds].
+   */
+  static const Poco::Int64 DEFAULT_TICK = 1000;
+
+private:
+  /**
+   * \brief Typedef for the clock used by the scheduler.
+   */
+  typedef std::chrono::steady_clock Clock;
+
+  /**
+   * \brief A struct for representing a scheduled action.
+   */
+  struct Action
+  {
+    /**
+     * \brief An enum for the different action types.
+     */
+    enum Type
+    {
+      SET,        ///< Set a value.
+      PULSE_RISE, ///< Set the rising edge of a pulse.
+      PULSE_FALL, ///< Set the falling edge of a pulse.
+      TOGGLE      ///< Periodic toggle.
+    };
+
+    /**
+     * \brief The action's id.
+     */
+    Poco::UInt64 id;
+
+    /**
+     * \brief The action's type.
+     */
+    Type type;
+
+    /**
+     * \brief The IO signal's name.
+     */
+    std::string iosignal;
+
+    /**
+     * \brief The value to set.
+     */
+    std::string value;
+
+    /**
+     * \brief The pulse width or toggle period [microseconds].
+     */
+    Poco::Int64 duration;
+
+    /**
+     * \brief The remaining number of toggles (zero means until cancelled).
+     */
+    unsigned int remaining;
+
+    /**
+     * \brief The timer wheel tick at which the action is due.
+     */
+    Poco::UInt64 due_tick;
+
+    /**
+     * \brief The start of the rising edge request (for pulses).
+     */
+    Clock::time_point rise_start;
+
+    /**
+     * \brief The measured latency of the rising edge request [microseconds] (for pulses).
+     */
+    Poco::Int64 rise_latency;
+  };
+
+  /**
+   * \brief A method for inserting an action into the timer wheel.
+   *
+   * \param action for the action to insert.
+   * \param due for the time point when the action is due.
+   */
+  void schedule(Action action, const Clock::time_point due);
+
+  /**
+   * \brief A method for creating a new action and inserting it into the timer wheel.
+   *
+   * \param type for the action's type.
+   * \param iosignal for the IO signal's name.
+   * \param value for the value to set.
+   * \param duration for the pulse width or toggle period [microseconds].
+   * \param remaining for the number of toggles.
+   * \param delay for the delay until the action is due [microseconds].
+   *
+   * \return Poco::UInt64 containing the action's id.
+   */
+  Poco::UInt64 add(const Action::Type type,
+                   const std::string& iosignal,
+                   const std::string& value,
+                   const Poco::Int64 duration,
+                   const unsigned int remaining,
+                   const Poco::Int64 delay);
+
+  /**
+   * \brief A method for executing an action, which is due.
+   *
+   * \param action for the action to execute.
+   */
+  void execute(Action& action);
+
+  /**
+   * \brief A method for setting an IO signal, while measuring the request latency.
+   *
+   * \param iosignal for the IO signal's name.
+   * \param value for the IO signal's new value.
+   * \param p_latency for storing the measured latency [microseconds].
+   *
+   * \return bool indicating if the communication was successful or not.
+   */
+  bool timedSet(const std::string& iosignal, const std::string& value, Poco::Int64* p_latency);
+
+  /**
+   * \brief The scheduler thread's main loop, which hands the due actions over to the worker threads.
+   */
+  void run();
+
+  /**
+   * \brief A worker thread's main loop, which executes the due actions.
+   */
+  void work();
+
+  /**
+   * \brief Static constant for the number of slots in the timer wheel.
+   */
+  static const size_t WHEEL_SIZE = 512;
+
+  /**
+   * \brief The pool of clients used for the requests.
+   */
+  RWSClientPool& client_pool_;
+
+  /**
+   * \brief The resolution of the timer wheel.
+   */
+  const Clock::duration tick_;
+
+  /**
+   * \brief The time point of the timer wheel's first tick.
+   */
+  const Clock::time_point start_;
+
+  /**
+   * \brief A mutex for protecting the scheduler's data.
+   */
+  std::mutex mutex_;
+
+  /**
+   * \brief Condition for waking up the scheduler thread.
+   */
+  std::condition_variable wake_up_;
+
+  /**
+   * \brief The timer wheel's slots.
+   */
+  std::vector<std::list<Action>> wheel_;
+
+  /**
+   * \brief The number of actions in the timer wheel.
+   */
+  size_t number_of_actions_;
+
+  /**
+   * \brief The last processed timer wheel tick.
+   */
+  Poco::UInt64 current_tick_;
+
+  /**
+   * \brief The id to give the next action.
+   */
+  Poco::UInt64 next_id_;
+
+  /**
+   * \brief The due actions, which are waiting for a worker thread.
+   */
+  std::deque<Action> ready_;
+
+  /**
+   * \brief The IO signals, which have an action being executed by a worker thread.
+   */
+  std::set<std::string> busy_iosignals_;
+
+  /**
+   * \brief Condition for waking up the worker threads.
+   */
+  std::condition_variable work_available_;
+
+  /**
+   * \brief The ids of the scheduled actions, which haven't finished yet.
+   */
+  std::set<Poco::UInt64> pending_;
+
+  /**
+   * \brief The ids of cancelled actions (a subset of the pending actions).
+   */
+  std::set<Poco::UInt64> cancelled_;
+
+  /**
+   * \brief Smoothed latency of IO signal set requests [microseconds], used for compensating pulse widths.
+   */
+  Poco::Int64 expected_latency_;
+
+  /**
+   * \brief The callback called after each pulse.
+   */
+  PulseCallback pulse_callback_;
+
+  /**
+   * \brief Reports of the pulses executed since they were last retrieved.
+   */
+  std::vector<PulseReport> pulse_reports_;
+
+  /**
+   * \brief Flag indicating if the scheduler is shutting down.
+   */
+  bool stop_;
+
+  /**
+   * \brief The scheduler thread.
+   */
+  std::thread thread_;
+
+  /**
+   * \brief The worker threads.
+   */
+  std::vector<std::thread> workers_;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
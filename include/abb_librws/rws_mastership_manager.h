@@ -0,0 +1,285 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Sharing of the mastership (of the edit domain) between several users of the same RWS session.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_MASTERSHIP_MANAGER_H
+#define RWS_MASTERSHIP_MANAGER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "rws_client.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for sharing the mastership (of the edit domain) between several users of the same RWS session.
+ *
+ * Mastership is requested when the first lease is acquired, and held for as long as any lease is alive. When the
+ * last lease is released, the mastership is kept for an idle period (so that bursts of scoped writes don't pay a
+ * request/release round trip each), after which it is released by a background thread.
+ *
+ * If the mastership is lost on the controller side (e.g. taken by the FlexPendant), then it is requested again the
+ * next time a lease is acquired or refreshed.
+ */
+class RWSMastershipManager
+{
+public:
+  /**
+   * \brief A class for a scoped mastership lease. Copies share the underlying reference.
+   */
+  class Lease
+  {
+  public:
+    /**
+     * \brief A default constructor, for an empty lease.
+     */
+    Lease() : p_manager_(0), held_(false) {}
+
+    /**
+     * \brief A copy constructor.
+     *
+     * \param other for the lease to copy.
+     */
+    Lease(const Lease& other);
+
+    /**
+     * \brief A move constructor.
+     *
+     * \param other for the lease to move from.
+     */
+    Lease(Lease&& other);
+
+    /**
+     * \brief An assignment operator.
+     *
+     * \param other for the lease to assign from.
+     *
+     * \return Lease& reference to the lease.
+     */
+    Lease& operator=(Lease other);
+
+    /**
+     * \brief A destructor, which releases the lease's reference.
+     */
+    ~Lease();
+
+    /**
+     * \brief A method for checking if the mastership was held when the lease was acquired (or last refreshed).
+     *
+     * \return bool indicating if the mastership is held.
+     */
+    bool isHeld() const { return held_; }
+
+    /**
+     * \brief A method for requesting the mastership again, e.g. after a write failed because it was lost.
+     *
+     * \return bool indicating if the mastership is held.
+     */
+    bool refresh();
+
+    /**
+     * \brief A method for releasing the lease's reference before it goes out of scope.
+     */
+    void release();
+
+  private:
+    friend class RWSMastershipManager;
+
+    /**
+     * \brief A constructor, used by the manager.
+     *
+     * \param p_manager for the manager that gave out the lease.
+     * \param held for indicating if the mastership was acquired.
+     */
+    Lease(RWSMastershipManager* p_manager, const bool held) : p_manager_(p_manager), held_(held) {}
+
+    /**
+     * \brief The manager that gave out the lease.
+     */
+    RWSMastershipManager* p_manager_;
+
+    /**
+     * \brief Flag indicating if the mastership was acquired.
+     */
+    bool held_;
+  };
+
+  /**
+   * \brief A constructor.
+   *
+   * \param client for the client (i.e. RWS session) that should hold the mastership.
+   * \param idle_timeout for the time the mastership is kept after the last lease is released [microseconds].
+   */
+  RWSMastershipManager(RWSClient& client, const Poco::Int64 idle_timeout = DEFAULT_IDLE_TIMEOUT);
+
+  /**
+   * \brief A destructor. A held mastership is released.
+   */
+  ~RWSMastershipManager();
+
+  /**
+   * \brief A method for acquiring a mastership lease. The mastership is requested if it is not already held.
+   *
+   * \return Lease for the lease. It should be checked with Lease::isHeld().
+   */
+  Lease acquire();
+
+  /**
+   * \brief A method for notifying the manager that the mastership has been lost on the controller side.
+   */
+  void notifyLost();
+
+  /**
+   * \brief A method for checking if the manager currently holds the mastership.
+   *
+   * \return bool indicating if the mastership is held.
+   */
+  bool isHeld();
+
+  /**
+   * \brief A method for checking if there are any active leases.
+   *
+   * \return bool indicating if there are any active leases.
+   */
+  bool hasLeases();
+
+  /**
+   * \brief A method for setting the idle timeout.
+   *
+   * \param idle_timeout for the time the mastership is kept after the last lease is released [microseconds].
+   */
+  void setIdleTimeout(const Poco::Int64 idle_timeout);
+
+  /**
+   * \brief Static constant for the default idle timeout [microseconds].
+   */
+  static const Poco::Int64 DEFAULT_IDLE_TIMEOUT = 500000;
+
+private:
+  /**
+   * \brief Typedef for the clock used by the manager.
+   */
+  typedef std::chrono::steady_clock Clock;
+
+  /**
+   * \brief A method for adding a lease reference.
+   */
+  void retain();
+
+  /**
+   * \brief A method for removing a lease reference.
+   */
+  void unretain();
+
+  /**
+   * \brief A method for making sure that the mastership is held, requesting it if needed.
+   *
+   * \param force for forcing a new request (e.g. after the mastership was lost).
+   *
+   * \return bool indicating if the mastership is held.
+   */
+  bool ensureHeld(const bool force);
+
+  /**
+   * \brief The background thread's main loop, which releases the mastership after the idle timeout.
+   */
+  void run();
+
+  /**
+   * \brief The client (i.e. RWS session) holding the mastership.
+   */
+  RWSClient& client_;
+
+  /**
+   * \brief A mutex for protecting the manager's data.
+   */
+  std::mutex mutex_;
+
+  /**
+   * \brief A mutex for serializing the mastership requests and releases.
+   */
+  std::mutex request_mutex_;
+
+  /**
+   * \brief Condition for waking up the background thread.
+   */
+  std::condition_variable wake_up_;
+
+  /**
+   * \brief The time the mastership is kept after the last lease is released.
+   */
+  Clock::duration idle_timeout_;
+
+  /**
+   * \brief The number of active leases.
+   */
+  unsigned int references_;
+
+  /**
+   * \brief Flag indicating if the mastership is held.
+   */
+  bool held_;
+
+  /**
+   * \brief The time point when the last lease was released.
+   */
+  Clock::time_point idle_since_;
+
+  /**
+   * \brief Flag indicating if the background thread should stop.
+   */
+  bool stop_;
+
+  /**
+   * \brief The background thread.
+   */
+  std::thread thread_;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
@@ -0,0 +1,222 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A registry of RWS client metrics, rendered as Prometheus text or JSON.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_METRICS_H
+#define RWS_METRICS_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rws_client.h"
+#include "rws_client_pool.h"
+
+namespace Poco
+{
+namespace Net
+{
+class HTTPServer;
+}
+}
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for a registry of RWS client metrics, e.g. for monitoring many clients on the same host.
+ *
+ * The metrics are kept by the clients themselves, in atomic counters (i.e. lock-free when communicating), and the
+ * registry only collects them when they are rendered. The metrics can be rendered as Prometheus text or as JSON,
+ * and optionally be served by an embedded HTTP server on localhost ("/metrics" and "/metrics.json").
+ *
+ * Note: Registered clients must be removed from the registry before they are destroyed.
+ */
+class RWSMetrics
+{
+public:
+  /**
+   * \brief A struct for a snapshot of a registered client's metrics.
+   */
+  struct ClientSnapshot
+  {
+    /**
+     * \brief The name the client was registered with.
+     */
+    std::string name;
+
+    /**
+     * \brief Statistics about the client's transport.
+     */
+    POCOClient::TransportStatistics transport;
+
+    /**
+     * \brief Statistics about the client's response cache.
+     */
+    RWSClient::ResponseCacheStatistics response_cache;
+
+    /**
+     * \brief Statistics about the client's requests, per endpoint.
+     */
+    std::vector<RWSEndpointStatistics::Snapshot> endpoints;
+
+    /**
+     * \brief Indicator for if the client has a client pool.
+     */
+    bool has_pool;
+
+    /**
+     * \brief Statistics about the client's pool (if it has one).
+     */
+    RWSClientPool::Statistics pool;
+  };
+
+  /**
+   * \brief A default constructor.
+   */
+  RWSMetrics();
+
+  /**
+   * \brief A destructor, which stops the embedded HTTP server (if it is running).
+   */
+  ~RWSMetrics();
+
+  /**
+   * \brief A method for registering a client.
+   *
+   * \param name for the client's name (used as the "client" label). A client registered with the same name is replaced.
+   * \param client for the client.
+   * \param p_pool for the client's pool (optional).
+   */
+  void add(const std::string& name, RWSClient& client, RWSClientPool* p_pool = 0);
+
+  /**
+   * \brief A method for removing a registered client.
+   *
+   * \param name for the client's name.
+   */
+  void remove(const std::string& name);
+
+  /**
+   * \brief A method for collecting snapshots of the registered clients' metrics.
+   *
+   * \return std::vector<ClientSnapshot> containing the snapshots, ordered by the clients' names.
+   */
+  std::vector<ClientSnapshot> collect();
+
+  /**
+   * \brief A method for rendering the metrics in the Prometheus text exposition format.
+   *
+   * \return std::string containing the rendered metrics.
+   */
+  std::string renderPrometheus();
+
+  /**
+   * \brief A method for rendering the metrics as JSON.
+   *
+   * \return std::string containing the rendered metrics.
+   */
+  std::string renderJSON();
+
+  /**
+   * \brief A method for starting an embedded HTTP server, which serves the metrics on localhost.
+   *
+   * \param port for the port to listen on.
+   *
+   * \return bool indicating if the server was started or not.
+   */
+  bool startServer(const unsigned short port = DEFAULT_PORT);
+
+  /**
+   * \brief A method for stopping the embedded HTTP server.
+   */
+  void stopServer();
+
+  /**
+   * \brief Static constant for the default port of the embedded HTTP server.
+   */
+  static const unsigned short DEFAULT_PORT = 9464;
+
+private:
+  /**
+   * \brief A struct for a registered client.
+   */
+  struct Source
+  {
+    /**
+     * \brief The client.
+     */
+    RWSClient* p_client;
+
+    /**
+     * \brief The client's pool (if any).
+     */
+    RWSClientPool* p_pool;
+  };
+
+  /**
+   * \brief A mutex for protecting the registered clients.
+   */
+  std::mutex mutex_;
+
+  /**
+   * \brief A mutex for protecting the embedded HTTP server (separate, since the server's requests collect metrics).
+   */
+  std::mutex server_mutex_;
+
+  /**
+   * \brief The registered clients, keyed by name.
+   */
+  std::map<std::string, Source> sources_;
+
+  /**
+   * \brief The embedded HTTP server (if it is running).
+   */
+  std::unique_ptr<Poco::Net::HTTPServer> p_server_;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
@@ -46,6 +46,10 @@
 #ifndef RWS_POCO_CLIENT_H
 #define RWS_POCO_CLIENT_H
 
+#include <atomic>
+#include <string>
+#include <string_view>
+
 #include "Poco/Mutex.h"
 #include "Poco/Net/HTTPClientSession.h"
 #include "Poco/Net/HTTPCredentials.h"
@@ -200,11 +204,88 @@ public:
      * \brief Container for POCO info.
      */
     POCOInfo poco_info;
+
+    /**
+     * \brief A struct for containing the timing of a communication's phases.
+     *
+     * The phases of the individual HTTP exchanges (i.e. connect, send, server and receive) are summed over all
+     * exchanges made for the request (e.g. including a retry after a server error, or an authentication).
+     */
+    struct Timing
+    {
+      /**
+       * \brief Monotonic time point when the communication started [microseconds since the steady clock's epoch].
+       */
+      Poco::Int64 start;
+
+      /**
+       * \brief Time spent waiting for the client's mutex (i.e. for other threads' communication) [microseconds].
+       */
+      Poco::Int64 lock_wait;
+
+      /**
+       * \brief Time spent establishing connections, including TLS handshakes [microseconds].
+       *
+       * Note: This is the time to send the request's header on a session that was not connected.
+       */
+      Poco::Int64 connect;
+
+      /**
+       * \brief Time spent sending requests [microseconds].
+       */
+      Poco::Int64 send;
+
+      /**
+       * \brief Time spent waiting for the responses' headers, i.e. the server time [microseconds].
+       */
+      Poco::Int64 server;
+
+      /**
+       * \brief Time spent receiving the responses' contents [microseconds].
+       */
+      Poco::Int64 receive;
+
+      /**
+       * \brief Time spent on authentication, i.e. on the exchange repeated with credentials [microseconds].
+       */
+      Poco::Int64 authentication;
+
+      /**
+       * \brief The number of HTTP exchanges made.
+       */
+      int exchanges;
+
+      /**
+       * \brief A default constructor.
+       */
+      Timing()
+      :
+      start(0),
+      lock_wait(0),
+      connect(0),
+      send(0),
+      server(0),
+      receive(0),
+      authentication(0),
+      exchanges(0)
+      {}
+    };
+
+    /**
+     * \brief Duration of the communication [microseconds], including the wait for the client's mutex (and for
+     *        WebSocket frames, the wait for the frame).
+     */
+    Poco::Int64 duration;
+
+    /**
+     * \brief Timing of the communication's phases.
+     */
+    Timing timing;
     
     /**
      * \brief A default constructor.
      */
-    POCOResult() : status(UNKNOWN) {};
+    POCOResult() : status(UNKNOWN), duration(0) {};
    
     /**
      * \brief A method for adding info from a HTTP request.
@@ -212,23 +293,23 @@ public:
      * \param request for the HTTP request.
      * \param request_content for the HTTP request's content.
      */
-    void addHTTPRequestInfo(const Poco::Net::HTTPRequest& request, const std::string request_content = "");
+    void addHTTPRequestInfo(const Poco::Net::HTTPRequest& request, const std::string& request_content = "");
     
     /**
      * \brief A method for adding info from a HTTP response.
      *
      * \param response for the HTTP response.
-     * \param response_content for the HTTP response's content.
+     * \param response_content for the HTTP response's content (moved into the result).
      */
-    void addHTTPResponseInfo(const Poco::Net::HTTPResponse& response, const std::string response_content = "");
+    void addHTTPResponseInfo(const Poco::Net::HTTPResponse& response, std::string response_content = std::string());
     
     /**
      * \brief A method for adding info from a received WebSocket frame.
      *
      * \param flags for the received WebSocket frame's flags.
-     * \param frame_content for the received WebSocket frame's content.
+     * \param frame_content for the received WebSocket frame's content (moved into the result).
      */
-    void addWebSocketFrameInfo(const int flags, const std::string frame_content);
+    void addWebSocketFrameInfo(const int flags, std::string frame_content);
 
     /**
      * \brief A method to map the general status to a std::string.
@@ -244,6 +325,24 @@ public:
      */
     std::string mapWebSocketOpcode() const;
 
+    /**
+     * \brief A method to map a general status to a std::string.
+     *
+     * \param status for the general status.
+     *
+     * \return std::string containing the mapped general status.
+     */
+    static std::string mapGeneralStatus(const GeneralStatus status);
+
+    /**
+     * \brief A method to map the opcode of WebSocket frame flags to a std::string.
+     *
+     * \param flags for the WebSocket frame's flags.
+     *
+     * \return std::string containing the mapped opcode.
+     */
+    static std::string mapWebSocketOpcode(const int flags);
+
     /**
      * \brief A method to construct a text representation of the result.
      *
@@ -263,10 +362,10 @@ public:
    * \param username for the username to the remote server's authentication process.
    * \param password for the password to the remote server's authentication process.
    */
-  POCOClient(const std::string ip_address,
+  POCOClient(const std::string& ip_address,
              const Poco::UInt16 port,
-             const std::string username,
-             const std::string password,
+             const std::string& username,
+             const std::string& password,
              const Poco::Net::Context::Ptr ptrContext)
   :
   http_client_session_(ip_address, port, ptrContext),
@@ -289,27 +388,27 @@ public:
    *
    * \return POCOResult containing the result.
    */
-  POCOResult httpGet(const std::string uri);
+  POCOResult httpGet(const std::string& uri);
   
   /**
    * \brief A method for sending a HTTP POST request.
    *
    * \param uri for the URI (path and query).
-   * \param content for the request's content.
+   * \param content for the request's content. Pass an rvalue to avoid copying large contents (e.g. file uploads).
    *
    * \return POCOResult containing the result.
    */
-  POCOResult httpPost(const std::string uri, const std::string content = "");
+  POCOResult httpPost(const std::string& uri, std::string content = std::string());
   
   /**
    * \brief A method for sending a HTTP PUT request.
    *
    * \param uri for the URI (path and query).
-   * \param content for the request's content.
+   * \param content for the request's content. Pass an rvalue to avoid copying large contents (e.g. file uploads).
    *
    * \return POCOResult containing the result.
    */
-  POCOResult httpPut(const std::string uri, const std::string content = "");
+  POCOResult httpPut(const std::string& uri, std::string content = std::string());
 
   /**
    * \brief A method for sending a HTTP DELETE request.
@@ -318,7 +417,7 @@ public:
    *
    * \return POCOResult containing the result.
    */
-  POCOResult httpDelete(const std::string uri);
+  POCOResult httpDelete(const std::string& uri);
   
   /**
    * \brief A method for setting the HTTP communication timeout.
@@ -351,7 +450,7 @@ public:
    *
    * \return POCOResult containing the result.
    */
-  POCOResult webSocketConnect(const std::string uri, const std::string protocol, const Poco::Int64 timeout);
+  POCOResult webSocketConnect(const std::string& uri, const std::string& protocol, const Poco::Int64 timeout);
   
   /**
    * \brief A method for receiving a WebSocket frame.
@@ -369,23 +468,96 @@ public:
    *
    * \return string containing the substring.
    */
-  std::string findSubstringContent(const std::string whole_string,
-                                   const std::string substring_start,
-                                   const std::string substring_end);
+  std::string findSubstringContent(std::string_view whole_string,
+                                   std::string_view substring_start,
+                                   std::string_view substring_end);
+
+  /**
+   * \brief A struct for containing statistics about the client's transport (e.g. for metrics).
+   */
+  struct TransportStatistics
+  {
+    /**
+     * \brief The number of HTTP exchanges (including retries and authentications).
+     */
+    Poco::UInt64 exchanges;
+
+    /**
+     * \brief The number of (re)connections, i.e. exchanges made on a session that was not connected.
+     */
+    Poco::UInt64 reconnects;
+
+    /**
+     * \brief The number of authentications, i.e. exchanges repeated with credentials.
+     */
+    Poco::UInt64 authentications;
+
+    /**
+     * \brief The number of requests repeated because of a server error.
+     */
+    Poco::UInt64 server_error_retries;
+
+    /**
+     * \brief The number of communications that failed (e.g. timeouts).
+     */
+    Poco::UInt64 failures;
+
+    /**
+     * \brief The number of WebSocket connections.
+     */
+    Poco::UInt64 websocket_connects;
+
+    /**
+     * \brief The number of received (non-ping) WebSocket frames.
+     */
+    Poco::UInt64 websocket_frames;
+  };
+
+  /**
+   * \brief A method for retrieving statistics about the client's transport.
+   *
+   * \return TransportStatistics containing the statistics.
+   */
+  TransportStatistics getTransportStatistics() const;
 
 private:
+  /**
+   * \brief An enum for the transport counters.
+   */
+  enum TransportCounter
+  {
+    EXCHANGES,
+    RECONNECTS,
+    AUTHENTICATIONS,
+    SERVER_ERROR_RETRIES,
+    FAILURES,
+    WEBSOCKET_CONNECTS,
+    WEBSOCKET_FRAMES,
+    NUMBER_OF_TRANSPORT_COUNTERS ///< Not a counter, only the number of counters.
+  };
+
+  /**
+   * \brief A method for incrementing a transport counter.
+   *
+   * \param counter for the counter to increment.
+   */
+  void count(const TransportCounter counter)
+  {
+    transport_counters_[counter].fetch_add(1, std::memory_order_relaxed);
+  }
+
   /**
    * \brief A method for making a HTTP request.
    *
    * \param method for the request's method.
    * \param uri for the URI (path and query).
-   * \param content for the request's content.
+   * \param content for the request's content (moved into the result, after the communication).
    *
    * \return POCOResult containing the result.
    */
-  POCOResult makeHTTPRequest(const std::string method,
-                             const std::string uri = "/",
-                             const std::string content = "");
+  POCOResult makeHTTPRequest(const std::string& method,
+                             const std::string& uri = "/",
+                             std::string content = std::string());
  
   /**
    * \brief A method for sending and receiving HTTP messages.
@@ -398,7 +570,7 @@ private:
   void sendAndReceive(POCOResult& result,
                       Poco::Net::HTTPRequest& request,
                       Poco::Net::HTTPResponse& response,
-                      const std::string request_content);
+                      const std::string& request_content);
   
   /**
    * \brief A method for performing authentication.
@@ -411,14 +583,14 @@ private:
   void authenticate(POCOResult& result,
                     Poco::Net::HTTPRequest& request,
                     Poco::Net::HTTPResponse& response,
-                    const std::string request_content);
+                    const std::string& request_content);
   
   /**
    * \brief A method for extracting and storing information from a cookie string.
    *
    * \param cookie_string for the cookie string.
    */
-  void extractAndStoreCookie(const std::string cookie_string);
+  void extractAndStoreCookie(const std::string& cookie_string);
 
   /**
    * \brief Static constant for the default HTTP communication timeout [microseconds].
@@ -466,6 +638,11 @@ private:
    * \brief A pointer to a WebSocket client.
    */
   Poco::SharedPtr<Poco::Net::WebSocket> p_websocket_;
+
+  /**
+   * \brief The transport counters (atomic, so that they can be read while communicating).
+   */
+  std::atomic<Poco::UInt64> transport_counters_[NUMBER_OF_TRANSPORT_COUNTERS] = {};
 };
 
 } // end namespace rws
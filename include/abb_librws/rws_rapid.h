@@ -46,7 +46,13 @@
 #ifndef RWS_RAPID_H
 #define RWS_RAPID_H
 
+#include <algorithm>
+#include <charconv>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "Poco/SharedPtr.h"
@@ -66,6 +72,252 @@ enum RAPIDAtomicTypes
   RAPID_STRING ///< \brief RAPID string (i.e. std::string).
 };
 
+struct RAPIDSymbolDataAbstract;
+
+/**
+ * \brief A class for parsing RAPID symbol data value strings (e.g. "[[515,0,712],[1,0,0,0]]") in a single pass.
+ *
+ * The parser walks the input once: each RAPID data struct consumes its own part of the input (records their brackets
+ * and components, atomics a single value), i.e. parsing is linear and doesn't allocate (except for string values).
+ * The first error stops the parsing, and its position is recorded. Components parsed before the error keep their
+ * new values.
+ */
+class RAPIDParser
+{
+public:
+  /**
+   * \brief An enum for the kernels that can locate the delimiters in "parseNumbers(...)".
+   */
+  enum DelimiterKernel
+  {
+    AUTOMATIC, ///< The fastest kernel supported by the build and the CPU (the default).
+    SCALAR,    ///< One character at a time (always supported).
+    SSE2,      ///< SSE2 instructions, 16 characters at a time (x86 builds).
+    AVX2       ///< AVX2 instructions, 32 characters at a time (GCC/Clang x86 builds, on CPUs with AVX2).
+  };
+
+  /**
+   * \brief A constructor.
+   *
+   * \param input for the value string to parse (must outlive the parser).
+   */
+  RAPIDParser(std::string_view input) : input_(input), position_(0), error_position_(0), p_error_message_(0) {}
+
+  /**
+   * \brief A method for parsing the complete input into RAPID symbol data.
+   *
+   * \param data for the RAPID symbol data to parse into.
+   *
+   * \return bool indicating if the input was parsed without errors.
+   */
+  bool parse(RAPIDSymbolDataAbstract& data);
+
+  /**
+   * \brief A method for finishing the parsing, which fails if anything but whitespace remains of the input.
+   *
+   * \return bool indicating if the input was parsed without errors.
+   */
+  bool finish();
+
+  /**
+   * \brief A method for consuming a character, if it is next (skipping any whitespace before it).
+   *
+   * \param character for the character.
+   *
+   * \return bool indicating if the character was consumed.
+   */
+  bool accept(const char character);
+
+  /**
+   * \brief A method for consuming an expected character (skipping any whitespace before it).
+   *
+   * \param character for the expected character.
+   *
+   * \return bool indicating if the character was found (otherwise the parsing has failed).
+   */
+  bool expect(const char character);
+
+  /**
+   * \brief A method for consuming the next complete value: an atom (e.g. "9E+09"), a quoted string or a bracketed
+   *        record/array (with balanced brackets).
+   *
+   * \return std::string_view viewing the value in the input (empty if the parsing has failed).
+   */
+  std::string_view nextValue();
+
+  /**
+   * \brief A method for consuming a flat bracketed list of numbers (e.g. "[1,2.5,-3E+02]") into contiguous storage.
+   *
+   * Meant for large numeric arrays: the delimiters are located with SIMD instructions, and the numbers are converted
+   * directly into the output. AVX2 is used if the CPU supports it (GCC/Clang builds), and otherwise SSE2 (x86 builds)
+   * or a scalar loop (other builds). See "setDelimiterKernel(...)" for overriding the selection.
+   *
+   * \param output for storing the numbers (replacing any previous content).
+   *
+   * \return bool indicating if the list was consumed. If not (e.g. nested or non-numeric values), nothing is consumed,
+   *         the parsing hasn't failed and the output is cleared, so that the value can be parsed by other means.
+   */
+  bool parseNumbers(std::vector<float>& output);
+
+  /**
+   * \brief A method for consuming a flat bracketed list of numbers (e.g. "[1,2.5,-3E+02]") into contiguous storage.
+   *
+   * \param output for storing the numbers (replacing any previous content).
+   *
+   * \return bool indicating if the list was consumed (see the float overload).
+   */
+  bool parseNumbers(std::vector<double>& output);
+
+  /**
+   * \brief A static method for selecting the kernel used by "parseNumbers(...)", for all parsers in the process.
+   *
+   * Meant for benchmarks and tests, e.g. to compare the kernels on the same machine.
+   *
+   * \param kernel for the kernel to use.
+   *
+   * \return bool indicating if the kernel is supported (if not, the current selection is kept).
+   */
+  static bool setDelimiterKernel(const DelimiterKernel kernel);
+
+  /**
+   * \brief A method for checking if the end of the input has been reached (skipping any whitespace before it).
+   *
+   * \return bool indicating if the end has been reached.
+   */
+  bool atEnd();
+
+  /**
+   * \brief A method for failing the parsing at the current position (only the first error is kept).
+   *
+   * \param p_message for the error's message (must be a string literal).
+   */
+  void fail(const char* p_message);
+
+  /**
+   * \brief A method for failing the parsing at a value (only the first error is kept).
+   *
+   * \param p_message for the error's message (must be a string literal).
+   * \param value for the offending value (viewing the input).
+   */
+  void fail(const char* p_message, std::string_view value);
+
+  /**
+   * \brief A method for checking if the parsing has failed.
+   *
+   * \return bool indicating if the parsing has failed.
+   */
+  bool hasFailed() const { return p_error_message_ != 0; }
+
+  /**
+   * \brief A method for retrieving the position (in the input) of the first error.
+   *
+   * \return size_t containing the position.
+   */
+  size_t getErrorPosition() const { return error_position_; }
+
+  /**
+   * \brief A method for retrieving the message of the first error.
+   *
+   * \return const char* containing the message (empty if the parsing hasn't failed).
+   */
+  const char* getErrorMessage() const { return (p_error_message_ ? p_error_message_ : ""); }
+
+private:
+  /**
+   * \brief A method for skipping whitespace.
+   */
+  void skipWhitespace();
+
+  /**
+   * \brief The value string to parse.
+   */
+  std::string_view input_;
+
+  /**
+   * \brief The current position in the input.
+   */
+  size_t position_;
+
+  /**
+   * \brief The position of the first error.
+   */
+  size_t error_position_;
+
+  /**
+   * \brief The message of the first error (null if the parsing hasn't failed).
+   */
+  const char* p_error_message_;
+};
+
+/**
+ * \brief Parses the next value as a RAPID num (e.g. "-1.5" or "9E+09").
+ *
+ * \param parser for the parser, positioned at the value.
+ * \param value for storing the parsed value (left unchanged if the parsing fails).
+ */
+void parseRAPIDValue(RAPIDParser& parser, float& value);
+
+/**
+ * \brief Parses the next value as a RAPID dnum (e.g. "-1.5" or "9E+09").
+ *
+ * \param parser for the parser, positioned at the value.
+ * \param value for storing the parsed value (left unchanged if the parsing fails).
+ */
+void parseRAPIDValue(RAPIDParser& parser, double& value);
+
+/**
+ * \brief Parses the next value as a RAPID bool (i.e. TRUE or FALSE).
+ *
+ * \param parser for the parser, positioned at the value.
+ * \param value for storing the parsed value (left unchanged if the parsing fails).
+ */
+void parseRAPIDValue(RAPIDParser& parser, bool& value);
+
+/**
+ * \brief Parses the next value as a RAPID string (i.e. without its surrounding quotation marks).
+ *
+ * \param parser for the parser, positioned at the value.
+ * \param value for storing the parsed value (left unchanged if the parsing fails).
+ */
+void parseRAPIDValue(RAPIDParser& parser, std::string& value);
+
+/**
+ * \brief Appends a RAPID num, in its shortest form that parses back to the exact same value.
+ *
+ * \param output for the string to append to.
+ * \param value for the value to append.
+ */
+void appendRAPIDValue(std::string& output, const float value);
+
+/**
+ * \brief Appends a RAPID dnum, in its shortest form that parses back to the exact same value.
+ *
+ * \param output for the string to append to.
+ * \param value for the value to append.
+ */
+void appendRAPIDValue(std::string& output, const double value);
+
+/**
+ * \brief Appends a RAPID bool (i.e. TRUE or FALSE).
+ *
+ * \param output for the string to append to.
+ * \param value for the value to append.
+ */
+void appendRAPIDValue(std::string& output, const bool value);
+
+/**
+ * \brief Appends a RAPID string (i.e. with surrounding quotation marks).
+ *
+ * \param output for the string to append to.
+ * \param value for the value to append.
+ */
+void appendRAPIDValue(std::string& output, const std::string& value);
+
+/**
+ * \brief Deleted, to prevent string literals from silently being appended as RAPID bools.
+ */
+void appendRAPIDValue(std::string& output, const char* value) = delete;
+
 /**
  * \brief An abstract struct, for structs representing the data of RAPID symbols.
  */
@@ -86,12 +338,44 @@ public:
    */
   virtual void parseString(const std::string&  value_string) = 0;
 
+  /**
+   * \brief Method for parsing the symbol's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The default implementation extracts the next complete value, and parses it with parseString. I.e. a derived
+   * struct's parseString must not parse with RAPIDParser::parse(*this) unless the struct also overrides this method.
+   *
+   * \param parser for the parser, positioned at the symbol's value.
+   */
+  virtual void parse(RAPIDParser& parser);
+
+  /**
+   * \brief Method for parsing a complete RAPID symbol data value string, which leaves the data unchanged if it fails.
+   *
+   * The default implementation parses into the data, and restores the data from its previous value string if the
+   * parsing fails.
+   *
+   * \param parser for the parser, positioned at the start of the input (see RAPIDParser::getErrorPosition on failure).
+   *
+   * \return bool indicating if the input was parsed without errors.
+   */
+  virtual bool tryParse(RAPIDParser& parser);
+
   /**
    * \brief Pure virtual method for constructing a RAPID symbol data value string.
    * 
    * \return std::string containing the constructed string.
    */
   virtual std::string constructString() const = 0;
+
+  /**
+   * \brief Method for appending the RAPID symbol data value string to an output string.
+   *
+   * The default implementation appends the result of constructString. Reusing the same output string (e.g. after
+   * clear()) avoids allocations once its capacity suffices.
+   *
+   * \param output for the string to append to.
+   */
+  virtual void appendString(std::string& output) const;
 };
 
 /**
@@ -108,10 +392,84 @@ public:
    */
   void parseString(const std::string& value_string)
   {
-    std::stringstream ss(value_string);
-    ss >> value;
+    RAPIDParser parser(value_string);
+    parser.parse(*this);
   }
-  
+
+  /**
+   * \brief A method for parsing the symbol's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The RAPID atomic types (float, double, bool and std::string) are parsed as RAPID values, integers with
+   * std::from_chars, and any other type with its stream extraction operator.
+   *
+   * \param parser for the parser, positioned at the symbol's value.
+   */
+  void parse(RAPIDParser& parser)
+  {
+    if constexpr (std::is_same<T, float>::value || std::is_same<T, double>::value ||
+                  std::is_same<T, bool>::value || std::is_same<T, std::string>::value)
+    {
+      parseRAPIDValue(parser, value);
+    }
+    else
+    {
+      std::string_view token = parser.nextValue();
+
+      if (parser.hasFailed())
+      {
+        return;
+      }
+
+      if constexpr (std::is_integral<T>::value)
+      {
+        T temp = T();
+        std::from_chars_result result = std::from_chars(token.data(), token.data() + token.size(), temp);
+
+        if (result.ec != std::errc() || result.ptr != token.data() + token.size())
+        {
+          parser.fail("invalid integer", token);
+          return;
+        }
+
+        value = temp;
+      }
+      else
+      {
+        T temp = T();
+        std::istringstream stream{std::string(token)};
+
+        if (!(stream >> temp) || !(stream >> std::ws).eof())
+        {
+          parser.fail("invalid value", token);
+          return;
+        }
+
+        value = temp;
+      }
+    }
+  }
+
+  /**
+   * \brief A method for parsing a complete RAPID symbol data value string, which leaves the value unchanged if the
+   *        parsing fails.
+   *
+   * \param parser for the parser, positioned at the start of the input.
+   *
+   * \return bool indicating if the input was parsed without errors.
+   */
+  bool tryParse(RAPIDParser& parser)
+  {
+    T previous_value = value;
+
+    if (parser.parse(*this))
+    {
+      return true;
+    }
+
+    value = std::move(previous_value);
+    return false;
+  }
+
   /**
    * \brief Container for the data's value.
    */
@@ -152,11 +510,11 @@ struct RAPIDAtomic<RAPID_BOOL> : public RAPIDAtomicTemplate<bool>
   std::string getType() const;
 
   /**
-   * \brief A method for parsing a RAPID symbol data value string.
+   * \brief A method for parsing the symbol's part of a RAPID symbol data value string, with a (single pass) parser.
    *
-   * \param value_string containing the string to parse.
+   * \param parser for the parser, positioned at the symbol's value.
    */
-  void parseString(const std::string& value_string);
+  void parse(RAPIDParser& parser);
   
   /**
    * \brief A method for constructing a RAPID symbol data value string.
@@ -164,6 +522,13 @@ struct RAPIDAtomic<RAPID_BOOL> : public RAPIDAtomicTemplate<bool>
    * \return std::string containing the constructed string.
    */
   std::string constructString() const;
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 };
 
 /**
@@ -185,6 +550,13 @@ struct RAPIDAtomic<RAPID_NUM> : public RAPIDAtomicTemplate<float>
    * \return std::string containing the data type name.
    */
   std::string getType() const;
+
+  /**
+   * \brief A method for parsing the symbol's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * \param parser for the parser, positioned at the symbol's value.
+   */
+  void parse(RAPIDParser& parser);
   
   /**
    * \brief A method for constructing a RAPID symbol data value string.
@@ -192,6 +564,13 @@ struct RAPIDAtomic<RAPID_NUM> : public RAPIDAtomicTemplate<float>
    * \return std::string containing the constructed string.
    */
   std::string constructString() const;
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 };
 
 /**
@@ -214,12 +593,26 @@ struct RAPIDAtomic<RAPID_DNUM> : public RAPIDAtomicTemplate<double>
    */
   std::string getType() const;
 
+  /**
+   * \brief A method for parsing the symbol's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * \param parser for the parser, positioned at the symbol's value.
+   */
+  void parse(RAPIDParser& parser);
+
   /**
    * \brief A method for constructing a RAPID symbol data value string.
    *
    * \return std::string containing the constructed string.
    */
   std::string constructString() const;
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 };
 
 /**
@@ -243,11 +636,11 @@ struct RAPIDAtomic<RAPID_STRING> : public RAPIDAtomicTemplate<std::string>
   std::string getType() const;
   
   /**
-   * \brief A method for parsing a RAPID symbol data value string.
+   * \brief A method for parsing the symbol's part of a RAPID symbol data value string, with a (single pass) parser.
    *
-   * \param value_string containing the string to parse.
+   * \param parser for the parser, positioned at the symbol's value.
    */
-  void parseString(const std::string& value_string);
+  void parse(RAPIDParser& parser);
 
   /**
    * \brief A method for constructing a RAPID symbol data value string.
@@ -255,6 +648,13 @@ struct RAPIDAtomic<RAPID_STRING> : public RAPIDAtomicTemplate<std::string>
    * \return std::string containing the constructed string.
    */
   std::string constructString() const;
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 };
 
 /**
@@ -277,8 +677,34 @@ typedef RAPIDAtomic<RAPID_DNUM> RAPIDDnum;
  */
 typedef RAPIDAtomic<RAPID_STRING> RAPIDString;
 
+/**
+ * \brief Parses the next value as a RAPID bool, num, dnum or string symbol's value (without virtual dispatch).
+ *
+ * \param parser for the parser, positioned at the value.
+ * \param value for storing the parsed value.
+ */
+inline void parseRAPIDValue(RAPIDParser& parser, RAPIDBool& value) { parseRAPIDValue(parser, value.value); }
+inline void parseRAPIDValue(RAPIDParser& parser, RAPIDNum& value) { parseRAPIDValue(parser, value.value); }
+inline void parseRAPIDValue(RAPIDParser& parser, RAPIDDnum& value) { parseRAPIDValue(parser, value.value); }
+inline void parseRAPIDValue(RAPIDParser& parser, RAPIDString& value) { parseRAPIDValue(parser, value.value); }
+
+/**
+ * \brief Appends a RAPID bool, num, dnum or string symbol's value (without virtual dispatch).
+ *
+ * \param output for the string to append to.
+ * \param value for the value to append.
+ */
+inline void appendRAPIDValue(std::string& output, const RAPIDBool& value) { appendRAPIDValue(output, value.value); }
+inline void appendRAPIDValue(std::string& output, const RAPIDNum& value) { appendRAPIDValue(output, value.value); }
+inline void appendRAPIDValue(std::string& output, const RAPIDDnum& value) { appendRAPIDValue(output, value.value); }
+inline void appendRAPIDValue(std::string& output, const RAPIDString& value) { appendRAPIDValue(output, value.value); }
+
 /**
  * \brief A struct, for representing the data of a RAPID record symbol.
+ *
+ * The record is parsed and constructed from its registered components (i.e. with virtual calls per component). The
+ * predefined records below instead override parse and appendString with code generated from their RAPIDSchema, i.e.
+ * they don't register any components, and they are copied member by member.
  */
 struct RAPIDRecord : public RAPIDSymbolDataAbstract
 {
@@ -296,6 +722,13 @@ public:
    * \return std::string containing the constructed string.
    */
   std::string constructString() const;
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
   
   /**
    * \brief A method for parsing a RAPID symbol data value string.
@@ -303,6 +736,13 @@ public:
    * \param value_string containing the string to parse.
    */
   void parseString(const std::string& value_string);
+
+  /**
+   * \brief A method for parsing the symbol's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * \param parser for the parser, positioned at the symbol's value.
+   */
+  void parse(RAPIDParser& parser);
   
   /**
    * \brief A method for getting the type of the RAPID record.
@@ -329,7 +769,7 @@ protected:
    *
    * \return unsigned int containing the number of times the character occurs.
    */
-  unsigned int countCharInString(std::string input, const char character);
+  unsigned int countCharInString(const std::string& input, const char character);
   
   /**
    * \brief A method to extract delimited substrings in a string.
@@ -338,7 +778,7 @@ protected:
    *
    * \return std::vector<std::string> containing the extracted substrings.
    */
-  std::vector<std::string> extractDelimitedSubstrings(const std::string input);
+  std::vector<std::string> extractDelimitedSubstrings(const std::string& input);
   
   /**
    * \brief The record's type name.
@@ -363,14 +803,23 @@ public:
   RobJoint()
   :
   RAPIDRecord("robjoint")
-  {
-    components_.push_back(&rax_1);
-    components_.push_back(&rax_2);
-    components_.push_back(&rax_3);
-    components_.push_back(&rax_4);
-    components_.push_back(&rax_5);
-    components_.push_back(&rax_6);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
   
   /**
    * \brief First robot axis.
@@ -415,14 +864,23 @@ public:
   ExtJoint()
   :
   RAPIDRecord("extjoint")
-  {
-    components_.push_back(&eax_a);
-    components_.push_back(&eax_b);
-    components_.push_back(&eax_c);
-    components_.push_back(&eax_d);
-    components_.push_back(&eax_e);
-    components_.push_back(&eax_f);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
   
   /**
    * \brief External axis a.
@@ -467,10 +925,23 @@ public:
   JointTarget()
   :
   RAPIDRecord("jointtarget")
-  {
-    components_.push_back(&robax);
-    components_.push_back(&extax);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
   
   /**
    * \brief Robot axes.
@@ -495,11 +966,23 @@ public:
   Pos()
   :
   RAPIDRecord("pos")
-  {
-    components_.push_back(&x);
-    components_.push_back(&y);
-    components_.push_back(&z);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 
   /**
    * \brief X-value of the position.
@@ -529,12 +1012,23 @@ public:
   Orient()
   :
   RAPIDRecord("orient")
-  {
-    components_.push_back(&q1);
-    components_.push_back(&q2);
-    components_.push_back(&q3);
-    components_.push_back(&q4);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
   
   /**
    * \brief Quaternion 1.
@@ -569,10 +1063,23 @@ public:
   Pose()
   :
   RAPIDRecord("pose")
-  {
-    components_.push_back(&pos);
-    components_.push_back(&rot);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 
   /**
    * \brief Position (x, y, z) [mm].
@@ -597,12 +1104,23 @@ public:
   ConfData()
   :
   RAPIDRecord("confdata")
-  {
-    components_.push_back(&cf1);
-    components_.push_back(&cf4);
-    components_.push_back(&cf6);
-    components_.push_back(&cfx);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 
   /**
    * \brief Quadrent number for axis 1.
@@ -637,12 +1155,23 @@ public:
   RobTarget()
   :
   RAPIDRecord("robtarget")
-  {
-    components_.push_back(&pos);
-    components_.push_back(&orient);
-    components_.push_back(&robconf);
-    components_.push_back(&extax);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 
   /**
    * \brief Position for the tool center point [mm].
@@ -677,14 +1206,23 @@ public:
   LoadData()
   :
   RAPIDRecord("loaddata")
-  {
-    components_.push_back(&mass);
-    components_.push_back(&cog);
-    components_.push_back(&aom);
-    components_.push_back(&ix);
-    components_.push_back(&iy);
-    components_.push_back(&iz);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
   
   /**
    * \brief The mass of the load [kg].
@@ -729,11 +1267,23 @@ public:
   ToolData()
   :
   RAPIDRecord("tooldata")
-  {
-    components_.push_back(&robhold);
-    components_.push_back(&tframe);
-    components_.push_back(&tload);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
   
   /**
    * \brief Defines if the robot is holding the tool or not.
@@ -763,13 +1313,23 @@ public:
   WObjData()
   :
   RAPIDRecord("wobjdata")
-  {
-    components_.push_back(&robhold);
-    components_.push_back(&ufprog);
-    components_.push_back(&ufmec);
-    components_.push_back(&uframe);
-    components_.push_back(&oframe);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
   
   /**
    * \brief Defines if the robot is holding the work object or not.
@@ -809,12 +1369,23 @@ public:
   SpeedData()
   :
   RAPIDRecord("speeddata")
-  {
-    components_.push_back(&v_tcp);
-    components_.push_back(&v_ori);
-    components_.push_back(&v_leax);
-    components_.push_back(&v_reax);
-  }
+  {}
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The fields are parsed as described by the record's RAPIDSchema (see rws_rapid_schema.h).
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
 
   /**
    * \brief The speed [mm/s] of the tool center point (TCP).
@@ -837,6 +1408,617 @@ public:
   RAPIDNum v_reax;
 };
 
+/**
+ * \brief Declaration of a template struct, for describing the schema of a typed RAPID record (see rws_rapid_schema.h).
+ */
+template <typename T> struct RAPIDSchema;
+
+/**
+ * \brief Declaration of a function template, for parsing a typed RAPID record (defined in rws_rapid_schema.h).
+ *
+ * \param parser for the parser, positioned at the record's value.
+ * \param record for storing the parsed record.
+ */
+template <typename T>
+void parseRAPIDValue(RAPIDParser& parser, T& record);
+
+/**
+ * \brief Declaration of a function template, for appending a typed RAPID record (defined in rws_rapid_schema.h).
+ *
+ * \param output for the string to append to.
+ * \param record containing the record to append.
+ */
+template <typename T>
+void appendRAPIDValue(std::string& output, const T& record);
+
+/**
+ * \brief A template struct, for mapping the element types of RAPID arrays to RAPID data type names.
+ *
+ * Typed records (see rws_rapid_schema.h) use the type name of their schema.
+ */
+template <typename T>
+struct RAPIDElementType
+{
+  /**
+   * \brief A method for retrieving the RAPID data type name.
+   *
+   * \return const char* containing the type name.
+   */
+  static const char* name() { return RAPIDSchema<T>::TYPE; }
+};
+
+/**
+ * \brief Specialization for RAPID num elements.
+ */
+template <>
+struct RAPIDElementType<float>
+{
+  static const char* name() { return "num"; }
+};
+
+/**
+ * \brief Specialization for RAPID dnum elements.
+ */
+template <>
+struct RAPIDElementType<double>
+{
+  static const char* name() { return "dnum"; }
+};
+
+/**
+ * \brief Specialization for RAPID bool elements.
+ */
+template <>
+struct RAPIDElementType<bool>
+{
+  static const char* name() { return "bool"; }
+};
+
+/**
+ * \brief Specialization for RAPID string elements.
+ */
+template <>
+struct RAPIDElementType<std::string>
+{
+  static const char* name() { return "string"; }
+};
+
+/**
+ * \brief An abstract struct, for representing the data of a one-dimensional RAPID array symbol (e.g. num{1000}).
+ *
+ * Besides the complete value string, the elements can be parsed and constructed one by one, which allows element
+ * ranges to be transferred separately (see RWSInterface::getRAPIDArrayData and RWSInterface::setRAPIDArrayData).
+ * Modified elements are tracked, so that only those need to be written back, and so are loaded elements (i.e. those
+ * holding a read or set value), so that default constructed elements are never written over the robot controller's.
+ */
+struct RAPIDArrayAbstract : public RAPIDSymbolDataAbstract
+{
+public:
+  /**
+   * \brief A method for retrieving the number of elements.
+   *
+   * \return size_t containing the number of elements.
+   */
+  virtual size_t size() const = 0;
+
+  /**
+   * \brief A method for resizing the array. Added elements are default constructed, unmodified and not loaded.
+   *
+   * \param size for the new number of elements.
+   */
+  virtual void resize(const size_t size) = 0;
+
+  /**
+   * \brief A method for parsing the value string of a single element. A parsed element is marked as unmodified, and
+   *        as loaded.
+   *
+   * \param index for the (zero-based) element index.
+   * \param value_string containing the element's value string.
+   *
+   * \return bool indicating if the element was parsed or not (the element is left unchanged if not).
+   */
+  virtual bool parseElement(const size_t index, const std::string& value_string) = 0;
+
+  /**
+   * \brief A method for parsing the value strings of consecutive elements, all or nothing. The array grows to hold
+   *        the elements, if needed, and the parsed elements are marked as unmodified, and as loaded.
+   *
+   * \param first for the (zero-based) index of the first element.
+   * \param value_strings containing the elements' value strings.
+   * \param p_failed_index for storing the index of the first element that couldn't be parsed (optional).
+   *
+   * \return bool indicating if all elements were parsed or not (the array is left unchanged if not).
+   */
+  virtual bool parseElements(const size_t first,
+                             const std::vector<std::string_view>& value_strings,
+                             size_t* p_failed_index) = 0;
+
+  /**
+   * \brief A method for appending the value string of a single element to an output string.
+   *
+   * \param output for the string to append to.
+   * \param index for the (zero-based) element index.
+   */
+  virtual void appendElement(std::string& output, const size_t index) const = 0;
+
+  /**
+   * \brief A method for marking a range of elements as modified.
+   *
+   * \param first for the (zero-based) index of the first element.
+   * \param count for the number of elements (clamped to the array's size).
+   */
+  void markModified(const size_t first, const size_t count);
+
+  /**
+   * \brief A method for marking all elements as unmodified (e.g. after they have been written).
+   */
+  void markUnmodified();
+
+  /**
+   * \brief A method for marking a range of elements as unmodified (e.g. after they have been written).
+   *
+   * \param first for the (zero-based) index of the first element.
+   * \param count for the number of elements (clamped to the array's size).
+   */
+  void markUnmodified(const size_t first, const size_t count);
+
+  /**
+   * \brief A method for checking if an element has been modified.
+   *
+   * \param index for the (zero-based) element index.
+   *
+   * \return bool indicating if the element has been modified or not.
+   */
+  bool isModified(const size_t index) const;
+
+  /**
+   * \brief A method for retrieving the number of modified elements.
+   *
+   * \return size_t containing the number of modified elements.
+   */
+  size_t getModifiedCount() const;
+
+  /**
+   * \brief A method for retrieving the modified elements, as contiguous ranges.
+   *
+   * \return std::vector<std::pair<size_t, size_t>> containing the (first index, count) of each range, in order.
+   */
+  std::vector<std::pair<size_t, size_t>> getModifiedRanges() const;
+
+  /**
+   * \brief A method for checking if an element has been loaded, i.e. if it holds a value that has been read (parsed)
+   *        or set, rather than a default constructed value (e.g. after resize).
+   *
+   * \param index for the (zero-based) element index.
+   *
+   * \return bool indicating if the element has been loaded or not.
+   */
+  bool isLoaded(const size_t index) const;
+
+  /**
+   * \brief A method for retrieving the number of elements that haven't been loaded (see isLoaded).
+   *
+   * \return size_t containing the number of elements.
+   */
+  size_t getUnloadedCount() const;
+
+protected:
+  /**
+   * \brief Flags for the modified elements (one per element).
+   */
+  std::vector<bool> modified_;
+
+  /**
+   * \brief Flags for the loaded elements (one per element).
+   */
+  std::vector<bool> loaded_;
+};
+
+/**
+ * \brief A template struct, for representing the data of a one-dimensional RAPID array with contiguous storage.
+ *
+ * The elements can be of any type with parseRAPIDValue/appendRAPIDValue overloads, i.e. float (num), double (dnum),
+ * bool, std::string and typed records (e.g. rapid::Pose, which requires rws_rapid_schema.h). For example, a num array
+ * can be stored in double precision with RAPIDArray<double>(0, "num").
+ */
+template <typename T>
+struct RAPIDArray : public RAPIDArrayAbstract
+{
+public:
+  /**
+   * \brief A constructor.
+   *
+   * \param size for the initial number of (default constructed, unmodified and not loaded) elements.
+   * \param element_type specifying the RAPID data type name of the elements.
+   */
+  RAPIDArray(const size_t size = 0, const std::string& element_type = RAPIDElementType<T>::name())
+  :
+  element_type_(element_type),
+  elements_(size)
+  {
+    modified_.assign(size, false);
+    loaded_.assign(size, false);
+  }
+
+  /**
+   * \brief A method for getting the RAPID data type of the elements (as reported in the symbol's properties).
+   *
+   * \return std::string containing the type.
+   */
+  std::string getType() const { return element_type_; }
+
+  /**
+   * \brief A method for parsing a RAPID symbol data value string.
+   *
+   * \param value_string containing the string to parse.
+   */
+  void parseString(const std::string& value_string)
+  {
+    RAPIDParser parser(value_string);
+    parser.parse(*this);
+  }
+
+  /**
+   * \brief A method for parsing the array's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * The array is resized to the number of parsed elements, which are all marked as unmodified and loaded. The
+   * elements are parsed into a temporary vector, i.e. the array is left unchanged if the parsing fails.
+   *
+   * \param parser for the parser, positioned at the array's value.
+   */
+  void parse(RAPIDParser& parser)
+  {
+    std::vector<T> elements;
+
+    if constexpr (std::is_floating_point<T>::value)
+    {
+      if (parser.parseNumbers(elements))
+      {
+        elements_.swap(elements);
+        modified_.assign(elements_.size(), false);
+        loaded_.assign(elements_.size(), true);
+        return;
+      }
+    }
+
+    if (parser.expect('['))
+    {
+      if (!parser.accept(']'))
+      {
+        do
+        {
+          T element = T();
+          parseRAPIDValue(parser, element);
+          elements.push_back(std::move(element));
+        }
+        while (!parser.hasFailed() && parser.accept(','));
+
+        parser.expect(']');
+      }
+
+      if (!parser.hasFailed())
+      {
+        elements_.swap(elements);
+        modified_.assign(elements_.size(), false);
+        loaded_.assign(elements_.size(), true);
+      }
+    }
+  }
+
+  /**
+   * \brief A method for parsing a complete RAPID symbol data value string into a temporary array, which replaces the
+   *        array only if the parsing succeeds.
+   *
+   * \param parser for the parser, positioned at the start of the input.
+   *
+   * \return bool indicating if the input was parsed without errors.
+   */
+  bool tryParse(RAPIDParser& parser)
+  {
+    RAPIDArray<T> temp(0, element_type_);
+
+    if (!parser.parse(temp))
+    {
+      return false;
+    }
+
+    *this = std::move(temp);
+    return true;
+  }
+
+  /**
+   * \brief A method for constructing a RAPID symbol data value string.
+   *
+   * \return std::string containing the constructed string.
+   */
+  std::string constructString() const
+  {
+    std::string output;
+    appendString(output);
+    return output;
+  }
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const
+  {
+    output += '[';
+
+    for (size_t i = 0; i < elements_.size(); ++i)
+    {
+      if (i > 0)
+      {
+        output += ',';
+      }
+
+      appendRAPIDValue(output, elements_[i]);
+    }
+
+    output += ']';
+  }
+
+  /**
+   * \brief A method for retrieving the number of elements.
+   *
+   * \return size_t containing the number of elements.
+   */
+  size_t size() const { return elements_.size(); }
+
+  /**
+   * \brief A method for resizing the array. Added elements are default constructed, unmodified and not loaded.
+   *
+   * \param size for the new number of elements.
+   */
+  void resize(const size_t size)
+  {
+    elements_.resize(size);
+    modified_.resize(size, false);
+    loaded_.resize(size, false);
+  }
+
+  /**
+   * \brief A method for parsing the value string of a single element. A parsed element is marked as unmodified, and
+   *        as loaded.
+   *
+   * \param index for the (zero-based) element index.
+   * \param value_string containing the element's value string.
+   *
+   * \return bool indicating if the element was parsed or not (the element is left unchanged if not).
+   */
+  bool parseElement(const size_t index, const std::string& value_string)
+  {
+    if (index >= elements_.size())
+    {
+      return false;
+    }
+
+    T element = elements_[index];
+    RAPIDParser parser(value_string);
+    parseRAPIDValue(parser, element);
+
+    if (!parser.finish())
+    {
+      return false;
+    }
+
+    elements_[index] = std::move(element);
+    modified_[index] = false;
+    loaded_[index] = true;
+
+    return true;
+  }
+
+  /**
+   * \brief A method for parsing the value strings of consecutive elements, all or nothing. The array grows to hold
+   *        the elements, if needed, and the parsed elements are marked as unmodified, and as loaded.
+   *
+   * \param first for the (zero-based) index of the first element.
+   * \param value_strings containing the elements' value strings.
+   * \param p_failed_index for storing the index of the first element that couldn't be parsed (optional).
+   *
+   * \return bool indicating if all elements were parsed or not (the array is left unchanged if not).
+   */
+  bool parseElements(const size_t first, const std::vector<std::string_view>& value_strings, size_t* p_failed_index)
+  {
+    // Parse into a temporary vector, so that a failure leaves the array unchanged.
+    std::vector<T> elements;
+    elements.reserve(value_strings.size());
+
+    for (size_t i = 0; i < value_strings.size(); ++i)
+    {
+      T element = (first + i < elements_.size() ? T(elements_[first + i]) : T());
+      RAPIDParser parser(value_strings[i]);
+      parseRAPIDValue(parser, element);
+
+      if (!parser.finish())
+      {
+        if (p_failed_index)
+        {
+          *p_failed_index = first + i;
+        }
+
+        return false;
+      }
+
+      elements.push_back(std::move(element));
+    }
+
+    if (first + elements.size() > elements_.size())
+    {
+      resize(first + elements.size());
+    }
+
+    std::move(elements.begin(), elements.end(), elements_.begin() + first);
+    std::fill(modified_.begin() + first, modified_.begin() + first + elements.size(), false);
+    std::fill(loaded_.begin() + first, loaded_.begin() + first + elements.size(), true);
+
+    return true;
+  }
+
+  /**
+   * \brief A method for appending the value string of a single element to an output string.
+   *
+   * \param output for the string to append to.
+   * \param index for the (zero-based) element index.
+   */
+  void appendElement(std::string& output, const size_t index) const
+  {
+    appendRAPIDValue(output, elements_[index]);
+  }
+
+  /**
+   * \brief A method for retrieving an element.
+   *
+   * \param index for the (zero-based) element index.
+   *
+   * \return const T& (or bool, for bool arrays) containing the element.
+   */
+  typename std::vector<T>::const_reference get(const size_t index) const { return elements_[index]; }
+
+  /**
+   * \brief A method for setting an element, and marking it as modified and loaded.
+   *
+   * \param index for the (zero-based) element index.
+   * \param value containing the element's new value.
+   */
+  void set(const size_t index, const T& value)
+  {
+    elements_[index] = value;
+    modified_[index] = true;
+    loaded_[index] = true;
+  }
+
+  /**
+   * \brief A method for setting a range of elements (e.g. from a point buffer), and marking them as modified and
+   *        loaded.
+   *
+   * \param first for the (zero-based) index of the first element. The array grows, if needed.
+   * \param p_values for the new values.
+   * \param count for the number of values.
+   */
+  void set(const size_t first, const T* p_values, const size_t count)
+  {
+    if (first + count > elements_.size())
+    {
+      resize(first + count);
+    }
+
+    std::copy(p_values, p_values + count, elements_.begin() + first);
+    markModified(first, count);
+    std::fill(loaded_.begin() + first, loaded_.begin() + first + count, true);
+  }
+
+  /**
+   * \brief A method for retrieving the elements (contiguous, except for bool arrays).
+   *
+   * \return const std::vector<T>& containing the elements.
+   */
+  const std::vector<T>& getElements() const { return elements_; }
+
+private:
+  /**
+   * \brief The RAPID data type name of the elements.
+   */
+  std::string element_type_;
+
+  /**
+   * \brief The array's elements.
+   */
+  std::vector<T> elements_;
+};
+
+/**
+ * \brief Typedef for representing RAPID num arrays.
+ */
+typedef RAPIDArray<float> RAPIDNumArray;
+
+/**
+ * \brief Typedef for representing RAPID dnum arrays.
+ */
+typedef RAPIDArray<double> RAPIDDnumArray;
+
+/**
+ * \brief A class, for tracking the changes of RAPID symbol data against a snapshot (i.e. its last read or written
+ *        value), so that only the changed components need to be written.
+ */
+class RAPIDSnapshot
+{
+public:
+  /**
+   * \brief A struct, for representing a changed component.
+   */
+  struct Change
+  {
+    /**
+     * \brief The component's (zero-based) indices, from the symbol's top level (empty for the complete value).
+     *
+     * Record components and array elements are both indexed in value string order, e.g. {1, 0} for the x component
+     * of a pose's rot component.
+     */
+    std::vector<size_t> path;
+
+    /**
+     * \brief The component's new value string.
+     */
+    std::string value;
+  };
+
+  /**
+   * \brief A method for taking a snapshot of a value string.
+   *
+   * \param value containing the value string.
+   */
+  void take(const std::string& value) { value_ = value; }
+
+  /**
+   * \brief A method for taking a snapshot of RAPID symbol data.
+   *
+   * \param data containing the RAPID symbol data.
+   */
+  void take(const RAPIDSymbolDataAbstract& data);
+
+  /**
+   * \brief A method for discarding the snapshot (so that the next write is a complete write).
+   */
+  void clear() { value_.clear(); }
+
+  /**
+   * \brief A method for checking if a snapshot has been taken.
+   *
+   * \return bool indicating if the snapshot is empty.
+   */
+  bool isEmpty() const { return value_.empty(); }
+
+  /**
+   * \brief A method for retrieving the snapshot's value string.
+   *
+   * \return const std::string& containing the value string.
+   */
+  const std::string& getValue() const { return value_; }
+
+  /**
+   * \brief A method for finding the components of a value string, which differ from the snapshot.
+   *
+   * The changes are as fine grained as possible, except that a record/array with all its components changed is
+   * reported as one change. An empty snapshot, or a changed structure (e.g. array size), gives one complete change.
+   *
+   * \param value containing the current value string.
+   * \param p_changes for storing the changes (in value string order).
+   *
+   * \return bool indicating if the value differs from the snapshot.
+   */
+  bool findChanges(const std::string& value, std::vector<Change>* p_changes) const;
+
+private:
+  /**
+   * \brief The snapshot's value string (empty if no snapshot has been taken).
+   */
+  std::string value_;
+};
+
 } // end namespace rws
 } // end namespace abb
 
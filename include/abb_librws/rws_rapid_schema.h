@@ -0,0 +1,571 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Compile-time schemas that generate parsing and serialization code for RAPID records.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_RAPID_SCHEMA_H
+#define RWS_RAPID_SCHEMA_H
+
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "rws_rapid.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief Declaration of a template struct, for describing the schema of a typed RAPID record.
+ *
+ * A specialization lists the record's RAPID type name, and its fields (in RAPID order) as member pointers:
+ *
+ *   template <>
+ *   struct RAPIDSchema<MyRecord>
+ *   {
+ *     static constexpr const char* TYPE = "myrecord";
+ *     static constexpr auto FIELDS = std::make_tuple(&MyRecord::a, &MyRecord::b);
+ *   };
+ *
+ * The record's fields can be float (num), double (dnum), bool, std::string or other typed records. The parse and
+ * format code is generated from the schema at compile time, i.e. without any virtual dispatch.
+ */
+template <typename T> struct RAPIDSchema;
+
+/**
+ * \brief Parses the next value as a typed RAPID record (e.g. "[[515,0,712],[1,0,0,0]]").
+ *
+ * \param parser for the parser, positioned at the value.
+ * \param record for storing the parsed record (fields parsed before a failure keep their new values).
+ */
+template <typename T>
+void parseRAPIDValue(RAPIDParser& parser, T& record)
+{
+  if (parser.expect('['))
+  {
+    size_t i = 0;
+
+    std::apply([&](const auto... fields)
+    {
+      (((i++ == 0 || parser.expect(',')) ? parseRAPIDValue(parser, record.*fields) : void()), ...);
+    }, RAPIDSchema<T>::FIELDS);
+
+    parser.expect(']');
+  }
+}
+
+/**
+ * \brief Appends a typed RAPID record.
+ *
+ * \param output for the string to append to.
+ * \param record for the record to append.
+ */
+template <typename T>
+void appendRAPIDValue(std::string& output, const T& record)
+{
+  output += '[';
+
+  size_t i = 0;
+
+  std::apply([&](const auto... fields)
+  {
+    (((i++ == 0 ? void() : void(output += ',')), appendRAPIDValue(output, record.*fields)), ...);
+  }, RAPIDSchema<T>::FIELDS);
+
+  output += ']';
+}
+
+/**
+ * \brief Parses a complete RAPID symbol data value string into a typed value.
+ *
+ * \param input for the value string to parse.
+ * \param value for storing the parsed value.
+ *
+ * \return bool indicating if the input was parsed without errors.
+ */
+template <typename T>
+bool parseRAPIDString(std::string_view input, T& value)
+{
+  RAPIDParser parser(input);
+  parseRAPIDValue(parser, value);
+  return parser.finish();
+}
+
+/**
+ * \brief Constructs a RAPID symbol data value string from a typed value.
+ *
+ * \param value for the value.
+ *
+ * \return std::string containing the constructed string.
+ */
+template <typename T>
+std::string constructRAPIDString(const T& value)
+{
+  std::string result;
+  appendRAPIDValue(result, value);
+  return result;
+}
+
+/**
+ * \brief A template struct, for adapting a typed RAPID record to the polymorphic RAPID symbol data interface.
+ *
+ * E.g. for reading and writing typed records with RWSInterface::getRAPIDSymbolData/setRAPIDSymbolData.
+ */
+template <typename T>
+struct RAPIDTypedRecord : public RAPIDSymbolDataAbstract
+{
+public:
+  /**
+   * \brief A constructor.
+   *
+   * \param value specifying the value of the record.
+   */
+  RAPIDTypedRecord(const T& value = T()) : value(value) {}
+
+  /**
+   * \brief A method for retrieving the name of the record's type.
+   *
+   * \return std::string containing the type name.
+   */
+  std::string getType() const { return RAPIDSchema<T>::TYPE; }
+
+  /**
+   * \brief A method for parsing a RAPID symbol data value string.
+   *
+   * \param value_string containing the string to parse.
+   */
+  void parseString(const std::string& value_string) { parseRAPIDString(value_string, value); }
+
+  /**
+   * \brief A method for constructing a RAPID symbol data value string.
+   *
+   * \return std::string containing the constructed string.
+   */
+  std::string constructString() const { return constructRAPIDString(value); }
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const { appendRAPIDValue(output, value); }
+
+  /**
+   * \brief A method for parsing the record's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * \param parser for the parser, positioned at the record's value.
+   */
+  void parse(RAPIDParser& parser) { parseRAPIDValue(parser, value); }
+
+  /**
+   * \brief A method for parsing a complete RAPID symbol data value string into a temporary record, which replaces the
+   *        record only if the parsing succeeds.
+   *
+   * \param parser for the parser, positioned at the start of the input.
+   *
+   * \return bool indicating if the input was parsed without errors.
+   */
+  bool tryParse(RAPIDParser& parser)
+  {
+    RAPIDTypedRecord<T> temp(value);
+
+    if (!parser.parse(temp))
+    {
+      return false;
+    }
+
+    value = std::move(temp.value);
+    return true;
+  }
+
+  /**
+   * \brief Container for the record's value.
+   */
+  T value;
+};
+
+/**
+ * \brief Typed (plain aggregate) versions of the RAPID records in rws_rapid.h.
+ *
+ * They mirror the polymorphic records' fields, but with plain values (e.g. float instead of RAPIDNum). I.e. they are
+ * trivially copyable (except records containing strings), and are parsed and formatted without virtual dispatch.
+ */
+namespace rapid
+{
+/**
+ * \brief A struct, for representing a RAPID robjoint record.
+ */
+struct RobJoint
+{
+  float rax_1 = 0.0f; ///< \brief First robot axis.
+  float rax_2 = 0.0f; ///< \brief Second robot axis.
+  float rax_3 = 0.0f; ///< \brief Third robot axis.
+  float rax_4 = 0.0f; ///< \brief Fourth robot axis.
+  float rax_5 = 0.0f; ///< \brief Fifth robot axis.
+  float rax_6 = 0.0f; ///< \brief Sixth robot axis.
+};
+
+/**
+ * \brief A struct, for representing a RAPID extjoint record.
+ */
+struct ExtJoint
+{
+  float eax_a = 0.0f; ///< \brief First external axis.
+  float eax_b = 0.0f; ///< \brief Second external axis.
+  float eax_c = 0.0f; ///< \brief Third external axis.
+  float eax_d = 0.0f; ///< \brief Fourth external axis.
+  float eax_e = 0.0f; ///< \brief Fifth external axis.
+  float eax_f = 0.0f; ///< \brief Sixth external axis.
+};
+
+/**
+ * \brief A struct, for representing a RAPID jointtarget record.
+ */
+struct JointTarget
+{
+  RobJoint robax; ///< \brief Robot axes.
+  ExtJoint extax; ///< \brief External axes.
+};
+
+/**
+ * \brief A struct, for representing a RAPID pos record.
+ */
+struct Pos
+{
+  float x = 0.0f; ///< \brief X-value of the position.
+  float y = 0.0f; ///< \brief Y-value of the position.
+  float z = 0.0f; ///< \brief Z-value of the position.
+};
+
+/**
+ * \brief A struct, for representing a RAPID orient record.
+ */
+struct Orient
+{
+  float q1 = 0.0f; ///< \brief Quaternion 1.
+  float q2 = 0.0f; ///< \brief Quaternion 2.
+  float q3 = 0.0f; ///< \brief Quaternion 3.
+  float q4 = 0.0f; ///< \brief Quaternion 4.
+};
+
+/**
+ * \brief A struct, for representing a RAPID pose record.
+ */
+struct Pose
+{
+  Pos pos;    ///< \brief Displacement in x, y and z.
+  Orient rot; ///< \brief Rotation.
+};
+
+/**
+ * \brief A struct, for representing a RAPID confdata record.
+ */
+struct ConfData
+{
+  float cf1 = 0.0f; ///< \brief Quadrant of axis 1.
+  float cf4 = 0.0f; ///< \brief Quadrant of axis 4.
+  float cf6 = 0.0f; ///< \brief Quadrant of axis 6.
+  float cfx = 0.0f; ///< \brief Robot configuration.
+};
+
+/**
+ * \brief A struct, for representing a RAPID robtarget record.
+ */
+struct RobTarget
+{
+  Pos pos;          ///< \brief Position (x, y, z) [mm].
+  Orient orient;    ///< \brief Orientation (as a quaternion).
+  ConfData robconf; ///< \brief Robot configuration.
+  ExtJoint extax;   ///< \brief External axes.
+};
+
+/**
+ * \brief A struct, for representing a RAPID loaddata record.
+ */
+struct LoadData
+{
+  float mass = 0.0f; ///< \brief The mass of the load [kg].
+  Pos cog;           ///< \brief Center of gravity (x, y, z).
+  Orient aom;        ///< \brief Axes of moment.
+  float ix = 0.0f;   ///< \brief Inertia of the load around the x-axis [kgm^2].
+  float iy = 0.0f;   ///< \brief Inertia of the load around the y-axis [kgm^2].
+  float iz = 0.0f;   ///< \brief Inertia of the load around the z-axis [kgm^2].
+};
+
+/**
+ * \brief A struct, for representing a RAPID tooldata record.
+ */
+struct ToolData
+{
+  bool robhold = false; ///< \brief Defines if the robot is holding the tool or not.
+  Pose tframe;          ///< \brief The tool's coordinate system.
+  LoadData tload;       ///< \brief The tool's load.
+};
+
+/**
+ * \brief A struct, for representing a RAPID wobjdata record.
+ */
+struct WObjData
+{
+  bool robhold = false; ///< \brief Defines if the robot is holding the work object or not.
+  bool ufprog = false;  ///< \brief User frame programmed.
+  std::string ufmec;    ///< \brief User frame mechanical unit.
+  Pose uframe;          ///< \brief User frame.
+  Pose oframe;          ///< \brief Object frame.
+};
+
+/**
+ * \brief A struct, for representing a RAPID speeddata record.
+ */
+struct SpeedData
+{
+  float v_tcp = 0.0f;  ///< \brief The speed [mm/s] of the tool center point (TCP).
+  float v_ori = 0.0f;  ///< \brief The reorientation speed [deg/s] of the tool center point (TCP).
+  float v_leax = 0.0f; ///< \brief The linear speed [mm/s] of external axes.
+  float v_reax = 0.0f; ///< \brief The rotational speed [degrees/s] of external axes.
+};
+
+static_assert(std::is_trivially_copyable<RobTarget>::value, "typed RAPID records must be trivially copyable");
+static_assert(std::is_trivially_copyable<JointTarget>::value, "typed RAPID records must be trivially copyable");
+static_assert(std::is_trivially_copyable<ToolData>::value, "typed RAPID records must be trivially copyable");
+static_assert(std::is_trivially_copyable<SpeedData>::value, "typed RAPID records must be trivially copyable");
+} // end namespace rapid
+
+/***********************************************************************************************************************
+ * Schemas of the typed RAPID records
+ */
+
+template <>
+struct RAPIDSchema<rapid::RobJoint>
+{
+  static constexpr const char* TYPE = "robjoint";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::RobJoint::rax_1, &rapid::RobJoint::rax_2,
+                                                 &rapid::RobJoint::rax_3, &rapid::RobJoint::rax_4,
+                                                 &rapid::RobJoint::rax_5, &rapid::RobJoint::rax_6);
+};
+
+template <>
+struct RAPIDSchema<rapid::ExtJoint>
+{
+  static constexpr const char* TYPE = "extjoint";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::ExtJoint::eax_a, &rapid::ExtJoint::eax_b,
+                                                 &rapid::ExtJoint::eax_c, &rapid::ExtJoint::eax_d,
+                                                 &rapid::ExtJoint::eax_e, &rapid::ExtJoint::eax_f);
+};
+
+template <>
+struct RAPIDSchema<rapid::JointTarget>
+{
+  static constexpr const char* TYPE = "jointtarget";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::JointTarget::robax, &rapid::JointTarget::extax);
+};
+
+template <>
+struct RAPIDSchema<rapid::Pos>
+{
+  static constexpr const char* TYPE = "pos";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::Pos::x, &rapid::Pos::y, &rapid::Pos::z);
+};
+
+template <>
+struct RAPIDSchema<rapid::Orient>
+{
+  static constexpr const char* TYPE = "orient";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::Orient::q1, &rapid::Orient::q2,
+                                                 &rapid::Orient::q3, &rapid::Orient::q4);
+};
+
+template <>
+struct RAPIDSchema<rapid::Pose>
+{
+  static constexpr const char* TYPE = "pose";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::Pose::pos, &rapid::Pose::rot);
+};
+
+template <>
+struct RAPIDSchema<rapid::ConfData>
+{
+  static constexpr const char* TYPE = "confdata";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::ConfData::cf1, &rapid::ConfData::cf4,
+                                                 &rapid::ConfData::cf6, &rapid::ConfData::cfx);
+};
+
+template <>
+struct RAPIDSchema<rapid::RobTarget>
+{
+  static constexpr const char* TYPE = "robtarget";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::RobTarget::pos, &rapid::RobTarget::orient,
+                                                 &rapid::RobTarget::robconf, &rapid::RobTarget::extax);
+};
+
+template <>
+struct RAPIDSchema<rapid::LoadData>
+{
+  static constexpr const char* TYPE = "loaddata";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::LoadData::mass, &rapid::LoadData::cog,
+                                                 &rapid::LoadData::aom, &rapid::LoadData::ix,
+                                                 &rapid::LoadData::iy, &rapid::LoadData::iz);
+};
+
+template <>
+struct RAPIDSchema<rapid::ToolData>
+{
+  static constexpr const char* TYPE = "tooldata";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::ToolData::robhold, &rapid::ToolData::tframe,
+                                                 &rapid::ToolData::tload);
+};
+
+template <>
+struct RAPIDSchema<rapid::WObjData>
+{
+  static constexpr const char* TYPE = "wobjdata";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::WObjData::robhold, &rapid::WObjData::ufprog,
+                                                 &rapid::WObjData::ufmec, &rapid::WObjData::uframe,
+                                                 &rapid::WObjData::oframe);
+};
+
+template <>
+struct RAPIDSchema<rapid::SpeedData>
+{
+  static constexpr const char* TYPE = "speeddata";
+  static constexpr auto FIELDS = std::make_tuple(&rapid::SpeedData::v_tcp, &rapid::SpeedData::v_ori,
+                                                 &rapid::SpeedData::v_leax, &rapid::SpeedData::v_reax);
+};
+
+/***********************************************************************************************************************
+ * Schemas of the polymorphic RAPID records (see rws_rapid.h), which generate their parse and appendString methods
+ */
+
+template <>
+struct RAPIDSchema<RobJoint>
+{
+  static constexpr const char* TYPE = "robjoint";
+  static constexpr auto FIELDS = std::make_tuple(&RobJoint::rax_1, &RobJoint::rax_2, &RobJoint::rax_3, &RobJoint::rax_4,
+                                                 &RobJoint::rax_5, &RobJoint::rax_6);
+};
+
+template <>
+struct RAPIDSchema<ExtJoint>
+{
+  static constexpr const char* TYPE = "extjoint";
+  static constexpr auto FIELDS = std::make_tuple(&ExtJoint::eax_a, &ExtJoint::eax_b, &ExtJoint::eax_c, &ExtJoint::eax_d,
+                                                 &ExtJoint::eax_e, &ExtJoint::eax_f);
+};
+
+template <>
+struct RAPIDSchema<JointTarget>
+{
+  static constexpr const char* TYPE = "jointtarget";
+  static constexpr auto FIELDS = std::make_tuple(&JointTarget::robax, &JointTarget::extax);
+};
+
+template <>
+struct RAPIDSchema<Pos>
+{
+  static constexpr const char* TYPE = "pos";
+  static constexpr auto FIELDS = std::make_tuple(&Pos::x, &Pos::y, &Pos::z);
+};
+
+template <>
+struct RAPIDSchema<Orient>
+{
+  static constexpr const char* TYPE = "orient";
+  static constexpr auto FIELDS = std::make_tuple(&Orient::q1, &Orient::q2, &Orient::q3, &Orient::q4);
+};
+
+template <>
+struct RAPIDSchema<Pose>
+{
+  static constexpr const char* TYPE = "pose";
+  static constexpr auto FIELDS = std::make_tuple(&Pose::pos, &Pose::rot);
+};
+
+template <>
+struct RAPIDSchema<ConfData>
+{
+  static constexpr const char* TYPE = "confdata";
+  static constexpr auto FIELDS = std::make_tuple(&ConfData::cf1, &ConfData::cf4, &ConfData::cf6, &ConfData::cfx);
+};
+
+template <>
+struct RAPIDSchema<RobTarget>
+{
+  static constexpr const char* TYPE = "robtarget";
+  static constexpr auto FIELDS = std::make_tuple(&RobTarget::pos, &RobTarget::orient, &RobTarget::robconf,
+                                                 &RobTarget::extax);
+};
+
+template <>
+struct RAPIDSchema<LoadData>
+{
+  static constexpr const char* TYPE = "loaddata";
+  static constexpr auto FIELDS = std::make_tuple(&LoadData::mass, &LoadData::cog, &LoadData::aom, &LoadData::ix,
+                                                 &LoadData::iy, &LoadData::iz);
+};
+
+template <>
+struct RAPIDSchema<ToolData>
+{
+  static constexpr const char* TYPE = "tooldata";
+  static constexpr auto FIELDS = std::make_tuple(&ToolData::robhold, &ToolData::tframe, &ToolData::tload);
+};
+
+template <>
+struct RAPIDSchema<WObjData>
+{
+  static constexpr const char* TYPE = "wobjdata";
+  static constexpr auto FIELDS = std::make_tuple(&WObjData::robhold, &WObjData::ufprog, &WObjData::ufmec,
+                                                 &WObjData::uframe, &WObjData::oframe);
+};
+
+template <>
+struct RAPIDSchema<SpeedData>
+{
+  static constexpr const char* TYPE = "speeddata";
+  static constexpr auto FIELDS = std::make_tuple(&SpeedData::v_tcp, &SpeedData::v_ori, &SpeedData::v_leax,
+                                                 &SpeedData::v_reax);
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
@@ -0,0 +1,590 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A dynamically typed RAPID value, for symbols whose type is only known at runtime.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_RAPID_VALUE_H
+#define RWS_RAPID_VALUE_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Poco/Types.h"
+
+#include "rws_rapid.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A struct for describing a RAPID data type, e.g. as reported by the robot controller's symbol properties.
+ */
+struct RAPIDTypeDescriptor
+{
+  /**
+   * \brief An enum for the kinds of RAPID data types.
+   */
+  enum Kind
+  {
+    KIND_NUM,    ///< \brief RAPID num (stored as a double, formatted as a float).
+    KIND_DNUM,   ///< \brief RAPID dnum.
+    KIND_BOOL,   ///< \brief RAPID bool.
+    KIND_STRING, ///< \brief RAPID string.
+    KIND_ATOMIC, ///< \brief Any other atomic type (e.g. an alias or an enumeration), kept as its raw text.
+    KIND_RECORD  ///< \brief RAPID record.
+  };
+
+  /**
+   * \brief A struct for representing a record component.
+   */
+  struct Component
+  {
+    /**
+     * \brief The component's name.
+     */
+    std::string name;
+
+    /**
+     * \brief The component's type.
+     */
+    std::shared_ptr<const RAPIDTypeDescriptor> p_type;
+  };
+
+  /**
+   * \brief A constructor.
+   *
+   * \param name specifying the type's name (e.g. "robtarget").
+   * \param kind specifying the type's kind.
+   */
+  RAPIDTypeDescriptor(const std::string& name = "", const Kind kind = KIND_ATOMIC) : name(name), kind(kind) {}
+
+  /**
+   * \brief A method for adding a record component.
+   *
+   * \param component_name specifying the component's name.
+   * \param p_component_type specifying the component's type.
+   */
+  void addComponent(const std::string& component_name,
+                    const std::shared_ptr<const RAPIDTypeDescriptor>& p_component_type);
+
+  /**
+   * \brief A method for finding a record component.
+   *
+   * \param component_name specifying the component's name.
+   *
+   * \return int containing the component's index (-1 if not found).
+   */
+  int findComponent(std::string_view component_name) const;
+
+  /**
+   * \brief A method for retrieving the descriptor of a built-in RAPID type with a native representation.
+   *
+   * \param type_name specifying the type's name (i.e. "num", "dnum", "bool" or "string").
+   *
+   * \return std::shared_ptr<const RAPIDTypeDescriptor> containing the descriptor (null for any other type).
+   */
+  static std::shared_ptr<const RAPIDTypeDescriptor> getBuiltIn(std::string_view type_name);
+
+  /**
+   * \brief The type's name.
+   */
+  std::string name;
+
+  /**
+   * \brief The type's kind.
+   */
+  Kind kind;
+
+  /**
+   * \brief The record components (in RAPID order).
+   */
+  std::vector<Component> components;
+
+  /**
+   * \brief Index of the record components, by name.
+   */
+  std::map<std::string, int, std::less<>> component_indices;
+};
+
+/**
+ * \brief A class for representing any RAPID value, parsed with a type descriptor (e.g. of a user-defined record).
+ *
+ * The value is stored as a compact tree in an arena: all nodes live in one vector (the components/elements of a
+ * record/array are contiguous), and all string values in one text buffer. Access is path based, e.g.:
+ *
+ *   value["trans"]["x"].asNumber()
+ *   value["speeds"][2].setNumber(500.0)
+ *
+ * Note: References are invalidated by parsing, and string views (e.g. from asString) by parsing and by any setString
+ * call (on any node), since the text buffer may be rewritten.
+ */
+class RAPIDValue : public RAPIDSymbolDataAbstract
+{
+private:
+  /**
+   * \brief A struct for representing a node in the arena.
+   */
+  struct Node
+  {
+    /**
+     * \brief A struct for representing a range of child nodes, or of text in the text buffer.
+     */
+    struct Span
+    {
+      /**
+       * \brief Index of the first child node (or the first character).
+       */
+      Poco::UInt32 first;
+
+      /**
+       * \brief The number of child nodes (or characters).
+       */
+      Poco::UInt32 count;
+    };
+
+    /**
+     * \brief The node's type (for arrays, the element type).
+     */
+    const RAPIDTypeDescriptor* p_type;
+
+    /**
+     * \brief The node's remaining array dimensions (zero if it isn't an array).
+     */
+    unsigned int dimensions;
+
+    /**
+     * \brief The node's data, as given by its type (and dimensions).
+     */
+    union
+    {
+      double number;
+      bool flag;
+      Span span;
+    } data;
+  };
+
+public:
+  class Ref;
+
+  /**
+   * \brief A class for referencing a (read-only) node in a RAPID value.
+   */
+  class ConstRef
+  {
+  public:
+    /**
+     * \brief Operator for accessing a record component by name.
+     *
+     * \param component_name specifying the component's name.
+     *
+     * \return ConstRef referencing the component (invalid if not found).
+     */
+    ConstRef operator[](std::string_view component_name) const;
+
+    /**
+     * \brief Operator for accessing a record component or an array element by position.
+     *
+     * \param index specifying the position (zero based).
+     *
+     * \return ConstRef referencing the component/element (invalid if out of range).
+     */
+    ConstRef operator[](const size_t index) const;
+
+    /**
+     * \brief A method for checking if the reference is valid.
+     *
+     * \return bool indicating if the reference is valid.
+     */
+    bool isValid() const { return p_value_ != 0; }
+
+    /**
+     * \brief A method for checking if the referenced node is an array.
+     *
+     * \return bool indicating if the node is an array.
+     */
+    bool isArray() const;
+
+    /**
+     * \brief A method for retrieving the type of the referenced node (for arrays, the element type).
+     *
+     * \return const RAPIDTypeDescriptor* containing the type (null if the reference is invalid).
+     */
+    const RAPIDTypeDescriptor* getType() const;
+
+    /**
+     * \brief A method for retrieving the number of components/elements of the referenced record/array.
+     *
+     * \return size_t containing the number of components/elements (zero for other nodes).
+     */
+    size_t size() const;
+
+    /**
+     * \brief A method for retrieving the value of a num/dnum node.
+     *
+     * \return double containing the value (zero for other nodes).
+     */
+    double asNumber() const;
+
+    /**
+     * \brief A method for retrieving the value of a bool node.
+     *
+     * \return bool containing the value (false for other nodes).
+     */
+    bool asBool() const;
+
+    /**
+     * \brief A method for retrieving the value of a string node (without quotation marks), or the raw text of another
+     *        atomic node.
+     *
+     * \return std::string_view viewing the value (empty for other nodes), valid until the next parse or setString.
+     */
+    std::string_view asString() const;
+
+    /**
+     * \brief A method for constructing the RAPID value string of the referenced node.
+     *
+     * \return std::string containing the constructed string.
+     */
+    std::string constructString() const;
+
+  protected:
+    friend class RAPIDValue;
+
+    /**
+     * \brief A constructor.
+     *
+     * \param p_value for the referenced value (null for an invalid reference).
+     * \param index for the referenced node's index in the arena.
+     */
+    ConstRef(const RAPIDValue* p_value, const Poco::UInt32 index) : p_value_(p_value), index_(index) {}
+
+    /**
+     * \brief A method for retrieving the referenced node.
+     *
+     * \return const Node& reference to the node.
+     */
+    const Node& node() const { return p_value_->nodes_[index_]; }
+
+    /**
+     * \brief The referenced value.
+     */
+    const RAPIDValue* p_value_;
+
+    /**
+     * \brief The referenced node's index in the arena.
+     */
+    Poco::UInt32 index_;
+  };
+
+  /**
+   * \brief A class for referencing a (modifiable) node in a RAPID value.
+   */
+  class Ref : public ConstRef
+  {
+  public:
+    /**
+     * \brief Operator for accessing a record component by name.
+     *
+     * \param component_name specifying the component's name.
+     *
+     * \return Ref referencing the component (invalid if not found).
+     */
+    Ref operator[](std::string_view component_name) const { return Ref(ConstRef::operator[](component_name)); }
+
+    /**
+     * \brief Operator for accessing a record component or an array element by position.
+     *
+     * \param index specifying the position (zero based).
+     *
+     * \return Ref referencing the component/element (invalid if out of range).
+     */
+    Ref operator[](const size_t index) const { return Ref(ConstRef::operator[](index)); }
+
+    /**
+     * \brief A method for setting the value of a num/dnum node.
+     *
+     * \param value specifying the new value.
+     *
+     * \return bool indicating if the value was set (i.e. if the node is a num/dnum).
+     */
+    bool setNumber(const double value) const;
+
+    /**
+     * \brief A method for setting the value of a bool node.
+     *
+     * \param value specifying the new value.
+     *
+     * \return bool indicating if the value was set (i.e. if the node is a bool).
+     */
+    bool setBool(const bool value) const;
+
+    /**
+     * \brief A method for setting the value of a string node (without quotation marks), or the raw text of another
+     *        atomic node.
+     *
+     * Note: This invalidates all string views into the value (the value may itself view the value's text).
+     *
+     * \param value specifying the new value.
+     *
+     * \return bool indicating if the value was set (i.e. if the node is a string or another atomic).
+     */
+    bool setString(std::string_view value) const;
+
+  private:
+    friend class RAPIDValue;
+
+    /**
+     * \brief A constructor.
+     *
+     * \param other for the reference to make modifiable (must reference a non-const value).
+     */
+    explicit Ref(const ConstRef& other) : ConstRef(other) {}
+
+    /**
+     * \brief A method for retrieving the referenced node, for modification.
+     *
+     * \return Node& reference to the node.
+     */
+    Node& mutableNode() const { return const_cast<RAPIDValue*>(p_value_)->nodes_[index_]; }
+  };
+
+  /**
+   * \brief A default constructor (without a type descriptor, i.e. parsing fails until one is set).
+   */
+  RAPIDValue() : number_of_dimensions_(0), unused_text_(0) {}
+
+  /**
+   * \brief A constructor.
+   *
+   * \param p_type specifying the value's type.
+   * \param number_of_dimensions specifying the value's array dimensions (zero if it isn't an array).
+   */
+  RAPIDValue(const std::shared_ptr<const RAPIDTypeDescriptor>& p_type, const unsigned int number_of_dimensions = 0);
+
+  /**
+   * \brief A method for resetting the value, with a (new) type descriptor.
+   *
+   * \param p_type specifying the value's type.
+   * \param number_of_dimensions specifying the value's array dimensions (zero if it isn't an array).
+   */
+  void reset(const std::shared_ptr<const RAPIDTypeDescriptor>& p_type, const unsigned int number_of_dimensions = 0);
+
+  /**
+   * \brief A method for retrieving the value's type descriptor.
+   *
+   * \return std::shared_ptr<const RAPIDTypeDescriptor> containing the descriptor.
+   */
+  const std::shared_ptr<const RAPIDTypeDescriptor>& getTypeDescriptor() const { return p_type_; }
+
+  /**
+   * \brief A method for retrieving a reference to the value's root node.
+   *
+   * \return ConstRef referencing the root (invalid if nothing has been parsed).
+   */
+  ConstRef root() const { return ConstRef(nodes_.empty() ? 0 : this, 0); }
+
+  /**
+   * \brief A method for retrieving a reference to the value's root node.
+   *
+   * \return Ref referencing the root (invalid if nothing has been parsed).
+   */
+  Ref root() { return Ref(ConstRef(nodes_.empty() ? 0 : this, 0)); }
+
+  /**
+   * \brief Operator for accessing a record component of the root by name.
+   *
+   * \param component_name specifying the component's name.
+   *
+   * \return ConstRef referencing the component (invalid if not found).
+   */
+  ConstRef operator[](std::string_view component_name) const { return root()[component_name]; }
+
+  /**
+   * \brief Operator for accessing a record component of the root by name.
+   *
+   * \param component_name specifying the component's name.
+   *
+   * \return Ref referencing the component (invalid if not found).
+   */
+  Ref operator[](std::string_view component_name) { return root()[component_name]; }
+
+  /**
+   * \brief Operator for accessing a record component or an array element of the root by position.
+   *
+   * \param index specifying the position (zero based).
+   *
+   * \return ConstRef referencing the component/element (invalid if out of range).
+   */
+  ConstRef operator[](const size_t index) const { return root()[index]; }
+
+  /**
+   * \brief Operator for accessing a record component or an array element of the root by position.
+   *
+   * \param index specifying the position (zero based).
+   *
+   * \return Ref referencing the component/element (invalid if out of range).
+   */
+  Ref operator[](const size_t index) { return root()[index]; }
+
+  /**
+   * \brief A method for retrieving the name of the value's data type.
+   *
+   * \return std::string containing the data type name (empty if there is no type descriptor).
+   */
+  std::string getType() const;
+
+  /**
+   * \brief A method for parsing a RAPID symbol data value string.
+   *
+   * \param value_string containing the string to parse.
+   */
+  void parseString(const std::string& value_string);
+
+  /**
+   * \brief A method for constructing a RAPID symbol data value string.
+   *
+   * \return std::string containing the constructed string.
+   */
+  std::string constructString() const;
+
+  /**
+   * \brief A method for appending the RAPID symbol data value string to an output string.
+   *
+   * \param output for the string to append to.
+   */
+  void appendString(std::string& output) const;
+
+  /**
+   * \brief A method for parsing the value's part of a RAPID symbol data value string, with a (single pass) parser.
+   *
+   * \param parser for the parser, positioned at the value.
+   */
+  void parse(RAPIDParser& parser);
+
+  /**
+   * \brief A method for parsing a complete RAPID symbol data value string into a temporary value (with the same type
+   *        descriptor), which replaces the value only if the parsing succeeds.
+   *
+   * \param parser for the parser, positioned at the start of the input.
+   *
+   * \return bool indicating if the input was parsed without errors.
+   */
+  bool tryParse(RAPIDParser& parser);
+
+private:
+  /**
+   * \brief A method for parsing a node (and its children).
+   *
+   * \param parser for the parser, positioned at the node's value.
+   * \param index for the node's index in the arena.
+   * \param p_type for the node's type.
+   * \param dimensions for the node's remaining array dimensions.
+   */
+  void parseNode(RAPIDParser& parser,
+                 const Poco::UInt32 index,
+                 const RAPIDTypeDescriptor* p_type,
+                 const unsigned int dimensions);
+
+  /**
+   * \brief A method for appending a node's RAPID value string to an output string.
+   *
+   * \param output for the string to append to.
+   * \param index for the node's index in the arena.
+   */
+  void appendNode(std::string& output, const Poco::UInt32 index) const;
+
+  /**
+   * \brief A method for allocating contiguous child nodes in the arena.
+   *
+   * \param count for the number of child nodes.
+   *
+   * \return Poco::UInt32 containing the index of the first child node.
+   */
+  Poco::UInt32 allocateNodes(const size_t count);
+
+  /**
+   * \brief A method for storing text in the text buffer.
+   *
+   * \param text for the text to store.
+   *
+   * \return Node::Span containing the text's range in the buffer.
+   */
+  Node::Span storeText(std::string_view text);
+
+  /**
+   * \brief A method for compacting the text buffer, i.e. for removing the text that no node references anymore.
+   */
+  void compactText();
+
+  /**
+   * \brief The value's type.
+   */
+  std::shared_ptr<const RAPIDTypeDescriptor> p_type_;
+
+  /**
+   * \brief The value's array dimensions (zero if it isn't an array).
+   */
+  unsigned int number_of_dimensions_;
+
+  /**
+   * \brief The arena of nodes (the root is the first node).
+   */
+  std::vector<Node> nodes_;
+
+  /**
+   * \brief The text buffer, for string values and raw atomic values.
+   */
+  std::string text_;
+
+  /**
+   * \brief The number of characters in the text buffer that no node references anymore (e.g. replaced strings).
+   */
+  size_t unused_text_;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
@@ -0,0 +1,261 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A fixed-size, preallocated log of RWS requests.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_REQUEST_LOG_H
+#define RWS_REQUEST_LOG_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Poco/Types.h"
+
+#include "rws_endpoints.h"
+#include "rws_poco_client.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for a fixed-size log of RWS requests.
+ *
+ * The log is a preallocated ring of compact, trivially copyable records (i.e. no allocations when logging), which
+ * are only formatted to text when the log is read. Optionally, the first bytes of each response's content are
+ * captured as well (into a preallocated buffer).
+ */
+class RWSRequestLog
+{
+public:
+  /**
+   * \brief Static constant for the maximum number of URI characters kept in a record.
+   */
+  static const size_t URI_SIZE = 96;
+
+  /**
+   * \brief A struct for a logged request.
+   */
+  struct Record
+  {
+    /**
+     * \brief The time when the request was logged [microseconds since the Unix epoch].
+     */
+    Poco::Int64 timestamp;
+
+    /**
+     * \brief Duration of the communication [microseconds].
+     */
+    Poco::Int64 duration;
+
+    /**
+     * \brief Number of bytes in the request's content.
+     */
+    Poco::UInt64 request_bytes;
+
+    /**
+     * \brief Number of bytes in the response's (or WebSocket frame's) content.
+     */
+    Poco::UInt64 response_bytes;
+
+    /**
+     * \brief Number of response content bytes kept in the record's capture.
+     */
+    Poco::UInt32 captured_bytes;
+
+    /**
+     * \brief Flags of a received WebSocket frame.
+     */
+    Poco::Int32 websocket_flags;
+
+    /**
+     * \brief The HTTP response status.
+     */
+    Poco::UInt16 http_status;
+
+    /**
+     * \brief The endpoint's id (see EndpointDescriptor::Id).
+     */
+    Poco::UInt8 endpoint_id;
+
+    /**
+     * \brief The request method (see EndpointDescriptor::Method).
+     */
+    Poco::UInt8 method;
+
+    /**
+     * \brief The general status of the communication (see POCOClient::POCOResult::GeneralStatus).
+     */
+    Poco::UInt8 general_status;
+
+    /**
+     * \brief The request's URI (null-terminated, and truncated if too long).
+     */
+    char uri[URI_SIZE];
+  };
+
+  /**
+   * \brief A constructor.
+   *
+   * \param capacity for the number of records kept in the log.
+   * \param capture_limit for the number of response content bytes kept per record (zero disables the capture).
+   */
+  RWSRequestLog(const size_t capacity, const size_t capture_limit);
+
+  /**
+   * \brief A method for logging a communication result.
+   *
+   * \param endpoint describing the endpoint that was requested.
+   * \param poco_result containing the result of the communication.
+   */
+  void add(const EndpointDescriptor& endpoint, const POCOClient::POCOResult& poco_result);
+
+  /**
+   * \brief A method for setting the number of response content bytes kept per record.
+   *
+   * \note This clears the log.
+   *
+   * \param capture_limit for the number of bytes (zero disables the capture).
+   */
+  void setCaptureLimit(const size_t capture_limit);
+
+  /**
+   * \brief A method for retrieving copies of the logged records.
+   *
+   * \return std::vector<Record> containing the records, the most recent first.
+   */
+  std::vector<Record> getRecords();
+
+  /**
+   * \brief A method for retrieving the log as a text string.
+   *
+   * \param verbose indicating if the log text should be verbose (i.e. include the captured content) or not.
+   *
+   * \return std::string containing the log text. An empty text string is returned if the log is empty.
+   */
+  std::string getText(const bool verbose = false);
+
+  /**
+   * \brief A method for retrieving only the most recently logged request as a text string.
+   *
+   * \param verbose indicating if the log text should be verbose (i.e. include the captured content) or not.
+   *
+   * \return std::string containing the log text. An empty text string is returned if the log is empty.
+   */
+  std::string getTextLatestEvent(const bool verbose = false);
+
+  /**
+   * \brief A method for making a record of a communication result.
+   *
+   * \param endpoint describing the endpoint that was requested.
+   * \param poco_result containing the result of the communication.
+   * \param p_capture for a buffer that receives the first bytes of the response's content (null for no capture).
+   * \param capture_limit for the size of the capture buffer.
+   *
+   * \return Record containing the record.
+   */
+  static Record makeRecord(const EndpointDescriptor& endpoint,
+                           const POCOClient::POCOResult& poco_result,
+                           char* p_capture,
+                           const size_t capture_limit);
+
+  /**
+   * \brief A method for formatting a record as text.
+   *
+   * \param record for the record.
+   * \param p_capture for the record's captured response content (null if none was captured).
+   * \param verbose indicating if the captured content should be included or not.
+   * \param indent for indentation.
+   *
+   * \return std::string containing the text representation.
+   */
+  static std::string formatRecord(const Record& record,
+                                  const char* p_capture,
+                                  const bool verbose = false,
+                                  const size_t indent = 0);
+
+private:
+  /**
+   * \brief A method for formatting a record in the ring as text.
+   *
+   * \param index for the record's index in the ring.
+   * \param verbose indicating if the captured content should be included or not.
+   * \param indent for indentation.
+   *
+   * \return std::string containing the text representation.
+   */
+  std::string format(const size_t index, const bool verbose, const size_t indent) const;
+
+  /**
+   * \brief A mutex for protecting the log.
+   */
+  std::mutex mutex_;
+
+  /**
+   * \brief The ring of records.
+   */
+  std::vector<Record> records_;
+
+  /**
+   * \brief The captured response contents, with capture_limit_ bytes reserved per record.
+   */
+  std::vector<char> captures_;
+
+  /**
+   * \brief The number of response content bytes kept per record.
+   */
+  size_t capture_limit_;
+
+  /**
+   * \brief The ring index where the next record is written.
+   */
+  size_t next_;
+
+  /**
+   * \brief The number of records in the log.
+   */
+  size_t size_;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
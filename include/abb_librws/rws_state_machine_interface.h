@@ -642,7 +642,7 @@ public:
    *
    * \param ip_address specifying the robot controller's IP address.
    */
-  RWSStateMachineInterface(const std::string ip_address, const Poco::Net::Context::Ptr ptrContext)
+  RWSStateMachineInterface(const std::string& ip_address, const Poco::Net::Context::Ptr ptrContext)
   :
   RWSInterface(ip_address,
                SystemConstants::General::DEFAULT_PORT_NUMBER,
@@ -659,7 +659,7 @@ public:
    * \param username for the username to the RWS authentication process.
    * \param password for the password to the RWS authentication process.
    */
-  RWSStateMachineInterface(const std::string ip_address, const std::string username, const std::string password, const Poco::Net::Context::Ptr ptrContext)
+  RWSStateMachineInterface(const std::string& ip_address, const std::string& username, const std::string& password, const Poco::Net::Context::Ptr ptrContext)
   :
   RWSInterface(ip_address,
                SystemConstants::General::DEFAULT_PORT_NUMBER,
@@ -675,7 +675,7 @@ public:
    * \param ip_address specifying the robot controller's IP address.
    * \param port for the port used by the RWS server.
    */
-  RWSStateMachineInterface(const std::string ip_address, const unsigned short port, const Poco::Net::Context::Ptr ptrContext)
+  RWSStateMachineInterface(const std::string& ip_address, const unsigned short port, const Poco::Net::Context::Ptr ptrContext)
   :
   RWSInterface(ip_address,
                port,
@@ -693,10 +693,10 @@ public:
    * \param username for the username to the RWS authentication process.
    * \param password for the password to the RWS authentication process.
    */
-  RWSStateMachineInterface(const std::string ip_address,
+  RWSStateMachineInterface(const std::string& ip_address,
                            const unsigned short port,
-                           const std::string username,
-                           const std::string password,
+                           const std::string& username,
+                           const std::string& password,
                            const Poco::Net::Context::Ptr ptrContext)
   :
   RWSInterface(ip_address,
@@ -822,17 +822,20 @@ private:
        *
        * \return EGMActions indicating the current EGM action.
        */
-      EGMActions getCurrentAction(const std::string task) const;
+      EGMActions getCurrentAction(const std::string& task) const;
 
       /**
        * \brief Get the settings for the EGM RAPID instructions.
        *
        * \param task specifying the RAPID task.
        * \param p_settings for storing the retrieved data.
+       * \param p_snapshot for storing a snapshot of the retrieved data (for delta writes with setSettings), if not null.
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool getSettings(const std::string task, EGMSettings* p_settings) const; // STRUCTURE containing CONFIGURATION
+      bool getSettings(const std::string& task,
+                       EGMSettings* p_settings,
+                       RAPIDSnapshot* p_snapshot = 0) const; // STRUCTURE containing CONFIGURATION
                       // param 1 = input i.e. specify the "task" for which wish to retrieve information
                       // param 2 = output i.e. container for the obtained task information (pos/vel modes, speed set, ..)
 
@@ -841,10 +844,12 @@ private:
        *
        * \param task specifying the RAPID task.
        * \param settings containing the new data.
+       * \param p_snapshot for a snapshot of the last read or written settings, if not null. Then only the changed
+       *                   settings are written (nothing if none has changed), and the snapshot is updated.
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool setSettings(const std::string task, EGMSettings settings) const;
+      bool setSettings(const std::string& task, EGMSettings settings, RAPIDSnapshot* p_snapshot = 0) const;
 
       /**
        * \brief Signal the StateMachine AddIn to start EGM joint motions.
@@ -894,7 +899,7 @@ private:
        *
        * \return States indicating the current state of the StateMachine.
        */
-      States getCurrentState(const std::string task) const;
+      States getCurrentState(const std::string& task) const;
 
       /**
        * \brief Checks if a motion task is in the idle state or not.
@@ -903,7 +908,7 @@ private:
        *
        * \return TriBool indicating if the state is idle or not.
        */
-      TriBool isStateIdle(const std::string task) const;
+      TriBool isStateIdle(const std::string& task) const;
 
       /**
        * \brief Checks if a mechanical unit is stationary or not.
@@ -912,7 +917,7 @@ private:
        *
        * \return TriBool indicating if the mechanical unit is stationary or not.
        */
-      TriBool isStationary(const std::string mechanical_unit) const;
+      TriBool isStationary(const std::string& mechanical_unit) const;
 
     private:
       /**
@@ -943,8 +948,8 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool runCallByVar(const std::string task,
-                        const std::string routine_name,
+      bool runCallByVar(const std::string& task,
+                        const std::string& routine_name,
                         const unsigned int routine_number) const;
 
       /**
@@ -955,7 +960,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool runModuleLoad(const std::string task, const std::string file_path) const;
+      bool runModuleLoad(const std::string& task, const std::string& file_path) const;
 
       /**
        * \brief Request the execution of the predefined RAPID procedure "runModuleUnload".
@@ -965,7 +970,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool runModuleUnload(const std::string task, const std::string file_path) const;
+      bool runModuleUnload(const std::string& task, const std::string& file_path) const;
 
       /**
        * \brief Request the execution of the predefined RAPID procedure "runMoveAbsJ".
@@ -975,7 +980,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool runMoveAbsJ(const std::string task, JointTarget joint_target) const;
+      bool runMoveAbsJ(const std::string& task, JointTarget joint_target) const;
 
       /**
        * \brief Request the execution of the predefined RAPID procedure "runMoveJ".
@@ -985,7 +990,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool runMoveJ(const std::string task, RobTarget rob_target) const;
+      bool runMoveJ(const std::string& task, RobTarget rob_target) const;
 
       /**
        * \brief Request the execution of the predefined RAPID procedure "runMoveToCalibrationPosition".
@@ -994,7 +999,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool runMoveToCalibrationPosition(const std::string task) const;
+      bool runMoveToCalibrationPosition(const std::string& task) const;
 
       /**
        * \brief Set the move speed for the predefined RAPID procedures "runMoveAbsJ" and "runMoveJ".
@@ -1004,7 +1009,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool setMoveSpeed(const std::string task, SpeedData speed_data) const;
+      bool setMoveSpeed(const std::string& task, SpeedData speed_data) const;
 
       /**
        * \brief Set the routine name specifying which routine to run.
@@ -1014,7 +1019,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool setRoutineName(const std::string task, const std::string routine_name) const;
+      bool setRoutineName(const std::string& task, const std::string& routine_name) const;
 
       /**
        * \brief Signal the StateMachine AddIn to run RAPID routine(s).
@@ -1403,7 +1408,7 @@ private:
 
 
 
-      bool Initialize(const std::string task) const;
+      bool Initialize(const std::string& task) const;
 
       bool VacuumOn(uint32_t num_valve) const;
 
@@ -1428,7 +1433,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool getSettings(const std::string task, SGSettings* p_settings) const;
+      bool getSettings(const std::string& task, SGSettings* p_settings) const;
 
       /**
        * \brief Set command input for specifying a SmartGripper's desired command.
@@ -1438,7 +1443,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool setCommandInput(const std::string task, const SGCommands command) const;
+      bool setCommandInput(const std::string& task, const SGCommands command) const;
 
       /**
        * \brief Set the settings for a SmartGripper's RAPID instructions.
@@ -1448,7 +1453,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool setSettings(const std::string task, SGSettings settings) const;
+      bool setSettings(const std::string& task, SGSettings settings) const;
 
       /**
        * \brief Set target position input for specifying where to move a SmartGripper.
@@ -1458,7 +1463,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool setTargetPositionInput(const std::string task, const float position) const;
+      bool setTargetPositionInput(const std::string& task, const float position) const;
 
       /**
        * \brief The RWS interface instance.
@@ -1487,7 +1492,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool getBaseFrame(const std::string task, Pose* p_base_frame) const;
+      bool getBaseFrame(const std::string& task, Pose* p_base_frame) const;
 
       /**
        * \brief Get a motion task's calibration target, extracted during initialization of the task.
@@ -1497,7 +1502,7 @@ private:
        *
        * \return bool indicating if the communication was successful or not.
        */
-      bool getCalibrationTarget(const std::string task, JointTarget* p_calibration_joint_target) const;
+      bool getCalibrationTarget(const std::string& task, JointTarget* p_calibration_joint_target) const;
 
     private:
       /**
@@ -1526,7 +1531,7 @@ private:
        *
        * \return TriBool indicating if the watchdog is active or not.
        */
-      TriBool isActive(const std::string task) const;
+      TriBool isActive(const std::string& task) const;
 
       /**
        * \brief Checks if the watchdog is set to watch an external status signal or not.
@@ -1535,7 +1540,7 @@ private:
        *
        * \return TriBool indicating if the watchdog is set to watch an external status signal or not.
        */
-      TriBool isCheckingExternalStatus(const std::string task) const;
+      TriBool isCheckingExternalStatus(const std::string& task) const;
 
       /**
        * \brief Set the external status signal, which the watchdog can watch.
@@ -1596,7 +1601,7 @@ private:
    *
    * \return bool indicating if the toggling was successful or not.
    */
-  bool toggleIOSignal(const std::string iosignal);
+  bool toggleIOSignal(const std::string& iosignal);
 
   /**
    * \brief Services provided by the StateMachine AddIn.
@@ -0,0 +1,284 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Process-wide tracing of the library's activity as timed spans.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_TRACER_H
+#define RWS_TRACER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Poco/Types.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for tracing the library's activity (e.g. RWSInterface calls and their HTTP requests) as timed spans.
+ *
+ * The tracer is process-wide and disabled by default, in which case a span costs a single atomic load. When enabled,
+ * each thread records its spans into its own preallocated buffer: the owning thread is the only writer, and publishes
+ * each span by storing the buffer's size last, i.e. recording is lock-free (only a thread's first span takes a lock,
+ * to register the thread's buffer). Spans that don't fit in a full buffer are dropped and counted.
+ *
+ * The recorded spans can be exported in the Chrome trace event format (JSON), which can be viewed in e.g. Perfetto
+ * (https://ui.perfetto.dev) or chrome://tracing. Nested spans (e.g. a service call and its HTTP requests) are shown
+ * stacked on the thread's track.
+ */
+class RWSTracer
+{
+public:
+  /**
+   * \brief Static constant for the default number of spans kept per thread.
+   */
+  static const size_t DEFAULT_THREAD_CAPACITY = 16384;
+
+  /**
+   * \brief A class for tracing a scope, from its construction to its destruction.
+   *
+   * Note: The category and name are not copied, they must be string literals (or outlive the tracer's exports).
+   */
+  class Span
+  {
+  public:
+    /**
+     * \brief A constructor, which starts the span (if the tracer is enabled).
+     *
+     * \param category for the span's category (e.g. "RWSInterface").
+     * \param name for the span's name (e.g. the traced method's name).
+     */
+    Span(const char* category, const char* name);
+
+    /**
+     * \brief A destructor, which records the span (if it was started).
+     */
+    ~Span();
+
+  private:
+    /**
+     * \brief Copying a span is not allowed.
+     */
+    Span(const Span&);
+
+    /**
+     * \brief Assigning a span is not allowed.
+     */
+    Span& operator=(const Span&);
+
+    /**
+     * \brief The span's category.
+     */
+    const char* category_;
+
+    /**
+     * \brief The span's name.
+     */
+    const char* name_;
+
+    /**
+     * \brief The span's start [microseconds since the tracer's epoch], or a negative value if it wasn't started.
+     */
+    Poco::Int64 start_;
+  };
+
+  /**
+   * \brief A method for enabling the tracing.
+   *
+   * \param thread_capacity for the number of spans kept per thread (applies to threads that haven't traced yet).
+   */
+  static void enable(const size_t thread_capacity = DEFAULT_THREAD_CAPACITY);
+
+  /**
+   * \brief A method for disabling the tracing. Already recorded spans are kept.
+   */
+  static void disable();
+
+  /**
+   * \brief A method for checking if the tracing is enabled.
+   *
+   * \return bool indicating if the tracing is enabled.
+   */
+  static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * \brief A method for discarding the recorded spans.
+   *
+   * Note: Should only be called while no traced calls are in progress (e.g. after disable()).
+   */
+  static void clear();
+
+  /**
+   * \brief A method for retrieving the number of spans that were dropped because of full buffers.
+   *
+   * \return Poco::UInt64 containing the number of dropped spans.
+   */
+  static Poco::UInt64 getDroppedSpans();
+
+  /**
+   * \brief A method for exporting the recorded spans in the Chrome trace event format.
+   *
+   * \return std::string containing the trace (JSON).
+   */
+  static std::string exportChromeTrace();
+
+  /**
+   * \brief A method for writing the recorded spans, in the Chrome trace event format, to a file.
+   *
+   * \param path for the file's path.
+   *
+   * \return bool indicating if the file was written.
+   */
+  static bool writeChromeTrace(const std::string& path);
+
+private:
+  /**
+   * \brief A struct for a recorded span.
+   */
+  struct Event
+  {
+    /**
+     * \brief The span's category.
+     */
+    const char* category;
+
+    /**
+     * \brief The span's name.
+     */
+    const char* name;
+
+    /**
+     * \brief The span's start [microseconds since the tracer's epoch].
+     */
+    Poco::Int64 start;
+
+    /**
+     * \brief The span's duration [microseconds].
+     */
+    Poco::Int64 duration;
+  };
+
+  /**
+   * \brief A struct for a thread's buffer of recorded spans.
+   */
+  struct ThreadBuffer
+  {
+    /**
+     * \brief A constructor.
+     *
+     * \param id for the thread's (trace) id.
+     * \param capacity for the number of spans the buffer can keep.
+     */
+    ThreadBuffer(const int id, const size_t capacity) : id(id), events(capacity), size(0), dropped(0) {}
+
+    /**
+     * \brief The thread's (trace) id.
+     */
+    const int id;
+
+    /**
+     * \brief The recorded spans (only the first size entries are valid).
+     */
+    std::vector<Event> events;
+
+    /**
+     * \brief The number of recorded spans.
+     */
+    std::atomic<size_t> size;
+
+    /**
+     * \brief The number of dropped spans.
+     */
+    std::atomic<Poco::UInt64> dropped;
+  };
+
+  /**
+   * \brief A method for retrieving the current time.
+   *
+   * \return Poco::Int64 containing the time [microseconds since the tracer's epoch].
+   */
+  static Poco::Int64 now();
+
+  /**
+   * \brief A method for recording a span in the calling thread's buffer.
+   *
+   * \param category for the span's category.
+   * \param name for the span's name.
+   * \param start for the span's start [microseconds since the tracer's epoch].
+   * \param duration for the span's duration [microseconds].
+   */
+  static void record(const char* category, const char* name, const Poco::Int64 start, const Poco::Int64 duration);
+
+  /**
+   * \brief A method for retrieving (and if needed registering) the calling thread's buffer.
+   *
+   * \return ThreadBuffer& reference to the buffer.
+   */
+  static ThreadBuffer& getThreadBuffer();
+
+  /**
+   * \brief Flag indicating if the tracing is enabled.
+   */
+  static std::atomic<bool> enabled_;
+
+  /**
+   * \brief The number of spans kept per (newly registered) thread.
+   */
+  static std::atomic<size_t> thread_capacity_;
+
+  /**
+   * \brief A mutex for protecting the registered buffers.
+   */
+  static std::mutex mutex_;
+
+  /**
+   * \brief The registered buffers (shared with the threads, so that a buffer outlives its thread).
+   */
+  static std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
@@ -44,10 +44,13 @@
  */
 
 #include <sstream>
+#include <utility>
 
+#include "Poco/Exception.h"
 #include "Poco/SAX/InputSource.h"
 
 #include "abb_librws/rws_client.h"
+#include "abb_librws/rws_tracer.h"
 
 namespace abb
 {
@@ -69,7 +72,7 @@ typedef SystemConstants::RWS::XMLAttributes XMLAttributes;
  * Primary methods
  */
 
-void RWSClient::SubscriptionResources::addIOSignal(const std::string iosignal, const Priority priority)
+void RWSClient::SubscriptionResources::addIOSignal(const std::string& iosignal, const Priority priority)
 {
   std::string resource_uri = Resources::RW_IOSYSTEM_SIGNALS;
   resource_uri += "/";
@@ -80,7 +83,7 @@ void RWSClient::SubscriptionResources::addIOSignal(const std::string iosignal, c
   add(resource_uri, priority);
 }
 
-void RWSClient::SubscriptionResources::addRAPIDPersistantVariable(const RAPIDResource resource, const Priority priority)
+void RWSClient::SubscriptionResources::addRAPIDPersistantVariable(const RAPIDResource& resource, const Priority priority)
 {
   std::string resource_uri = Resources::RW_RAPID_SYMBOL_DATA_RAPID;
   resource_uri += "/";
@@ -95,7 +98,7 @@ void RWSClient::SubscriptionResources::addRAPIDPersistantVariable(const RAPIDRes
   add(resource_uri, priority);
 }
 
-void RWSClient::SubscriptionResources::add(const std::string resource_uri, const Priority priority)
+void RWSClient::SubscriptionResources::add(const std::string& resource_uri, const Priority priority)
 {
   resources_.push_back(SubscriptionResource(resource_uri, priority));
 }
@@ -108,388 +111,468 @@ void RWSClient::SubscriptionResources::add(const std::string resource_uri, const
  * Primary methods
  */
 
-RWSClient::RWSResult RWSClient::getConfigurationInstances(const std::string topic, const std::string type)
+RWSClient::RWSResult RWSClient::getConfigurationInstances(const std::string& topic, const std::string& type)
 {
-  uri_ = generateConfigurationPath(topic, type) + Resources::INSTANCES;
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
-
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+  return execute(Endpoints::GET_CONFIGURATION_INSTANCES, {topic, type});
 }
 
-RWSClient::RWSResult RWSClient::getIOSignal(const std::string iosignal)
+RWSClient::RWSResult RWSClient::getIOSignal(const std::string& iosignal)
 {
-  uri_ = generateIOSignalPath(iosignal);
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+  return execute(Endpoints::GET_IO_SIGNAL, {iosignal});
+}
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+RWSClient::RWSResult RWSClient::getMechanicalUnitJointTarget(const std::string& mechunit)
+{
+  return execute(Endpoints::GET_MECHUNIT_JOINTTARGET, {mechunit});
 }
 
-RWSClient::RWSResult RWSClient::getMechanicalUnitJointTarget(const std::string mechunit)
+RWSClient::RWSResult RWSClient::getMechanicalUnitRobTarget(const std::string& mechunit)
 {
-  uri_ = generateMechanicalUnitPath(mechunit) + Resources::JOINTTARGET;
+  return execute(Endpoints::GET_MECHUNIT_ROBTARGET, {mechunit});
+}
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+RWSClient::RWSResult RWSClient::getRAPIDExecution()
+{
+  return execute(Endpoints::GET_RAPID_EXECUTION);
+}
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+RWSClient::RWSResult RWSClient::getRAPIDModulesInfo(const std::string& task)
+{
+  return execute(Endpoints::GET_RAPID_MODULES_INFO, {task});
 }
 
-RWSClient::RWSResult RWSClient::getMechanicalUnitRobTarget(const std::string mechunit)
+RWSClient::RWSResult RWSClient::getRAPIDTasks()
 {
-  uri_ = generateMechanicalUnitPath(mechunit) + Resources::ROBTARGET;
+  return execute(Endpoints::GET_RAPID_TASKS);
+}
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+RWSClient::RWSResult RWSClient::getRobotWareSystem()
+{
+  return execute(Endpoints::GET_ROBOTWARE_SYSTEM);
+}
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+RWSClient::RWSResult RWSClient::getPanelControllerState()
+{
+  return execute(Endpoints::GET_PANEL_CTRLSTATE);
 }
 
-RWSClient::RWSResult RWSClient::getRAPIDExecution()
+RWSClient::RWSResult RWSClient::getPanelOperationMode()
 {
-  uri_ = Resources::RW_RAPID_EXECUTION;
-  
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+  return execute(Endpoints::GET_PANEL_OPMODE);
+}
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+RWSClient::RWSResult RWSClient::getRAPIDSymbolData(const RAPIDResource& resource)
+{
+  return execute(Endpoints::GET_RAPID_SYMBOL_DATA, {resource.task, resource.module, resource.name});
 }
 
-RWSClient::RWSResult RWSClient::getRAPIDModulesInfo(const std::string task)
+RWSClient::RWSResult RWSClient::getRAPIDSymbolData(const RAPIDResource& resource, RAPIDSymbolDataAbstract* p_data)
 {
-  uri_ = Resources::RW_RAPID_TASKS + "/" + task + Resources::MODULES;
+  RWSResult result;
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+  // The cached metadata may be stale (e.g. if a module load redeclared the symbol), so a type mismatch or a parse
+  // failure is retried once with fresh metadata.
+  for (int attempt = 0; p_data && attempt < 2; ++attempt)
+  {
+    RAPIDSymbolMetadata metadata;
+    bool mismatch = false;
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
-}
+    result = getRAPIDSymbolMetadata(resource, &metadata);
 
-RWSClient::RWSResult RWSClient::getRAPIDTasks()
-{
-  uri_ = Resources::RW_RAPID_TASKS;
+    if (!result.success)
+    {
+      break;
+    }
+
+    if (p_data->getType().compare(metadata.data_type) != 0)
+    {
+      result = RWSResult();
+      result.error_message = "getRAPIDSymbolData(...): the symbol's data type (" + metadata.data_type +
+                             ") doesn't match the data's type (" + p_data->getType() + ")";
+      mismatch = true;
+    }
+    else
+    {
+      result = getRAPIDSymbolData(resource);
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+      if (!result.success)
+      {
+        // The symbol may have been removed (or redeclared), so fetch the metadata again on the next read.
+        invalidateRAPIDSymbolMetadata(resource);
+        break;
+      }
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
-}
+      std::string value = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_VALUE);
+      RAPIDParser parser(value);
 
-RWSClient::RWSResult RWSClient::getRobotWareSystem()
-{
-  uri_ = Resources::RW_SYSTEM;
+      if (value.empty())
+      {
+        result.success = false;
+        result.error_message = "getRAPIDSymbolData(...): RAPID value string was empty";
+      }
+      else if (!p_data->tryParse(parser))
+      {
+        // The data is left unchanged (e.g. it isn't half updated).
+        result.success = false;
+        result.error_message = "getRAPIDSymbolData(...): RAPID value string could not be parsed at position " +
+                               std::to_string(parser.getErrorPosition()) + " (" + parser.getErrorMessage() + ")";
+        mismatch = true;
+      }
+    }
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+    if (!mismatch)
+    {
+      break;
+    }
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+    invalidateRAPIDSymbolMetadata(resource);
+  }
+
+  return result;
 }
 
-RWSClient::RWSResult RWSClient::getPanelControllerState()
+RWSClient::RWSResult RWSClient::getRAPIDSymbolProperties(const RAPIDResource& resource)
 {
-  uri_ = Resources::RW_PANEL_CTRLSTATE;
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
-
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+  return execute(Endpoints::GET_RAPID_SYMBOL_PROPERTIES, {resource.task, resource.module, resource.name});
 }
 
-RWSClient::RWSResult RWSClient::getPanelOperationMode()
+RWSClient::RWSResult RWSClient::getRAPIDSymbolData(const RAPIDResource& resource, RAPIDValue* p_value)
 {
-  // std::cout<<"sono in getPanelOperationMode "<< std::endl;
+  RWSResult result;
+
+  // The cached metadata and type descriptors may be stale (e.g. if a module load redeclared the symbol with other
+  // dimensions, or redefined its record type), so a parse failure is retried once with fresh ones.
+  for (int attempt = 0; p_value && attempt < 2; ++attempt)
+  {
+    RAPIDSymbolMetadata metadata;
+    std::shared_ptr<const RAPIDTypeDescriptor> p_descriptor;
+
+    result = getRAPIDSymbolMetadata(resource, &metadata);
 
-  uri_ = Resources::RW_PANEL_OPMODE;
+    if (result.success)
+    {
+      result = getRAPIDTypeDescriptor((metadata.type_url.empty() ? "RAPID/" + metadata.data_type : metadata.type_url),
+                                      &p_descriptor);
+    }
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+    if (!result.success)
+    {
+      break;
+    }
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+    result = getRAPIDSymbolData(resource);
+
+    if (!result.success)
+    {
+      // The symbol may have been removed (or redeclared), so fetch the metadata again on the next read.
+      invalidateRAPIDSymbolMetadata(resource);
+      break;
+    }
+
+    std::string value = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_VALUE);
+    RAPIDParser parser(value);
+    RAPIDValue temp(p_descriptor, metadata.number_of_dimensions);
+
+    // Parse into a temporary value, so that a failure leaves the value unchanged.
+    if (parser.parse(temp))
+    {
+      *p_value = std::move(temp);
+      break;
+    }
+
+    result.success = false;
+    result.error_message = "getRAPIDSymbolData(...): RAPID value string could not be parsed at position " +
+                           std::to_string(parser.getErrorPosition()) + " (" + parser.getErrorMessage() + ")";
+
+    invalidateRAPIDSymbolMetadata();
+  }
+
+  return result;
 }
 
-RWSClient::RWSResult RWSClient::getRAPIDSymbolData(const RAPIDResource resource)
+RWSClient::RWSResult RWSClient::getRAPIDTypeDescriptor(const std::string& type_url,
+                                                       std::shared_ptr<const RAPIDTypeDescriptor>* p_descriptor)
 {
-  uri_ = generateRAPIDDataPath(resource);
+  RWSResult result;
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+  if (p_descriptor)
+  {
+    result = resolveRAPIDTypeDescriptor(type_url, 0, p_descriptor);
+  }
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+  return result;
 }
 
-RWSClient::RWSResult RWSClient::getRAPIDSymbolData(const RAPIDResource resource, RAPIDSymbolDataAbstract* p_data)
+RWSClient::RWSResult RWSClient::getRAPIDSymbolMetadata(const RAPIDResource& resource, RAPIDSymbolMetadata* p_metadata)
 {
   RWSResult result;
-  std::string data_type;
 
-  if (p_data)
+  if (p_metadata)
   {
-    RWSResult temp_result = getRAPIDSymbolProperties(resource);
-    
-    if (temp_result.success)
     {
-      data_type = xmlFindTextContent(temp_result.p_xml_document, XMLAttributes::CLASS_DATTYP);
+      Poco::ScopedLock<Poco::Mutex> lock(symbol_metadata_mutex_);
+      std::map<RAPIDResource, RAPIDSymbolMetadata>::const_iterator it = symbol_metadata_.find(resource);
 
-      if (p_data->getType().compare(data_type) == 0)
+      if (it != symbol_metadata_.end())
       {
-        result = getRAPIDSymbolData(resource);
+        *p_metadata = it->second;
+        result.success = true;
+        return result;
+      }
+    }
 
-        if (result.success)
-        {
-          std::string value = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_VALUE);
-
-          if (!value.empty())
-          {
-            p_data->parseString(value);
-          }
-          else
-          {
-            result.success = false;
-            result.error_message = "getRAPIDSymbolData(...): RAPID value string was empty";
-          }
-        }
+    result = getRAPIDSymbolProperties(resource);
+
+    if (result.success)
+    {
+      RAPIDSymbolMetadata metadata;
+      metadata.data_type = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_DATTYP);
+      metadata.symbol_type = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_SYMTYP);
+      metadata.dimensions = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_DIM);
+      metadata.type_url = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_TYPURL);
+      std::stringstream ss(xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_NDIM));
+      ss >> metadata.number_of_dimensions;
+
+      if (!metadata.data_type.empty())
+      {
+        Poco::ScopedLock<Poco::Mutex> lock(symbol_metadata_mutex_);
+        symbol_metadata_[resource] = metadata;
       }
+
+      *p_metadata = metadata;
     }
   }
 
   return result;
 }
 
-RWSClient::RWSResult RWSClient::getRAPIDSymbolProperties(const RAPIDResource resource)
+bool RWSClient::preloadRAPIDSymbolMetadata(const std::vector<RAPIDResource>& resources)
 {
-  uri_ = generateRAPIDPropertiesPath(resource);
+  bool result = true;
+  RAPIDSymbolMetadata metadata;
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+  for (size_t i = 0; i < resources.size(); ++i)
+  {
+    result = getRAPIDSymbolMetadata(resources[i], &metadata).success && result;
+  }
 
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+  return result;
 }
 
-RWSClient::RWSResult RWSClient::setIOSignal(const std::string iosignal, const std::string value)
+void RWSClient::invalidateRAPIDSymbolMetadata()
 {
-  uri_ = generateIOSignalPath(iosignal) + "/" + Queries::ACTION_SET;
-  // std::cout<<"URI: "<< uri_ << std::endl;
-  content_ = Identifiers::LVALUE + "=" + value;
-  // std::cout<<"content_: "<< content_ << std::endl;
-
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
+  {
+    Poco::ScopedLock<Poco::Mutex> lock(symbol_metadata_mutex_);
+    symbol_metadata_.clear();
+  }
 
-  return evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+  Poco::ScopedLock<Poco::Mutex> lock(type_descriptors_mutex_);
+  type_descriptors_.clear();
 }
 
+void RWSClient::invalidateRAPIDSymbolMetadata(const RAPIDResource& resource)
+{
+  Poco::ScopedLock<Poco::Mutex> lock(symbol_metadata_mutex_);
+  symbol_metadata_.erase(resource);
+}
 
-RWSClient::RWSResult RWSClient::setRAPIDSymbolData(const RAPIDResource resource, const std::string data)
+RWSClient::RWSResult RWSClient::setIOSignal(const std::string& iosignal, const std::string& value)
 {
-  // uri_ = generateRAPIDDataPath(resource) + "?" + Queries::ACTION_SET;
-  uri_ = generateRAPIDDataPath(resource);
-  content_ = Identifiers::VALUE + "=" + data;
+  return execute(Endpoints::SET_IO_SIGNAL, {iosignal}, Identifiers::LVALUE + "=" + value);
+}
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
 
-  return evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+RWSClient::RWSResult RWSClient::setRAPIDSymbolData(const RAPIDResource& resource, const std::string& data)
+{
+  return execute(Endpoints::SET_RAPID_SYMBOL_DATA,
+                 {resource.task, resource.module, resource.name},
+                 Identifiers::VALUE + "=" + data);
 }
 
-RWSClient::RWSResult RWSClient::setRAPIDSymbolData(const RAPIDResource resource, RAPIDSymbolDataAbstract& data)
+RWSClient::RWSResult RWSClient::setRAPIDSymbolData(const RAPIDResource& resource, RAPIDSymbolDataAbstract& data)
 {
   return setRAPIDSymbolData(resource, data.constructString());
 }
 
-RWSClient::RWSResult RWSClient::startRAPIDExecution()
+RWSClient::RWSResult RWSClient::setRAPIDSymbolData(const RAPIDResource& resource,
+                                                   RAPIDSymbolDataAbstract& data,
+                                                   RAPIDSnapshot* p_snapshot,
+                                                   const size_t max_component_writes)
 {
-  uri_ = Resources::RW_RAPID_EXECUTION + "/" + Queries::ACTION_START;
-  content_ = "regain=continue&execmode=continue&cycle=forever&condition=none&stopatbp=disabled&alltaskbytsp=false";
+  RWSResult result;
+  std::string value = data.constructString();
+  std::vector<RAPIDSnapshot::Change> changes;
+
+  if (p_snapshot && !p_snapshot->findChanges(value, &changes))
+  {
+    result.success = true;
+    return result;
+  }
+
+  // Address each changed component (e.g. "name{2}.trans"), via the symbol's type descriptor.
+  std::vector<std::string> names;
+  RAPIDSymbolMetadata metadata;
+  std::shared_ptr<const RAPIDTypeDescriptor> p_descriptor;
+
+  if (!changes.empty() && changes.size() <= max_component_writes && !changes.front().path.empty() &&
+      getRAPIDSymbolMetadata(resource, &metadata).success &&
+      getRAPIDTypeDescriptor((metadata.type_url.empty() ? "RAPID/" + metadata.data_type : metadata.type_url),
+                             &p_descriptor).success)
+  {
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+      std::string name;
+
+      if (!getRAPIDComponentName(resource.name, metadata, *p_descriptor, changes[i].path, &name))
+      {
+        names.clear();
+        break;
+      }
+
+      names.push_back(name);
+    }
+  }
+
+  bool written = !names.empty();
+
+  for (size_t i = 0; i < names.size() && written; ++i)
+  {
+    result = setRAPIDSymbolData(RAPIDResource(resource.task, resource.module, names[i]), changes[i].value);
+    written = result.success;
+  }
+
+  if (!written)
+  {
+    result = setRAPIDSymbolData(resource, value);
+  }
+
+  if (result.success && p_snapshot)
+  {
+    p_snapshot->take(value);
+  }
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
+  return result;
+}
 
-  return evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+RWSClient::RWSResult RWSClient::startRAPIDExecution()
+{
+  return execute(Endpoints::START_RAPID_EXECUTION,
+                 {},
+                 "regain=continue&execmode=continue&cycle=forever&condition=none&stopatbp=disabled&alltaskbytsp=false");
 }
 
 RWSClient::RWSResult RWSClient::stopRAPIDExecution()
 {
-  uri_ = Resources::RW_RAPID_EXECUTION + "/" + Queries::ACTION_STOP;
-  content_ = "stopmode=stop";
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
-
-  return evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+  return execute(Endpoints::STOP_RAPID_EXECUTION, {}, "stopmode=stop");
 }
 
 RWSClient::RWSResult RWSClient::resetRAPIDProgramPointer()
 {
-  uri_ = Resources::RW_RAPID_EXECUTION + "/" + Queries::ACTION_RESETPP;
+  RWSResult result = execute(Endpoints::RESET_RAPID_PROGRAM_POINTER);
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
+  // Resetting the program pointer re-initializes the RAPID program, so the cached symbol metadata may be stale. It is
+  // dropped once the reset is done (a read made during the reset could otherwise refill the cache with stale metadata).
+  invalidateRAPIDSymbolMetadata();
 
-  return evaluatePOCOResult(httpPost(uri_), evaluation_conditions_);
+  return result;
 }
 
 RWSClient::RWSResult RWSClient::setMotorsOn()
 {
-  uri_ = Resources::RW_PANEL_CTRLSTATE;
-  content_ = "ctrl-state=motoron";
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
-
-  return evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+  return execute(Endpoints::SET_PANEL_CTRLSTATE, {}, "ctrl-state=motoron");
 }
 
 RWSClient::RWSResult RWSClient::setMotorsOff()
 {
-  uri_ = Resources::RW_PANEL_CTRLSTATE;
-  content_ = "ctrl-state=motoroff";
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
-
-  return evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+  return execute(Endpoints::SET_PANEL_CTRLSTATE, {}, "ctrl-state=motoroff");
 }
 
-RWSClient::RWSResult RWSClient::setLeadThroughOn(const std::string mechUnit)
+RWSClient::RWSResult RWSClient::setLeadThroughOn(const std::string& mechUnit)
 {
-  uri_ = Resources::RW_MOTIONSYSTEM_MECHUNITS + "/" + mechUnit + Resources::LEADTHROUGH;
-  content_ = "status=active";
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
-
-  return evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+  return execute(Endpoints::SET_LEAD_THROUGH, {mechUnit}, "status=active");
 }
 
-RWSClient::RWSResult RWSClient::setLeadThroughOff(const std::string mechUnit)
+RWSClient::RWSResult RWSClient::setLeadThroughOff(const std::string& mechUnit)
 {
-  uri_ = Resources::RW_MOTIONSYSTEM_MECHUNITS + "/" + mechUnit + Resources::LEADTHROUGH;
-  content_ = "status=inactive";
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
-
-  return evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+  return execute(Endpoints::SET_LEAD_THROUGH, {mechUnit}, "status=inactive");
 }
 
-RWSClient::RWSResult RWSClient::getFile(const FileResource resource, std::string* p_file_content)
+RWSClient::RWSResult RWSClient::getFile(const FileResource& resource, std::string* p_file_content)
 {
   RWSResult rws_result;
-  POCOClient::POCOResult poco_result;
 
   if (p_file_content)
   {
-    uri_ = generateFilePath(resource);
-    poco_result = httpGet(uri_);
-
-    evaluation_conditions_.reset();
-    evaluation_conditions_.parse_message_into_xml = false;
-    evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+    std::string uri = expandEndpointPath(Endpoints::GET_FILE.path_template, {resource.directory, resource.filename});
+    POCOClient::POCOResult poco_result = sendRequest(Endpoints::GET_FILE, uri);
 
-    rws_result = evaluatePOCOResult(poco_result, evaluation_conditions_);
+    rws_result = evaluatePOCOResult(poco_result, Endpoints::GET_FILE);
 
     if (rws_result.success)
     {
-      *p_file_content = poco_result.poco_info.http.response.content;
+      *p_file_content = std::move(poco_result.poco_info.http.response.content);
     }
   }
 
   return rws_result;
 }
 
-RWSClient::RWSResult RWSClient::uploadFile(const FileResource resource, const std::string file_content)
+RWSClient::RWSResult RWSClient::uploadFile(const FileResource& resource, const std::string& file_content)
 {
-  uri_ = generateFilePath(resource);
-  content_ = file_content;
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_CREATED);
-
-  return evaluatePOCOResult(httpPut(uri_, content_), evaluation_conditions_);
+  return execute(Endpoints::UPLOAD_FILE, {resource.directory, resource.filename}, file_content);
 }
 
-RWSClient::RWSResult RWSClient::deleteFile(const FileResource resource)
+RWSClient::RWSResult RWSClient::uploadFile(const FileResource& resource, std::string&& file_content)
 {
-  uri_ = generateFilePath(resource);
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
+  return execute(Endpoints::UPLOAD_FILE, {resource.directory, resource.filename}, std::move(file_content));
+}
 
-  return evaluatePOCOResult(httpDelete(uri_), evaluation_conditions_);
+RWSClient::RWSResult RWSClient::deleteFile(const FileResource& resource)
+{
+  return execute(Endpoints::DELETE_FILE, {resource.directory, resource.filename});
 }
 
-RWSClient::RWSResult RWSClient::startSubscription(SubscriptionResources resources)
+RWSClient::RWSResult RWSClient::startSubscription(const SubscriptionResources& resources)
 {
   RWSResult result;
 
   if (!webSocketExist())
   {
-    std::vector<SubscriptionResources::SubscriptionResource> temp = resources.getResources();
+    const std::vector<SubscriptionResources::SubscriptionResource>& temp = resources.getResources();
 
     // Generate content for a subscription HTTP post request.
-    subscription_content_.str(std::string());
+    std::stringstream subscription_content;
     for (int i = 0; i < temp.size(); ++i)
     {
-      subscription_content_ << "resources=" << i
-                            << "&"
-                            << i << "=" << temp.at(i).resource_uri
-                            << "&"
-                            << i << "-p=" << temp.at(i).priority
-                            << (i < temp.size() - 1 ? "&" : "");
+      subscription_content << "resources=" << i
+                           << "&"
+                           << i << "=" << temp.at(i).resource_uri
+                           << "&"
+                           << i << "-p=" << temp.at(i).priority
+                           << (i < temp.size() - 1 ? "&" : "");
     }
 
     // Make a subscription request.
-    evaluation_conditions_.reset();
-    evaluation_conditions_.parse_message_into_xml = false;
-    evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_CREATED);
-    POCOClient::POCOResult poco_result = httpPost(Services::SUBSCRIPTION, subscription_content_.str());
-    result = evaluatePOCOResult(poco_result, evaluation_conditions_);
+    POCOClient::POCOResult poco_result = sendRequest(Endpoints::START_SUBSCRIPTION,
+                                                     Endpoints::START_SUBSCRIPTION.path_template,
+                                                     subscription_content.str());
+    result = evaluatePOCOResult(poco_result, Endpoints::START_SUBSCRIPTION);
 
     if (result.success)
     {
-      std::string poll = "/poll/";
-      subscription_group_id_ = findSubstringContent(poco_result.poco_info.http.response.header_info, poll, "\n");
-      poll += subscription_group_id_;
+      std::string subscription_group_id = findSubstringContent(poco_result.poco_info.http.response.header_info,
+                                                               "/poll/",
+                                                               "\n");
 
       // Create a WebSocket for receiving subscription events.
-      evaluation_conditions_.reset();
-      evaluation_conditions_.parse_message_into_xml = false;
-      evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_SWITCHING_PROTOCOLS);
+      std::string poll = expandEndpointPath(Endpoints::CONNECT_SUBSCRIPTION.path_template, {subscription_group_id});
       result = evaluatePOCOResult(webSocketConnect(poll, "rws_subscription", DEFAULT_SUBSCRIPTION_TIMEOUT),
-                                  evaluation_conditions_);
+                                  Endpoints::CONNECT_SUBSCRIPTION);
 
-      if(!result.success)
+      if (result.success)
       {
-        subscription_group_id_.clear();
+        Poco::ScopedLock<Poco::Mutex> lock(subscription_mutex_);
+        subscription_group_id_ = subscription_group_id;
       }
     }
   }
@@ -499,11 +582,7 @@ RWSClient::RWSResult RWSClient::startSubscription(SubscriptionResources resource
 
 RWSClient::RWSResult RWSClient::waitForSubscriptionEvent()
 {
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
-
-  return evaluatePOCOResult(webSocketRecieveFrame(), evaluation_conditions_);
+  return evaluatePOCOResult(webSocketRecieveFrame(), Endpoints::WAIT_FOR_SUBSCRIPTION_EVENT);
 }
 
 RWSClient::RWSResult RWSClient::endSubscription()
@@ -512,15 +591,16 @@ RWSClient::RWSResult RWSClient::endSubscription()
 
   if (webSocketExist())
   {
-    if (!subscription_group_id_.empty())
-    {
-      uri_ = Services::SUBSCRIPTION + "/" + subscription_group_id_;
+    std::string subscription_group_id;
 
-      evaluation_conditions_.reset();
-      evaluation_conditions_.parse_message_into_xml = false;
-      evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
+    {
+      Poco::ScopedLock<Poco::Mutex> lock(subscription_mutex_);
+      subscription_group_id = subscription_group_id_;
+    }
 
-      result = evaluatePOCOResult(httpDelete(uri_), evaluation_conditions_);
+    if (!subscription_group_id.empty())
+    {
+      result = execute(Endpoints::END_SUBSCRIPTION, {subscription_group_id});
     }
   }
 
@@ -529,106 +609,384 @@ RWSClient::RWSResult RWSClient::endSubscription()
 
 RWSClient::RWSResult RWSClient::logout()
 {
-  uri_ = Resources::LOGOUT;
-
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = true;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
-
-  return evaluatePOCOResult(httpGet(uri_), evaluation_conditions_);
+  return execute(Endpoints::LOGOUT);
 }
 
 RWSClient::RWSResult RWSClient::registerLocalUser(std::string username,
                                                   std::string application,
                                                   std::string location)
 {
-  uri_ = Services::USERS;
-  content_ = "username=" + username +
-             "&application=" + application +
-             "&location=" + location +
-             "&ulocale=" + SystemConstants::General::LOCAL;
-  
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_CREATED);
-
-  RWSResult result = evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
-  
-  return result;
+  return execute(Endpoints::REGISTER_USER,
+                 {},
+                 "username=" + username +
+                 "&application=" + application +
+                 "&location=" + location +
+                 "&ulocale=" + SystemConstants::General::LOCAL);
 }
 
 RWSClient::RWSResult RWSClient::registerRemoteUser(std::string username,
                                                    std::string application,
                                                    std::string location)
 {
-  uri_ = Services::USERS;
-  content_ = "username=" + username +
-             "&application=" + application +
-             "&location=" + location +
-             "&ulocale=" + SystemConstants::General::REMOTE;
+  return execute(Endpoints::REGISTER_USER,
+                 {},
+                 "username=" + username +
+                 "&application=" + application +
+                 "&location=" + location +
+                 "&ulocale=" + SystemConstants::General::REMOTE);
+}
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_OK);
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_CREATED);
+RWSClient::RWSResult RWSClient::requestMasterShip()
+{
+  return execute(Endpoints::REQUEST_MASTERSHIP);
+}
 
-  RWSResult result = evaluatePOCOResult(httpPost(uri_, content_), evaluation_conditions_);
+RWSClient::RWSResult RWSClient::releaseMasterShip()
+{
+  return execute(Endpoints::RELEASE_MASTERSHIP);
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+RWSClient::RWSResult RWSClient::evaluatePOCOResult(const POCOResult& poco_result, const EndpointDescriptor& endpoint)
+{
+  RWSResult result;
+
+  checkAcceptedOutcomes(&result, poco_result, endpoint);
+
+  if (result.success && endpoint.parse_mode == EndpointDescriptor::PARSE_XML)
+  {
+    parseMessage(&result, poco_result);
+  }
+
+  log_.add(endpoint, poco_result);
+  endpoint_statistics_.add(endpoint, poco_result, result.success);
+
+  std::shared_ptr<RWSFlightRecorder> flight_recorder = std::atomic_load(&flight_recorder_);
+  if (flight_recorder)
+  {
+    flight_recorder->add(endpoint, poco_result);
+  }
 
   return result;
 }
 
-RWSClient::RWSResult RWSClient::requestMasterShip()
+RWSClient::RWSResult RWSClient::execute(const EndpointDescriptor& endpoint,
+                                        std::initializer_list<std::string_view> arguments,
+                                        std::string content)
 {
-  uri_ = Resources::RW_MASTERSHIP + "/" + Queries::ACTION_REQUEST;
+  RWSTracer::Span span("RWSClient", endpoint.name);
+
+  std::string uri = expandEndpointPath(endpoint.path_template, arguments);
+  Poco::Int64 ttl = (endpoint.cacheable ? lookupResponseCacheTTL(uri) : 0);
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
+  if (ttl > 0)
+  {
+    RWSResult result;
+    POCOResult cached_result;
+
+    {
+      Poco::ScopedLock<Poco::Mutex> lock(response_cache_mutex_);
+      std::map<std::string, CachedResponse>::const_iterator cached = response_cache_.find(uri);
 
-  return evaluatePOCOResult(httpPost(uri_), evaluation_conditions_);
+      if (cached != response_cache_.end() && std::chrono::steady_clock::now() < cached->second.expiry)
+      {
+        ++response_cache_statistics_.hits;
+        result.success = true;
+        result.http_status = cached->second.http_status;
+        cached_result.poco_info.http.response.content = cached->second.content;
+      }
+      else
+      {
+        ++response_cache_statistics_.misses;
+      }
+    }
+
+    // Each hit gets its own document (outside of the lock), since Poco's DOM is not thread-safe.
+    if (result.success)
+    {
+      if (endpoint.parse_mode == EndpointDescriptor::PARSE_XML)
+      {
+        parseMessage(&result, cached_result);
+      }
+
+      return result;
+    }
+  }
+
+  POCOResult poco_result = sendRequest(endpoint, uri, std::move(content));
+  RWSResult result = evaluatePOCOResult(poco_result, endpoint);
+
+  if (ttl > 0 && result.success)
+  {
+    Poco::ScopedLock<Poco::Mutex> lock(response_cache_mutex_);
+    CachedResponse& cached = response_cache_[uri];
+    cached.content = poco_result.poco_info.http.response.content;
+    cached.http_status = result.http_status;
+    cached.expiry = std::chrono::steady_clock::now() + std::chrono::microseconds(ttl);
+  }
+
+  return result;
 }
 
-RWSClient::RWSResult RWSClient::releaseMasterShip()
+POCOClient::POCOResult RWSClient::sendRequest(const EndpointDescriptor& endpoint,
+                                              const std::string& uri,
+                                              std::string content)
 {
-  uri_ = Resources::RW_MASTERSHIP + "/" + Queries::ACTION_RELEASE;
+  POCOResult result;
+
+  for (int attempt = 0; attempt <= MAX_TRANSPORT_RETRIES; ++attempt)
+  {
+    switch (endpoint.method)
+    {
+      case EndpointDescriptor::METHOD_GET:
+        result = httpGet(uri);
+      break;
 
-  evaluation_conditions_.reset();
-  evaluation_conditions_.parse_message_into_xml = false;
-  evaluation_conditions_.accepted_outcomes.push_back(HTTPResponse::HTTP_NO_CONTENT);
+      case EndpointDescriptor::METHOD_POST:
+        result = httpPost(uri, std::move(content));
+      break;
 
-  return evaluatePOCOResult(httpPost(uri_), evaluation_conditions_);
-}
+      case EndpointDescriptor::METHOD_PUT:
+        result = httpPut(uri, std::move(content));
+      break;
 
-/************************************************************
- * Auxiliary methods
- */
+      case EndpointDescriptor::METHOD_DELETE:
+        result = httpDelete(uri);
+      break;
 
-RWSClient::RWSResult RWSClient::evaluatePOCOResult(const POCOResult& poco_result,
-                                                   const EvaluationConditions& conditions)
+      default:
+        result.exception_message = "sendRequest(...): endpoint is not a HTTP request";
+        return result;
+    }
+
+    // Only communication failures are retried (the POCO client has then already reset the session).
+    if (result.status == POCOResult::OK || endpoint.retry_class != EndpointDescriptor::RETRY_ON_TRANSPORT_ERROR)
+    {
+      break;
+    }
+
+    // The POCO client records the (moved) request content in the result, so take it back for the next attempt.
+    content = std::move(result.poco_info.http.request.content);
+  }
+
+  return result;
+}
+
+RWSClient::RWSResult RWSClient::resolveRAPIDTypeDescriptor(const std::string& type_url,
+                                                           const int depth,
+                                                           std::shared_ptr<const RAPIDTypeDescriptor>* p_descriptor)
 {
-  // std::cout<< "sono in evaluatePOCOResult"<<std::endl;
   RWSResult result;
+  const std::string type_name = type_url.substr(type_url.find_last_of('/') + 1);
+  const std::string scope_url = type_url.substr(0, type_url.size() - type_name.size());
 
-  checkAcceptedOutcomes(&result, poco_result, conditions);
+  *p_descriptor = RAPIDTypeDescriptor::getBuiltIn(type_name);
 
-  if (result.success && conditions.parse_message_into_xml)
+  if (*p_descriptor)
   {
-    parseMessage(&result, poco_result);
+    result.success = true;
+    return result;
   }
 
-  if (log_.size() >= LOG_SIZE)
   {
-    log_.pop_back();
+    Poco::ScopedLock<Poco::Mutex> lock(type_descriptors_mutex_);
+    std::map<std::string, std::shared_ptr<const RAPIDTypeDescriptor>>::const_iterator it =
+      type_descriptors_.find(type_url);
+
+    if (it != type_descriptors_.end())
+    {
+      *p_descriptor = it->second;
+      result.success = true;
+      return result;
+    }
   }
-  log_.push_front(poco_result);
+
+  if (depth >= MAX_RAPID_TYPE_DEPTH)
+  {
+    result.error_message = "resolveRAPIDTypeDescriptor(...): RAPID type nesting is too deep for " + type_url;
+    return result;
+  }
+
+  result = execute(Endpoints::GET_RAPID_TYPE_PROPERTIES, {type_url});
+
+  if (!result.success)
+  {
+    return result;
+  }
+
+  std::shared_ptr<RAPIDTypeDescriptor> p_new(new RAPIDTypeDescriptor(type_name));
+  std::string symbol_type = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_SYMTYP);
+
+  if (symbol_type == "ali")
+  {
+    // An alias has the same representation as its base type.
+    std::string base_url = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_TYPURL);
+
+    if (base_url.empty() || base_url == type_url)
+    {
+      base_url = scope_url + xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_DATTYP);
+    }
+
+    std::shared_ptr<const RAPIDTypeDescriptor> p_base;
+    result = resolveRAPIDTypeDescriptor(base_url, depth + 1, &p_base);
+
+    if (!result.success)
+    {
+      return result;
+    }
+
+    *p_new = *p_base;
+    p_new->name = type_name;
+  }
+  else if (symbol_type == "rec")
+  {
+    p_new->kind = RAPIDTypeDescriptor::KIND_RECORD;
+
+    result = execute(Endpoints::SEARCH_RAPID_SYMBOLS, {},
+                     "view=block&blockurl=" + type_url + "&symtyp=rcp&recursive=FALSE");
+
+    if (!result.success)
+    {
+      return result;
+    }
+
+    // Keep the search result, since the component types are resolved (with new requests) while iterating it.
+    Poco::AutoPtr<Poco::XML::Document> p_components = result.p_xml_document;
+    std::vector<Poco::XML::Node*> nodes = xmlFindNodes(p_components, XMLAttributes::CLASS_SYMTYP);
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+      const Poco::XML::Node* p_item = nodes[i]->parentNode();
+
+      if (!p_item || xmlFindTextContent(nodes[i], XMLAttributes::CLASS_SYMTYP) != "rcp")
+      {
+        continue;
+      }
+
+      std::string component_url = xmlFindTextContent(p_item, XMLAttributes::CLASS_TYPURL);
+      std::shared_ptr<const RAPIDTypeDescriptor> p_component;
+
+      if (!component_url.empty())
+      {
+        result = resolveRAPIDTypeDescriptor(component_url, depth + 1, &p_component);
+      }
+      else
+      {
+        // Without a type URL, look for the component type next to the record type, and then among the global types.
+        std::string data_type = xmlFindTextContent(p_item, XMLAttributes::CLASS_DATTYP);
+        result = resolveRAPIDTypeDescriptor(scope_url + data_type, depth + 1, &p_component);
+
+        if (!result.success && scope_url != "RAPID/")
+        {
+          result = resolveRAPIDTypeDescriptor("RAPID/" + data_type, depth + 1, &p_component);
+        }
+      }
+
+      if (!result.success)
+      {
+        return result;
+      }
+
+      p_new->addComponent(xmlFindTextContent(p_item, XMLAttributes::CLASS_NAME), p_component);
+    }
+
+    if (p_new->components.empty())
+    {
+      result.success = false;
+      result.error_message = "resolveRAPIDTypeDescriptor(...): no components were found for " + type_url;
+      return result;
+    }
+  }
+
+  // Any other type is atomic, and its values are kept as raw text.
+  {
+    Poco::ScopedLock<Poco::Mutex> lock(type_descriptors_mutex_);
+    type_descriptors_[type_url] = p_new;
+  }
+
+  *p_descriptor = p_new;
+  result.success = true;
 
   return result;
 }
 
+bool RWSClient::getRAPIDComponentName(const std::string& symbol_name,
+                                      const RAPIDSymbolMetadata& metadata,
+                                      const RAPIDTypeDescriptor& descriptor,
+                                      const std::vector<size_t>& path,
+                                      std::string* p_name)
+{
+  size_t level = 0;
+  *p_name = symbol_name;
+
+  // An array element is addressed with all its (one-based) indices, e.g. "name{2,1}".
+  if (metadata.number_of_dimensions > 0)
+  {
+    if (path.size() < metadata.number_of_dimensions)
+    {
+      return false;
+    }
+
+    *p_name += '{';
+
+    for (; level < metadata.number_of_dimensions; ++level)
+    {
+      *p_name += (level > 0 ? "," : "") + std::to_string(path[level] + 1);
+    }
+
+    *p_name += '}';
+  }
+
+  const RAPIDTypeDescriptor* p_type = &descriptor;
+
+  for (; level < path.size(); ++level)
+  {
+    if (!p_type || p_type->kind != RAPIDTypeDescriptor::KIND_RECORD || path[level] >= p_type->components.size())
+    {
+      return false;
+    }
+
+    const RAPIDTypeDescriptor::Component& component = p_type->components[path[level]];
+    *p_name += '.' + component.name;
+    p_type = component.p_type.get();
+  }
+
+  return true;
+}
+
+Poco::Int64 RWSClient::lookupResponseCacheTTL(const std::string& uri)
+{
+  Poco::ScopedLock<Poco::Mutex> lock(response_cache_mutex_);
+
+  Poco::Int64 ttl = 0;
+  size_t longest_match = 0;
+
+  std::map<std::string, Poco::Int64>::const_iterator it;
+  for (it = response_cache_ttls_.begin(); it != response_cache_ttls_.end(); ++it)
+  {
+    if (it->first.size() >= longest_match && uri.compare(0, it->first.size(), it->first) == 0)
+    {
+      longest_match = it->first.size();
+      ttl = it->second;
+    }
+  }
+
+  return ttl;
+}
+
+void RWSClient::setDefaultResponseCacheTTLs()
+{
+  setResponseCacheTTL(Resources::RW_SYSTEM, DEFAULT_SYSTEM_CACHE_TTL);
+  setResponseCacheTTL(Resources::RW_CFG, DEFAULT_SYSTEM_CACHE_TTL);
+  setResponseCacheTTL(Resources::RW_RAPID_TASKS, DEFAULT_RAPID_CACHE_TTL);
+}
+
 void RWSClient::checkAcceptedOutcomes(RWSResult* result,
                                       const POCOResult& poco_result,
-                                      const EvaluationConditions& conditions)
+                                      const EndpointDescriptor& endpoint)
 {
   if (result)
   {
@@ -638,10 +996,8 @@ void RWSClient::checkAcceptedOutcomes(RWSResult* result,
     {
       // std::cout<< "sono in if 2 result checkAcceptedOutcomes"<<std::endl;
 
-      for (size_t i = 0; i < conditions.accepted_outcomes.size() && !result->success; ++i)
-      {
-        result->success = (poco_result.poco_info.http.response.status == conditions.accepted_outcomes.at(i));
-      }
+      result->http_status = poco_result.poco_info.http.response.status;
+      result->success = endpoint.accepts(poco_result.poco_info.http.response.status);
 
       if (!result->success)
       {
@@ -678,8 +1034,10 @@ void RWSClient::parseMessage(RWSResult* result, const POCOResult& poco_result)
     {
       try
       {
+        // A parser per call, since the parsers are not thread-safe.
+        Poco::XML::DOMParser xml_parser;
         Poco::XML::InputSource input_source(ss);
-        result->p_xml_document = xml_parser_.parse(&input_source);
+        result->p_xml_document = xml_parser.parse(&input_source);
       }
       catch (...)
       {
@@ -693,56 +1051,60 @@ void RWSClient::parseMessage(RWSResult* result, const POCOResult& poco_result)
 
 std::string RWSClient::getLogText(const bool verbose)
 {
-  if (log_.size() == 0)
-  {
-    return "";
-  }
-  
-  std::stringstream ss;
-  
-  for (size_t i = 0; i < log_.size(); ++i)
-  {
-    std::stringstream temp;
-    temp << i + 1 << ". ";
-    ss << temp.str() << log_[i].toString(verbose, temp.str().size()) << std::endl;
-  }
-
-  return ss.str();
+  return log_.getText(verbose);
 }
 
 std::string RWSClient::getLogTextLatestEvent(const bool verbose)
 {
-  return (log_.size() == 0 ? "" : log_[0].toString(verbose, 0));
+  return log_.getTextLatestEvent(verbose);
 }
 
-std::string RWSClient::generateConfigurationPath(const std::string& topic, const std::string& type)
+bool RWSClient::enableFlightRecorder(const std::string& path, const size_t capacity)
 {
-  return Resources::RW_CFG + "/" + topic + "/" + type;
+  try
+  {
+    std::atomic_store(&flight_recorder_, std::make_shared<RWSFlightRecorder>(path, capacity));
+  }
+  catch (const Poco::Exception&)
+  {
+    return false;
+  }
+
+  return true;
 }
 
-std::string RWSClient::generateIOSignalPath(const std::string& iosignal)
+void RWSClient::disableFlightRecorder()
 {
-  return Resources::RW_IOSYSTEM_SIGNALS + "/" + iosignal;
+  std::atomic_store(&flight_recorder_, std::shared_ptr<RWSFlightRecorder>());
 }
 
-std::string RWSClient::generateMechanicalUnitPath(const std::string& mechunit)
+void RWSClient::setResponseCacheTTL(const std::string& resource, const Poco::Int64 ttl)
 {
-  return Resources::RW_MOTIONSYSTEM_MECHUNITS + "/" + mechunit;
+  Poco::ScopedLock<Poco::Mutex> lock(response_cache_mutex_);
+  response_cache_ttls_[resource] = ttl;
 }
 
-std::string RWSClient::generateRAPIDDataPath(const RAPIDResource& resource)
+void RWSClient::invalidateResponseCache()
 {
-  return Resources::RW_RAPID_SYMBOL_DATA_RAPID + "/" + resource.task + "/" + resource.module + "/" + resource.name + "/data";
+  Poco::ScopedLock<Poco::Mutex> lock(response_cache_mutex_);
+  response_cache_.clear();
 }
 
-std::string RWSClient::generateRAPIDPropertiesPath(const RAPIDResource& resource)
+void RWSClient::invalidateResponseCache(const std::string& resource)
 {
-  return Resources::RW_RAPID_SYMBOL_PROPERTIES_RAPID + "/" + resource.task + "/" + resource.module + "/"+ resource.name + "/properties";
+  Poco::ScopedLock<Poco::Mutex> lock(response_cache_mutex_);
+
+  std::map<std::string, CachedResponse>::iterator it = response_cache_.lower_bound(resource);
+  while (it != response_cache_.end() && it->first.compare(0, resource.size(), resource) == 0)
+  {
+    it = response_cache_.erase(it);
+  }
 }
 
-std::string RWSClient::generateFilePath(const FileResource& resource)
+RWSClient::ResponseCacheStatistics RWSClient::getResponseCacheStatistics()
 {
-  return Services::FILESERVICE + "/" + resource.directory + "/" + resource.filename;
+  Poco::ScopedLock<Poco::Mutex> lock(response_cache_mutex_);
+  return response_cache_statistics_;
 }
 
 } // end namespace rws
@@ -0,0 +1,207 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A pool of RWS clients that runs independent requests concurrently.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#include "abb_librws/rws_client_pool.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Class definitions: RWSClientPool::Lease
+ */
+
+RWSClientPool::Lease::~Lease()
+{
+  if (p_pool_ && p_client_)
+  {
+    p_pool_->release(p_client_);
+  }
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RWSClientPool
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+void RWSClientPool::setMaxSize(const size_t max_size)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_size_ = (max_size < 1 ? 1 : max_size);
+}
+
+size_t RWSClientPool::getMaxSize()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_size_;
+}
+
+RWSClientPool::Lease RWSClientPool::acquire()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  acquisitions_.fetch_add(1, std::memory_order_relaxed);
+
+  if (idle_clients_.empty() && clients_.size() < max_size_)
+  {
+    clients_.push_back(std::unique_ptr<RWSClient>(new RWSClient(ip_address_,
+                                                                port_,
+                                                                username_,
+                                                                password_,
+                                                                ptrContext_)));
+    return Lease(this, clients_.back().get());
+  }
+
+  if (idle_clients_.empty())
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    client_returned_.wait(lock, [this] { return !idle_clients_.empty(); });
+
+    waits_.fetch_add(1, std::memory_order_relaxed);
+    total_wait_.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start).count(),
+                          std::memory_order_relaxed);
+  }
+
+  RWSClient* p_client = idle_clients_.back();
+  idle_clients_.pop_back();
+
+  return Lease(this, p_client);
+}
+
+void RWSClientPool::execute(const std::vector<Job>& jobs)
+{
+  if (jobs.empty())
+  {
+    return;
+  }
+
+  // Jobs are handed out through a shared index, so faster workers simply take more of them.
+  std::atomic<size_t> next_job(0);
+
+  // The first exception thrown by a job (on any thread) is kept, and rethrown on the calling thread.
+  std::mutex exception_mutex;
+  std::exception_ptr p_exception;
+
+  auto worker = [this, &jobs, &next_job, &exception_mutex, &p_exception]()
+  {
+    try
+    {
+      Lease lease = acquire();
+
+      for (size_t i = next_job++; i < jobs.size(); i = next_job++)
+      {
+        jobs[i](lease.client());
+      }
+    }
+    catch (...)
+    {
+      // Stop handing out the remaining jobs.
+      next_job = jobs.size();
+
+      std::lock_guard<std::mutex> lock(exception_mutex);
+      if (!p_exception)
+      {
+        p_exception = std::current_exception();
+      }
+    }
+  };
+
+  size_t number_of_workers = std::min(jobs.size(), getMaxSize());
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < number_of_workers; ++i)
+  {
+    threads.push_back(std::thread(worker));
+  }
+
+  worker();
+
+  for (size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+
+  if (p_exception)
+  {
+    std::rethrow_exception(p_exception);
+  }
+}
+
+RWSClientPool::Statistics RWSClientPool::getStatistics()
+{
+  Statistics statistics;
+
+  statistics.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+  statistics.waits = waits_.load(std::memory_order_relaxed);
+  statistics.total_wait = total_wait_.load(std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics.clients = clients_.size();
+
+  return statistics;
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+void RWSClientPool::release(RWSClient* p_client)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_clients_.push_back(p_client);
+  }
+
+  client_returned_.notify_one();
+}
+
+} // end namespace rws
+} // end namespace abb
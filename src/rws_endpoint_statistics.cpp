@@ -0,0 +1,191 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Per-endpoint request statistics, i.e. latency histograms and phase timing totals.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <algorithm>
+
+#include "abb_librws/rws_endpoint_statistics.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Struct definitions: RWSEndpointStatistics::Snapshot
+ */
+
+Poco::Int64 RWSEndpointStatistics::Snapshot::getPercentile(const double quantile) const
+{
+  if (count == 0)
+  {
+    return -1;
+  }
+
+  Poco::UInt64 target = std::max(Poco::UInt64(1), Poco::UInt64(quantile * count + 0.5));
+  Poco::UInt64 cumulative = 0;
+
+  for (size_t i = 0; i < NUMBER_OF_BUCKETS - 1; ++i)
+  {
+    cumulative += buckets[i];
+
+    if (cumulative >= target)
+    {
+      return BUCKET_UPPER_BOUNDS[i];
+    }
+  }
+
+  return -1;
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RWSEndpointStatistics
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+void RWSEndpointStatistics::add(const EndpointDescriptor& endpoint,
+                                const POCOClient::POCOResult& poco_result,
+                                const bool success)
+{
+  Counters& counters = counters_[endpoint.id];
+  const POCOClient::POCOResult::Timing& timing = poco_result.timing;
+
+  size_t status_class = (poco_result.status == POCOClient::POCOResult::OK ?
+                         std::min(size_t(poco_result.poco_info.http.response.status / 100),
+                                  NUMBER_OF_STATUS_CLASSES - 1) : 0);
+
+  counters.count.fetch_add(1, std::memory_order_relaxed);
+  counters.statuses[status_class].fetch_add(1, std::memory_order_relaxed);
+  counters.buckets[findBucket(poco_result.duration)].fetch_add(1, std::memory_order_relaxed);
+  counters.duration.fetch_add(poco_result.duration, std::memory_order_relaxed);
+  counters.lock_wait.fetch_add(timing.lock_wait, std::memory_order_relaxed);
+  counters.connect.fetch_add(timing.connect, std::memory_order_relaxed);
+  counters.send.fetch_add(timing.send, std::memory_order_relaxed);
+  counters.server.fetch_add(timing.server, std::memory_order_relaxed);
+  counters.receive.fetch_add(timing.receive, std::memory_order_relaxed);
+  counters.authentication.fetch_add(timing.authentication, std::memory_order_relaxed);
+  counters.exchanges.fetch_add(timing.exchanges, std::memory_order_relaxed);
+
+  if (!success)
+  {
+    counters.failures.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::vector<RWSEndpointStatistics::Snapshot> RWSEndpointStatistics::getSnapshots() const
+{
+  std::vector<Snapshot> result;
+
+  for (int i = 0; i < EndpointDescriptor::NUMBER_OF_ENDPOINTS; ++i)
+  {
+    const Counters& counters = counters_[i];
+
+    Snapshot snapshot;
+    snapshot.count = counters.count.load(std::memory_order_relaxed);
+
+    if (snapshot.count == 0)
+    {
+      continue;
+    }
+
+    snapshot.endpoint = EndpointDescriptor::Id(i);
+    snapshot.name = getEndpointDescriptor(snapshot.endpoint).name;
+    snapshot.failures = counters.failures.load(std::memory_order_relaxed);
+    for (size_t j = 0; j < NUMBER_OF_STATUS_CLASSES; ++j)
+    {
+      snapshot.statuses[j] = counters.statuses[j].load(std::memory_order_relaxed);
+    }
+    for (size_t j = 0; j < NUMBER_OF_BUCKETS; ++j)
+    {
+      snapshot.buckets[j] = counters.buckets[j].load(std::memory_order_relaxed);
+    }
+    snapshot.total_duration = counters.duration.load(std::memory_order_relaxed);
+    snapshot.total_timing.lock_wait = counters.lock_wait.load(std::memory_order_relaxed);
+    snapshot.total_timing.connect = counters.connect.load(std::memory_order_relaxed);
+    snapshot.total_timing.send = counters.send.load(std::memory_order_relaxed);
+    snapshot.total_timing.server = counters.server.load(std::memory_order_relaxed);
+    snapshot.total_timing.receive = counters.receive.load(std::memory_order_relaxed);
+    snapshot.total_timing.authentication = counters.authentication.load(std::memory_order_relaxed);
+    snapshot.total_timing.exchanges = int(counters.exchanges.load(std::memory_order_relaxed));
+
+    result.push_back(snapshot);
+  }
+
+  return result;
+}
+
+void RWSEndpointStatistics::reset()
+{
+  for (int i = 0; i < EndpointDescriptor::NUMBER_OF_ENDPOINTS; ++i)
+  {
+    Counters& counters = counters_[i];
+
+    counters.count.store(0, std::memory_order_relaxed);
+    counters.failures.store(0, std::memory_order_relaxed);
+    for (size_t j = 0; j < NUMBER_OF_STATUS_CLASSES; ++j)
+    {
+      counters.statuses[j].store(0, std::memory_order_relaxed);
+    }
+    for (size_t j = 0; j < NUMBER_OF_BUCKETS; ++j)
+    {
+      counters.buckets[j].store(0, std::memory_order_relaxed);
+    }
+    counters.duration.store(0, std::memory_order_relaxed);
+    counters.lock_wait.store(0, std::memory_order_relaxed);
+    counters.connect.store(0, std::memory_order_relaxed);
+    counters.send.store(0, std::memory_order_relaxed);
+    counters.server.store(0, std::memory_order_relaxed);
+    counters.receive.store(0, std::memory_order_relaxed);
+    counters.authentication.store(0, std::memory_order_relaxed);
+    counters.exchanges.store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t RWSEndpointStatistics::findBucket(const Poco::Int64 duration)
+{
+  return std::lower_bound(BUCKET_UPPER_BOUNDS, BUCKET_UPPER_BOUNDS + NUMBER_OF_BUCKETS - 1, duration) -
+         BUCKET_UPPER_BOUNDS;
+}
+
+} // end namespace rws
+} // end namespace abb
@@ -0,0 +1,177 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Descriptors of the Robot Web Services endpoints used by the RWS client.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <cstring>
+
+#include "abb_librws/rws_endpoints.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief The endpoint descriptors, indexed by their ids.
+ */
+static constexpr const EndpointDescriptor* ENDPOINT_DESCRIPTORS[EndpointDescriptor::NUMBER_OF_ENDPOINTS] =
+{
+  &Endpoints::GET_CONFIGURATION_INSTANCES,
+  &Endpoints::GET_IO_SIGNAL,
+  &Endpoints::GET_MECHUNIT_JOINTTARGET,
+  &Endpoints::GET_MECHUNIT_ROBTARGET,
+  &Endpoints::GET_RAPID_EXECUTION,
+  &Endpoints::GET_RAPID_MODULES_INFO,
+  &Endpoints::GET_RAPID_TASKS,
+  &Endpoints::GET_ROBOTWARE_SYSTEM,
+  &Endpoints::GET_PANEL_CTRLSTATE,
+  &Endpoints::GET_PANEL_OPMODE,
+  &Endpoints::GET_RAPID_SYMBOL_DATA,
+  &Endpoints::GET_RAPID_SYMBOL_PROPERTIES,
+  &Endpoints::GET_RAPID_TYPE_PROPERTIES,
+  &Endpoints::SEARCH_RAPID_SYMBOLS,
+  &Endpoints::SET_IO_SIGNAL,
+  &Endpoints::SET_RAPID_SYMBOL_DATA,
+  &Endpoints::START_RAPID_EXECUTION,
+  &Endpoints::STOP_RAPID_EXECUTION,
+  &Endpoints::RESET_RAPID_PROGRAM_POINTER,
+  &Endpoints::SET_PANEL_CTRLSTATE,
+  &Endpoints::SET_LEAD_THROUGH,
+  &Endpoints::GET_FILE,
+  &Endpoints::UPLOAD_FILE,
+  &Endpoints::DELETE_FILE,
+  &Endpoints::START_SUBSCRIPTION,
+  &Endpoints::CONNECT_SUBSCRIPTION,
+  &Endpoints::WAIT_FOR_SUBSCRIPTION_EVENT,
+  &Endpoints::END_SUBSCRIPTION,
+  &Endpoints::LOGOUT,
+  &Endpoints::REGISTER_USER,
+  &Endpoints::REQUEST_MASTERSHIP,
+  &Endpoints::RELEASE_MASTERSHIP
+};
+
+/**
+ * \brief A function for checking (at compile time) that the descriptors are ordered by their ids.
+ *
+ * \return bool indicating if the descriptors are ordered.
+ */
+static constexpr bool endpointDescriptorsAreOrdered()
+{
+  for (int i = 0; i < EndpointDescriptor::NUMBER_OF_ENDPOINTS; ++i)
+  {
+    if (ENDPOINT_DESCRIPTORS[i]->id != i)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static_assert(endpointDescriptorsAreOrdered(), "the endpoint descriptors must be ordered by their ids");
+
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+std::string expandEndpointPath(const char* path_template, std::initializer_list<std::string_view> arguments)
+{
+  size_t template_length = std::strlen(path_template);
+  size_t length = template_length;
+
+  for (std::initializer_list<std::string_view>::const_iterator it = arguments.begin(); it != arguments.end(); ++it)
+  {
+    length += it->size();
+  }
+
+  std::string result;
+  result.reserve(length);
+
+  std::initializer_list<std::string_view>::const_iterator argument = arguments.begin();
+
+  for (size_t i = 0; i < template_length; ++i)
+  {
+    if (path_template[i] == '{' && i + 1 < template_length && path_template[i + 1] == '}' &&
+        argument != arguments.end())
+    {
+      result.append(argument->data(), argument->size());
+      ++argument;
+      ++i;
+    }
+    else
+    {
+      result += path_template[i];
+    }
+  }
+
+  return result;
+}
+
+const EndpointDescriptor& getEndpointDescriptor(const EndpointDescriptor::Id id)
+{
+  return *ENDPOINT_DESCRIPTORS[id];
+}
+
+const char* mapEndpointMethod(const EndpointDescriptor::Method method)
+{
+  switch (method)
+  {
+    case EndpointDescriptor::METHOD_GET:
+      return "GET";
+
+    case EndpointDescriptor::METHOD_POST:
+      return "POST";
+
+    case EndpointDescriptor::METHOD_PUT:
+      return "PUT";
+
+    case EndpointDescriptor::METHOD_DELETE:
+      return "DELETE";
+
+    case EndpointDescriptor::METHOD_WEBSOCKET:
+      return "WEBSOCKET";
+
+    default:
+      return "UNDEFINED";
+  }
+}
+
+} // end namespace rws
+} // end namespace abb
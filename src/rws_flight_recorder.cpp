@@ -0,0 +1,250 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Recording of RWS traffic into a memory-mapped ring file, which outlives the process.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "Poco/Exception.h"
+#include "Poco/File.h"
+
+#include "abb_librws/rws_flight_recorder.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Struct definitions: RWSFlightRecorder::FileHeader and RWSFlightRecorder::Slot
+ */
+
+/**
+ * \brief The header of a flight recorder file.
+ */
+struct RWSFlightRecorder::FileHeader
+{
+  /**
+   * \brief The file's magic string (written last, when the file is initialized).
+   */
+  char magic[8];
+
+  /**
+   * \brief The file format's version.
+   */
+  Poco::UInt32 version;
+
+  /**
+   * \brief The size of a slot [bytes].
+   */
+  Poco::UInt32 slot_size;
+
+  /**
+   * \brief The number of slots.
+   */
+  Poco::UInt64 capacity;
+
+  /**
+   * \brief The sequence number of the next record.
+   */
+  std::atomic<Poco::UInt64> sequence;
+};
+
+/**
+ * \brief A slot (i.e. a record) in a flight recorder file.
+ */
+struct RWSFlightRecorder::Slot
+{
+  /**
+   * \brief The sequence number + 1 of the published record. Zero if the slot is empty, or being written.
+   */
+  std::atomic<Poco::UInt64> committed;
+
+  /**
+   * \brief The record.
+   */
+  RWSRequestLog::Record record;
+
+  /**
+   * \brief The first bytes of the response's content.
+   */
+  char capture[CAPTURE_SIZE];
+};
+
+/**
+ * \brief The magic string of a flight recorder file.
+ */
+static const char FLIGHT_RECORDER_MAGIC[8] = {'R', 'W', 'S', 'F', 'R', 'E', 'C', '\0'};
+
+/**
+ * \brief The version of the flight recorder file format.
+ */
+static const Poco::UInt32 FLIGHT_RECORDER_VERSION = 1;
+
+/**
+ * \brief The size reserved for the header of a flight recorder file [bytes].
+ */
+static const size_t FLIGHT_RECORDER_HEADER_SIZE = 64;
+
+static_assert(sizeof(RWSRequestLog::Record) % 8 == 0, "flight recorder records must keep the slots aligned");
+static_assert(std::atomic<Poco::UInt64>::is_always_lock_free, "the flight recorder requires lock-free atomics");
+
+/***********************************************************************************************************************
+ * Class definitions: RWSFlightRecorder
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+RWSFlightRecorder::RWSFlightRecorder(const std::string& path, const size_t capacity)
+:
+path_(path),
+p_header_(0),
+p_slots_(0),
+capacity_(capacity)
+{
+  static_assert(sizeof(FileHeader) <= FLIGHT_RECORDER_HEADER_SIZE, "the flight recorder header is too large");
+
+  if (capacity_ == 0)
+  {
+    throw Poco::InvalidArgumentException("RWSFlightRecorder: the capacity must be positive");
+  }
+
+  size_t file_size = FLIGHT_RECORDER_HEADER_SIZE + capacity_ * sizeof(Slot);
+
+  Poco::File file(path_);
+  bool existing = (file.exists() && file.getSize() == file_size);
+
+  if (!existing)
+  {
+    file.createFile();
+    file.setSize(file_size);
+  }
+
+  memory_ = Poco::SharedMemory(file, Poco::SharedMemory::AM_WRITE);
+  p_header_ = reinterpret_cast<FileHeader*>(memory_.begin());
+  p_slots_ = reinterpret_cast<Slot*>(memory_.begin() + FLIGHT_RECORDER_HEADER_SIZE);
+
+  if (!existing ||
+      std::memcmp(p_header_->magic, FLIGHT_RECORDER_MAGIC, sizeof(FLIGHT_RECORDER_MAGIC)) != 0 ||
+      p_header_->version != FLIGHT_RECORDER_VERSION ||
+      p_header_->slot_size != sizeof(Slot) ||
+      p_header_->capacity != capacity_)
+  {
+    std::memset(memory_.begin(), 0, file_size);
+    p_header_->version = FLIGHT_RECORDER_VERSION;
+    p_header_->slot_size = sizeof(Slot);
+    p_header_->capacity = capacity_;
+    p_header_->sequence.store(0);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(p_header_->magic, FLIGHT_RECORDER_MAGIC, sizeof(FLIGHT_RECORDER_MAGIC));
+  }
+}
+
+void RWSFlightRecorder::add(const EndpointDescriptor& endpoint, const POCOClient::POCOResult& poco_result)
+{
+  Poco::UInt64 sequence = p_header_->sequence.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = p_slots_[sequence % capacity_];
+
+  // Unpublish the slot while it is written, so that a torn record (e.g. after a crash) is never read.
+  slot.committed.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.record = RWSRequestLog::makeRecord(endpoint, poco_result, slot.capture, CAPTURE_SIZE);
+
+  slot.committed.store(sequence + 1, std::memory_order_release);
+}
+
+std::vector<RWSFlightRecorder::Entry> RWSFlightRecorder::read(const std::string& path)
+{
+  Poco::File file(path);
+  Poco::SharedMemory memory(file, Poco::SharedMemory::AM_READ);
+  size_t file_size = memory.end() - memory.begin();
+
+  const FileHeader* p_header = reinterpret_cast<const FileHeader*>(memory.begin());
+
+  if (file_size < FLIGHT_RECORDER_HEADER_SIZE ||
+      std::memcmp(p_header->magic, FLIGHT_RECORDER_MAGIC, sizeof(FLIGHT_RECORDER_MAGIC)) != 0 ||
+      p_header->version != FLIGHT_RECORDER_VERSION ||
+      p_header->slot_size != sizeof(Slot) ||
+      file_size != FLIGHT_RECORDER_HEADER_SIZE + p_header->capacity * sizeof(Slot))
+  {
+    throw Poco::DataFormatException("RWSFlightRecorder: not a flight recorder file (or an incompatible version)", path);
+  }
+
+  const Slot* p_slots = reinterpret_cast<const Slot*>(memory.begin() + FLIGHT_RECORDER_HEADER_SIZE);
+
+  std::vector<Entry> result;
+
+  for (size_t i = 0; i < p_header->capacity; ++i)
+  {
+    const Slot& slot = p_slots[i];
+    Poco::UInt64 committed = slot.committed.load(std::memory_order_acquire);
+
+    if (committed == 0 || (committed - 1) % p_header->capacity != i)
+    {
+      continue;
+    }
+
+    Entry entry;
+    entry.sequence = committed - 1;
+    entry.record = slot.record;
+    entry.record.uri[RWSRequestLog::URI_SIZE - 1] = '\0';
+    entry.record.captured_bytes = std::min(entry.record.captured_bytes, Poco::UInt32(CAPTURE_SIZE));
+    entry.capture.assign(slot.capture, entry.record.captured_bytes);
+
+    // Skip the slot if it was rewritten while it was copied (i.e. when reading a file that is being recorded to).
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.committed.load(std::memory_order_relaxed) == committed)
+    {
+      result.push_back(entry);
+    }
+  }
+
+  std::sort(result.begin(), result.end(),
+            [](const Entry& a, const Entry& b) { return a.sequence < b.sequence; });
+
+  return result;
+}
+
+} // end namespace rws
+} // end namespace abb
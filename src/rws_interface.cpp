@@ -44,9 +44,13 @@
  */
 #include <algorithm>
 #include <sstream>
+#include <utility>
+
+#include "Poco/DOM/Element.h"
 
 #include "abb_librws/rws_interface.h"
 #include "abb_librws/rws_rapid.h"
+#include "abb_librws/rws_tracer.h"
 
 namespace abb
 {
@@ -56,6 +60,7 @@ namespace rws
 typedef SystemConstants::ContollerStates ContollerStates;
 typedef SystemConstants::RAPID RAPID;
 typedef SystemConstants::RWS::Identifiers Identifiers;
+typedef SystemConstants::RWS::Resources Resources;
 typedef SystemConstants::RWS::XMLAttributes XMLAttributes;
 
 /***********************************************************************************************************************
@@ -68,6 +73,7 @@ typedef SystemConstants::RWS::XMLAttributes XMLAttributes;
 
 RWSInterface::RuntimeInfo RWSInterface::collectRuntimeInfo()
 {
+  RWSTracer::Span span("RWSInterface", "collectRuntimeInfo");
   RuntimeInfo runtime_info;
 
   runtime_info.auto_mode     = isAutoMode();
@@ -80,8 +86,178 @@ RWSInterface::RuntimeInfo RWSInterface::collectRuntimeInfo()
   return runtime_info;
 }
 
+RWSInterface::Snapshot RWSInterface::collectSnapshot(const SnapshotRequest& request)
+{
+  RWSTracer::Span span("RWSInterface", "collectSnapshot");
+  typedef std::chrono::steady_clock Clock;
+
+  Snapshot snapshot;
+  snapshot.rapid_symbols.resize(request.rapid_symbols.size());
+
+  std::vector<RWSClientPool::Job> jobs;
+  std::vector<std::string> iosignal_values(request.iosignals.size());
+  std::vector<std::string> errors;
+  std::mutex errors_mutex;
+
+  // The samples to take (each returns if it succeeded), and their descriptions (for reporting failures).
+  std::vector<Clock::time_point> midpoints;
+  std::vector<std::function<bool(RWSClient&)>> samples;
+  std::vector<std::string> descriptions;
+
+  samples.push_back([&](RWSClient& client)
+  {
+    snapshot.runtime_info.auto_mode = compareSingleContent(client.getPanelOperationMode(),
+                                                           XMLAttributes::CLASS_OPMODE,
+                                                           ContollerStates::PANEL_OPERATION_MODE_AUTO);
+    return snapshot.runtime_info.auto_mode != TriBool::UNKNOWN_VALUE;
+  });
+  descriptions.push_back("operation mode");
+
+  samples.push_back([&](RWSClient& client)
+  {
+    snapshot.runtime_info.motor_on = compareSingleContent(client.getPanelControllerState(),
+                                                          XMLAttributes::CLASS_CTRLSTATE,
+                                                          ContollerStates::CONTROLLER_MOTOR_ON);
+    return snapshot.runtime_info.motor_on != TriBool::UNKNOWN_VALUE;
+  });
+  descriptions.push_back("controller state");
+
+  samples.push_back([&](RWSClient& client)
+  {
+    snapshot.runtime_info.rapid_running = compareSingleContent(client.getRAPIDExecution(),
+                                                               XMLAttributes::CLASS_CTRLEXECSTATE,
+                                                               ContollerStates::RAPID_EXECUTION_RUNNING);
+    return snapshot.runtime_info.rapid_running != TriBool::UNKNOWN_VALUE;
+  });
+  descriptions.push_back("RAPID execution state");
+
+  std::map<std::string, JointTarget*>::const_iterator jointtarget;
+  for (jointtarget = request.jointtargets.begin(); jointtarget != request.jointtargets.end(); ++jointtarget)
+  {
+    std::string mechunit = jointtarget->first;
+    JointTarget* p_jointtarget = jointtarget->second;
+
+    samples.push_back([this, mechunit, p_jointtarget](RWSClient& client)
+    {
+      RWSClient::RWSResult rws_result = client.getMechanicalUnitJointTarget(mechunit);
+
+      if (rws_result.success && p_jointtarget)
+      {
+        parseMechanicalUnitJointTarget(rws_result, p_jointtarget);
+      }
+
+      return rws_result.success;
+    });
+    descriptions.push_back("jointtarget of " + mechunit);
+  }
+
+  std::map<std::string, RobTarget*>::const_iterator robtarget;
+  for (robtarget = request.robtargets.begin(); robtarget != request.robtargets.end(); ++robtarget)
+  {
+    std::string mechunit = robtarget->first;
+    RobTarget* p_robtarget = robtarget->second;
+
+    samples.push_back([this, mechunit, p_robtarget](RWSClient& client)
+    {
+      RWSClient::RWSResult rws_result = client.getMechanicalUnitRobTarget(mechunit);
+
+      if (rws_result.success && p_robtarget)
+      {
+        parseMechanicalUnitRobTarget(rws_result, p_robtarget);
+      }
+
+      return rws_result.success;
+    });
+    descriptions.push_back("robtarget of " + mechunit);
+  }
+
+  for (size_t i = 0; i < request.iosignals.size(); ++i)
+  {
+    const std::string* p_iosignal = &request.iosignals[i];
+    std::string* p_value = &iosignal_values[i];
+
+    samples.push_back([this, p_iosignal, p_value](RWSClient& client)
+    {
+      RWSClient::RWSResult rws_result = client.getIOSignal(*p_iosignal);
+
+      if (rws_result.success)
+      {
+        *p_value = xmlFindTextContent(rws_result.p_xml_document, XMLAttributes::CLASS_LVALUE);
+        storeIOSignalState(*p_iosignal, *p_value);
+      }
+
+      return rws_result.success;
+    });
+    descriptions.push_back("IO signal " + request.iosignals[i]);
+  }
+
+  for (size_t i = 0; i < request.rapid_symbols.size(); ++i)
+  {
+    const RAPIDSymbolAccess* p_read = &request.rapid_symbols[i];
+    RAPIDSymbolAccessResult* p_result = &snapshot.rapid_symbols[i];
+
+    samples.push_back([p_read, p_result](RWSClient& client)
+    {
+      RWSClient::RWSResult rws_result = client.getRAPIDSymbolData(p_read->resource, p_read->p_data);
+      p_result->outcome = (rws_result.success ? RAPIDSymbolAccessResult::SUCCEEDED : RAPIDSymbolAccessResult::FAILED);
+      p_result->error_message = rws_result.error_message;
+      return rws_result.success;
+    });
+    descriptions.push_back("RAPID symbol " + p_read->resource.task + "/" +
+                           p_read->resource.module + "/" + p_read->resource.name);
+  }
+
+  // Each sample's request is timed, and its middle is used when computing the skew.
+  midpoints.resize(samples.size());
+
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    jobs.push_back([&, i](RWSClient& client)
+    {
+      Clock::time_point start = Clock::now();
+      bool success = samples[i](client);
+      midpoints[i] = start + (Clock::now() - start) / 2;
+
+      if (!success)
+      {
+        std::lock_guard<std::mutex> lock(errors_mutex);
+        errors.push_back(descriptions[i]);
+      }
+    });
+  }
+
+  std::chrono::system_clock::time_point system_start = std::chrono::system_clock::now();
+  Clock::time_point start = Clock::now();
+
+  client_pool_.execute(jobs);
+
+  Clock::time_point first = *std::min_element(midpoints.begin(), midpoints.end());
+  Clock::time_point last = *std::max_element(midpoints.begin(), midpoints.end());
+
+  snapshot.timestamp = system_start + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                        (first - start) + (last - first) / 2);
+  snapshot.skew = std::chrono::duration_cast<std::chrono::microseconds>(last - first).count();
+
+  for (size_t i = 0; i < request.iosignals.size(); ++i)
+  {
+    if (!iosignal_values[i].empty())
+    {
+      snapshot.iosignals[request.iosignals[i]] = iosignal_values[i];
+    }
+  }
+
+  snapshot.runtime_info.rws_connected = (snapshot.runtime_info.auto_mode != TriBool::UNKNOWN_VALUE &&
+                                         snapshot.runtime_info.motor_on != TriBool::UNKNOWN_VALUE &&
+                                         snapshot.runtime_info.rapid_running != TriBool::UNKNOWN_VALUE);
+  snapshot.errors.swap(errors);
+  snapshot.complete = snapshot.errors.empty();
+
+  return snapshot;
+}
+
 RWSInterface::StaticInfo RWSInterface::collectStaticInfo()
 {
+  RWSTracer::Span span("RWSInterface", "collectStaticInfo");
   StaticInfo static_info;
 
   static_info.rapid_tasks = getRAPIDTasks();
@@ -92,6 +268,7 @@ RWSInterface::StaticInfo RWSInterface::collectStaticInfo()
 
 std::vector<RWSInterface::RobotWareOptionInfo> RWSInterface::getPresentRobotWareOptions()
 {
+  RWSTracer::Span span("RWSInterface", "getPresentRobotWareOptions");
   std::vector<RobotWareOptionInfo> result;
 
   RWSClient::RWSResult rws_result = rws_client_.getConfigurationInstances(Identifiers::SYS,
@@ -111,8 +288,9 @@ std::vector<RWSInterface::RobotWareOptionInfo> RWSInterface::getPresentRobotWare
   return result;
 }
 
-std::string RWSInterface::getIOSignal(const std::string iosignal)
+std::string RWSInterface::getIOSignal(const std::string& iosignal)
 {
+  RWSTracer::Span span("RWSInterface", "getIOSignal");
   std::string result;
 
   RWSClient::RWSResult rws_result = rws_client_.getIOSignal(iosignal);
@@ -120,13 +298,19 @@ std::string RWSInterface::getIOSignal(const std::string iosignal)
   if (rws_result.success)
   {
     result = xmlFindTextContent(rws_result.p_xml_document, XMLAttributes::CLASS_LVALUE);
+
+    if (!result.empty())
+    {
+      storeIOSignalState(iosignal, result);
+    }
   }
 
   return result;
 }
 
-bool RWSInterface::getMechanicalUnitJointTarget(const std::string mechunit, JointTarget* p_jointtarget)
+bool RWSInterface::getMechanicalUnitJointTarget(const std::string& mechunit, JointTarget* p_jointtarget)
 {
+  RWSTracer::Span span("RWSInterface", "getMechanicalUnitJointTarget");
   bool result = false;
 
   if (p_jointtarget)
@@ -136,31 +320,16 @@ bool RWSInterface::getMechanicalUnitJointTarget(const std::string mechunit, Join
 
     if (result)
     {
-      std::stringstream ss;
-
-      ss << "[["
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_1")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_2")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_3")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_4")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_5")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_6")) << "], ["
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_a")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_b")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_c")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_d")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_e")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_f")) << "]]";
-
-      p_jointtarget->parseString(ss.str());
+      parseMechanicalUnitJointTarget(rws_result, p_jointtarget);
     }
   }
 
   return result;
 }
 
-bool RWSInterface::getMechanicalUnitRobTarget(const std::string mechunit, RobTarget* p_robtarget)
+bool RWSInterface::getMechanicalUnitRobTarget(const std::string& mechunit, RobTarget* p_robtarget)
 {
+  RWSTracer::Span span("RWSInterface", "getMechanicalUnitRobTarget");
   bool result = false;
 
   if (p_robtarget)
@@ -170,28 +339,7 @@ bool RWSInterface::getMechanicalUnitRobTarget(const std::string mechunit, RobTar
 
     if (result)
     {
-      std::stringstream ss;
-
-      ss << "[["
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "x")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "y")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "z")) << "], ["
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "q1")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "q2")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "q3")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "q4")) << "], ["
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "cf1")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "cf4")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "cf6")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "cfx")) << "], ["
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_a")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_b")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_c")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_d")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_e")) << ","
-         << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_f")) << "]]";
-
-      p_robtarget->parseString(ss.str());
+      parseMechanicalUnitRobTarget(rws_result, p_robtarget);
     }
   }
 
@@ -203,62 +351,432 @@ bool RWSInterface::setRAPIDSymbolData(const std::string& task,
                                       const std::string& name,
                                       const std::string& data)
 {
-  return rws_client_.setRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name), data).success;
+  RWSTracer::Span span("RWSInterface", "setRAPIDSymbolData");
+  return writeWithMastership([&]()
+  {
+    return rws_client_.setRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name), data);
+  });
 }
 
-bool RWSInterface::setRAPIDSymbolData(const std::string task,
-                                      const std::string module,
-                                      const std::string name,
+bool RWSInterface::setRAPIDSymbolData(const std::string& task,
+                                      const std::string& module,
+                                      const std::string& name,
                                       RAPIDSymbolDataAbstract& data)
 {
-  return rws_client_.setRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name), data).success;
+  RWSTracer::Span span("RWSInterface", "setRAPIDSymbolData");
+  return writeWithMastership([&]()
+  {
+    return rws_client_.setRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name), data);
+  });
 }
 
-bool RWSInterface::setRAPIDSymbolData(const std::string task,
-                                      const RWSClient::RAPIDSymbolResource symbol,
+bool RWSInterface::setRAPIDSymbolData(const std::string& task,
+                                      const RWSClient::RAPIDSymbolResource& symbol,
                                       RAPIDSymbolDataAbstract& data)
 {
-  return rws_client_.setRAPIDSymbolData(RWSClient::RAPIDResource(task, symbol), data).success;
+  RWSTracer::Span span("RWSInterface", "setRAPIDSymbolData");
+  return writeWithMastership([&]()
+  {
+    return rws_client_.setRAPIDSymbolData(RWSClient::RAPIDResource(task, symbol), data);
+  });
+}
+
+bool RWSInterface::setRAPIDSymbolData(const std::string& task,
+                                      const std::string& module,
+                                      const std::string& name,
+                                      RAPIDSymbolDataAbstract& data,
+                                      RAPIDSnapshot* p_snapshot)
+{
+  return setRAPIDSymbolData(task, RWSClient::RAPIDSymbolResource(module, name), data, p_snapshot);
+}
+
+bool RWSInterface::setRAPIDSymbolData(const std::string& task,
+                                      const RWSClient::RAPIDSymbolResource& symbol,
+                                      RAPIDSymbolDataAbstract& data,
+                                      RAPIDSnapshot* p_snapshot)
+{
+  RWSTracer::Span span("RWSInterface", "setRAPIDSymbolData");
+  return writeWithMastership([&]()
+  {
+    return rws_client_.setRAPIDSymbolData(RWSClient::RAPIDResource(task, symbol), data, p_snapshot);
+  });
+}
+
+std::vector<RWSInterface::RAPIDSymbolAccessResult>
+RWSInterface::getRAPIDSymbolsData(const std::vector<RAPIDSymbolAccess>& reads)
+{
+  std::vector<RAPIDSymbolAccessResult> results(reads.size());
+  std::vector<RWSClientPool::Job> jobs;
+
+  for (size_t i = 0; i < reads.size(); ++i)
+  {
+    const RAPIDSymbolAccess* p_read = &reads[i];
+    RAPIDSymbolAccessResult* p_result = &results[i];
+
+    jobs.push_back([p_read, p_result](RWSClient& client)
+    {
+      RWSClient::RWSResult rws_result = client.getRAPIDSymbolData(p_read->resource, p_read->p_data);
+      p_result->outcome = (rws_result.success ? RAPIDSymbolAccessResult::SUCCEEDED : RAPIDSymbolAccessResult::FAILED);
+      p_result->error_message = rws_result.error_message;
+    });
+  }
+
+  client_pool_.execute(jobs);
+
+  return results;
+}
+
+std::vector<RWSInterface::RAPIDSymbolAccessResult>
+RWSInterface::setRAPIDSymbolsData(const std::vector<RAPIDSymbolAccess>& writes, const bool all_or_nothing)
+{
+  std::vector<RAPIDSymbolAccessResult> results(writes.size());
+  std::vector<std::string> old_values(writes.size());
+
+  if (all_or_nothing)
+  {
+    std::vector<RWSClientPool::Job> jobs;
+
+    for (size_t i = 0; i < writes.size(); ++i)
+    {
+      const RAPIDSymbolAccess* p_write = &writes[i];
+      std::string* p_old_value = &old_values[i];
+
+      jobs.push_back([p_write, p_old_value](RWSClient& client)
+      {
+        RWSClient::RWSResult rws_result = client.getRAPIDSymbolData(p_write->resource);
+
+        if (rws_result.success)
+        {
+          *p_old_value = xmlFindTextContent(rws_result.p_xml_document, XMLAttributes::CLASS_VALUE);
+        }
+      });
+    }
+
+    client_pool_.execute(jobs);
+
+    // Nothing is written if any old value is unknown, since that write could not be rolled back.
+    for (size_t i = 0; i < writes.size(); ++i)
+    {
+      if (old_values[i].empty())
+      {
+        results[i].outcome = RAPIDSymbolAccessResult::FAILED;
+        results[i].error_message = "setRAPIDSymbolsData(...): failed to read the current value (for rollback)";
+        return results;
+      }
+    }
+  }
+
+  size_t failed = writes.size();
+
+  for (size_t i = 0; i < writes.size() && failed == writes.size(); ++i)
+  {
+    if (!writes[i].p_data)
+    {
+      results[i].outcome = RAPIDSymbolAccessResult::FAILED;
+      results[i].error_message = "setRAPIDSymbolsData(...): no data to write";
+    }
+    else
+    {
+      RWSClient::RWSResult rws_result;
+
+      bool success = writeWithMastership([&]()
+      {
+        rws_result = rws_client_.setRAPIDSymbolData(writes[i].resource, *writes[i].p_data);
+        return rws_result;
+      });
+
+      results[i].outcome = (success ? RAPIDSymbolAccessResult::SUCCEEDED : RAPIDSymbolAccessResult::FAILED);
+      results[i].error_message = rws_result.error_message;
+    }
+
+    if (all_or_nothing && results[i].outcome == RAPIDSymbolAccessResult::FAILED)
+    {
+      failed = i;
+    }
+  }
+
+  for (size_t i = 0; i < failed && failed < writes.size(); ++i)
+  {
+    bool success = writeWithMastership([&]()
+    {
+      return rws_client_.setRAPIDSymbolData(writes[i].resource, old_values[i]);
+    });
+
+    if (success)
+    {
+      results[i].outcome = RAPIDSymbolAccessResult::ROLLED_BACK;
+    }
+    else
+    {
+      results[i].error_message = "setRAPIDSymbolsData(...): failed to roll back to the old value";
+    }
+  }
+
+  return results;
+}
+
+bool RWSInterface::getRAPIDArrayData(const std::string& task,
+                                     const std::string& module,
+                                     const std::string& name,
+                                     RAPIDArrayAbstract* p_array,
+                                     const size_t first,
+                                     const size_t count,
+                                     const size_t max_element_reads,
+                                     std::string* p_error_message)
+{
+  RWSTracer::Span span("RWSInterface", "getRAPIDArrayData");
+  std::string error_message;
+
+  if (!p_array)
+  {
+    return false;
+  }
+
+  if (first == 0 && count == 0)
+  {
+    RWSClient::RWSResult result = rws_client_.getRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name), p_array);
+
+    if (!result.success && p_error_message)
+    {
+      *p_error_message = result.error_message;
+    }
+
+    return result.success;
+  }
+
+  size_t last = (count == 0 ? p_array->size() : first + count);
+
+  if (last <= first)
+  {
+    if (p_error_message)
+    {
+      *p_error_message = "getRAPIDArrayData(...): the element range was empty";
+    }
+
+    return false;
+  }
+
+  // The elements' value strings, viewing either the complete array's value string, or the read element values.
+  std::vector<std::string_view> value_strings(last - first);
+  std::string array_value;
+  std::vector<std::string> element_values;
+
+  if (last - first > max_element_reads)
+  {
+    // Reading the complete array with a single request is cheaper than reading many elements one by one.
+    RWSClient::RWSResult result = rws_client_.getRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name));
+
+    if (result.success)
+    {
+      array_value = xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_VALUE);
+      RAPIDParser parser(array_value);
+      size_t index = 0;
+
+      if (parser.expect('[') && !parser.accept(']'))
+      {
+        do
+        {
+          std::string_view value = parser.nextValue();
+
+          if (index >= first && index < last)
+          {
+            value_strings[index - first] = value;
+          }
+
+          ++index;
+        }
+        while (!parser.hasFailed() && parser.accept(','));
+
+        parser.expect(']');
+      }
+
+      if (parser.hasFailed())
+      {
+        error_message = "getRAPIDArrayData(...): the array's value string could not be parsed at position " +
+                        std::to_string(parser.getErrorPosition()) + " (" + parser.getErrorMessage() + ")";
+      }
+      else if (index < last)
+      {
+        error_message = "getRAPIDArrayData(...): the array only has " + std::to_string(index) + " elements";
+      }
+    }
+    else
+    {
+      error_message = "getRAPIDArrayData(...): failed to read the array (" + result.error_message + ")";
+    }
+  }
+  else
+  {
+    // Read the elements' value strings concurrently (in one chunk per pooled client). Each chunk stops at its first
+    // failed element, and the lowest failed element is reported.
+    element_values.resize(last - first);
+    std::vector<RWSClientPool::Job> jobs;
+    size_t chunks = std::min(client_pool_.getMaxSize(), element_values.size());
+    size_t chunk_size = (element_values.size() + chunks - 1) / chunks;
+    std::vector<std::pair<size_t, std::string>> failures(chunks, std::make_pair(last, std::string()));
+
+    for (size_t chunk_first = first, chunk = 0; chunk_first < last; chunk_first += chunk_size, ++chunk)
+    {
+      size_t chunk_last = std::min(chunk_first + chunk_size, last);
+      std::pair<size_t, std::string>* p_failure = &failures[chunk];
+
+      jobs.push_back([&, chunk_first, chunk_last, p_failure](RWSClient& client)
+      {
+        for (size_t i = chunk_first; i < chunk_last; ++i)
+        {
+          RWSClient::RAPIDResource resource(task, module, name + "{" + std::to_string(i + 1) + "}");
+          RWSClient::RWSResult rws_result = client.getRAPIDSymbolData(resource);
+
+          if (!rws_result.success)
+          {
+            *p_failure = std::make_pair(i, rws_result.error_message);
+            break;
+          }
+
+          element_values[i - first] = xmlFindTextContent(rws_result.p_xml_document, XMLAttributes::CLASS_VALUE);
+        }
+      });
+    }
+
+    client_pool_.execute(jobs);
+
+    std::pair<size_t, std::string> failure = *std::min_element(failures.begin(), failures.end());
+
+    if (failure.first < last)
+    {
+      error_message = "getRAPIDArrayData(...): failed to read " + name + "{" + std::to_string(failure.first + 1) +
+                      "} (" + failure.second + ")";
+    }
+
+    for (size_t i = 0; i < element_values.size(); ++i)
+    {
+      value_strings[i] = element_values[i];
+    }
+  }
+
+  // The array is only resized (and updated) once all the elements have been read, and parsed.
+  size_t failed_index = 0;
+
+  if (error_message.empty() && !p_array->parseElements(first, value_strings, &failed_index))
+  {
+    error_message = "getRAPIDArrayData(...): the value string of " + name + "{" + std::to_string(failed_index + 1) +
+                    "} could not be parsed";
+  }
+
+  if (!error_message.empty() && p_error_message)
+  {
+    *p_error_message = error_message;
+  }
+
+  return error_message.empty();
+}
+
+bool RWSInterface::setRAPIDArrayData(const std::string& task,
+                                     const std::string& module,
+                                     const std::string& name,
+                                     RAPIDArrayAbstract& array,
+                                     const size_t max_element_writes)
+{
+  RWSTracer::Span span("RWSInterface", "setRAPIDArrayData");
+  size_t modified = array.getModifiedCount();
+
+  if (modified == 0)
+  {
+    return true;
+  }
+
+  // A complete write would overwrite any elements that haven't been loaded (e.g. those before a range read into a new
+  // array) with default values, so the modified elements are then written element by element instead.
+  if (modified > max_element_writes && array.getUnloadedCount() == 0)
+  {
+    bool success = writeWithMastership([&]()
+    {
+      return rws_client_.setRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name), array);
+    });
+
+    if (success)
+    {
+      array.markUnmodified();
+    }
+
+    return success;
+  }
+
+  std::string value;
+
+  for (const std::pair<size_t, size_t>& range : array.getModifiedRanges())
+  {
+    for (size_t i = range.first; i < range.first + range.second; ++i)
+    {
+      value.clear();
+      array.appendElement(value, i);
+
+      bool success = writeWithMastership([&]()
+      {
+        RWSClient::RAPIDResource resource(task, module, name + "{" + std::to_string(i + 1) + "}");
+        return rws_client_.setRAPIDSymbolData(resource, value);
+      });
+
+      if (!success)
+      {
+        return false;
+      }
+
+      array.markUnmodified(i, 1);
+    }
+  }
+
+  return true;
 }
 
 bool RWSInterface::startRAPIDExecution()
 {
+  RWSTracer::Span span("RWSInterface", "startRAPIDExecution");
   return rws_client_.startRAPIDExecution().success;
 }
 
 bool RWSInterface::stopRAPIDExecution()
 {
+  RWSTracer::Span span("RWSInterface", "stopRAPIDExecution");
   return rws_client_.stopRAPIDExecution().success;
 }
 
 bool RWSInterface::resetRAPIDProgramPointer()
 {
-
-  return rws_client_.resetRAPIDProgramPointer().success;
+  RWSTracer::Span span("RWSInterface", "resetRAPIDProgramPointer");
+  return writeWithMastership([&]()
+  {
+    return rws_client_.resetRAPIDProgramPointer();
+  });
 }
 
 bool RWSInterface::setMotorsOn()
 {
+  RWSTracer::Span span("RWSInterface", "setMotorsOn");
   return rws_client_.setMotorsOn().success;
 }
 
 bool RWSInterface::setMotorsOff()
 {
+  RWSTracer::Span span("RWSInterface", "setMotorsOff");
   return rws_client_.setMotorsOff().success;
 }
 
-bool RWSInterface::setLeadThroughOn(const std::string mechUnit)
+bool RWSInterface::setLeadThroughOn(const std::string& mechUnit)
 {
+  RWSTracer::Span span("RWSInterface", "setLeadThroughOn");
   return rws_client_.setLeadThroughOn(mechUnit).success;
 }
 
-bool RWSInterface::setLeadThroughOff(const std::string mechUnit)
+bool RWSInterface::setLeadThroughOff(const std::string& mechUnit)
 {
+  RWSTracer::Span span("RWSInterface", "setLeadThroughOff");
   return rws_client_.setLeadThroughOff(mechUnit).success;
 }
 
-std::vector<RWSInterface::RAPIDModuleInfo> RWSInterface::getRAPIDModulesInfo(const std::string task)
+std::vector<RWSInterface::RAPIDModuleInfo> RWSInterface::getRAPIDModulesInfo(const std::string& task)
 {
+  RWSTracer::Span span("RWSInterface", "getRAPIDModulesInfo");
   std::vector<RAPIDModuleInfo> result;
 
   RWSClient::RWSResult rws_result = rws_client_.getRAPIDModulesInfo(task);
@@ -278,6 +796,7 @@ std::vector<RWSInterface::RAPIDModuleInfo> RWSInterface::getRAPIDModulesInfo(con
 
 std::vector<RWSInterface::RAPIDTaskInfo> RWSInterface::getRAPIDTasks()
 {
+  RWSTracer::Span span("RWSInterface", "getRAPIDTasks");
   std::vector<RAPIDTaskInfo> result;
 
   RWSClient::RWSResult rws_result = rws_client_.getRAPIDTasks();
@@ -296,6 +815,7 @@ std::vector<RWSInterface::RAPIDTaskInfo> RWSInterface::getRAPIDTasks()
 
 RWSInterface::SystemInfo RWSInterface::getSystemInfo()
 {
+  RWSTracer::Span span("RWSInterface", "getSystemInfo");
   SystemInfo result;
 
   RWSClient::RWSResult rws_result = rws_client_.getRobotWareSystem();
@@ -319,6 +839,7 @@ RWSInterface::SystemInfo RWSInterface::getSystemInfo()
 
 TriBool RWSInterface::isAutoMode()
 {
+  RWSTracer::Span span("RWSInterface", "isAutoMode");
   // std::cout<<"sono in isAutoMode "<< std::endl;
 
   return compareSingleContent(rws_client_.getPanelOperationMode(),
@@ -328,6 +849,7 @@ TriBool RWSInterface::isAutoMode()
 
 TriBool RWSInterface::isMotorOn()
 {
+  RWSTracer::Span span("RWSInterface", "isMotorOn");
   return compareSingleContent(rws_client_.getPanelControllerState(),
                               XMLAttributes::CLASS_CTRLSTATE,
                               ContollerStates::CONTROLLER_MOTOR_ON);
@@ -335,18 +857,98 @@ TriBool RWSInterface::isMotorOn()
 
 TriBool RWSInterface::isRAPIDRunning()
 {
+  RWSTracer::Span span("RWSInterface", "isRAPIDRunning");
   return compareSingleContent(rws_client_.getRAPIDExecution(),
                               XMLAttributes::CLASS_CTRLEXECSTATE,
                               ContollerStates::RAPID_EXECUTION_RUNNING);
 }
 
-bool RWSInterface::setIOSignal(const std::string iosignal, const std::string value)
+bool RWSInterface::setIOSignal(const std::string& iosignal, const std::string& value)
 {
-  return rws_client_.setIOSignal(iosignal, value).success;
+  RWSTracer::Span span("RWSInterface", "setIOSignal");
+  bool result = rws_client_.setIOSignal(iosignal, value).success;
+
+  if (result)
+  {
+    storeIOSignalState(iosignal, value);
+  }
+
+  return result;
 }
 
-bool RWSInterface::pulseIOSignal(const std::string iosignal, const int lenght)
+std::vector<RWSInterface::IOSignalWriteResult> RWSInterface::setIOSignals(const std::vector<IOSignalWrite>& writes,
+                                                                          const bool skip_unchanged)
 {
+  RWSTracer::Span span("RWSInterface", "setIOSignals");
+  std::vector<IOSignalWriteResult> results(writes.begin(), writes.end());
+  std::vector<size_t> pending;
+
+  {
+    std::lock_guard<std::mutex> lock(iosignal_states_mutex_);
+    std::vector<std::string> keys;
+    std::map<std::string, size_t> last_write;
+
+    for (size_t i = 0; i < writes.size(); ++i)
+    {
+      keys.push_back(getIOSignalStateKey(writes[i].name));
+      last_write[keys[i]] = i;
+    }
+
+    for (size_t i = 0; i < writes.size(); ++i)
+    {
+      if (last_write[keys[i]] != i)
+      {
+        results[i].outcome = IOSignalWriteResult::SKIPPED_SUPERSEDED;
+        continue;
+      }
+
+      std::map<std::string, std::string>::const_iterator state = iosignal_states_.find(keys[i]);
+      if (skip_unchanged && state != iosignal_states_.end() && state->second == writes[i].value)
+      {
+        results[i].outcome = IOSignalWriteResult::SKIPPED_UNCHANGED;
+        continue;
+      }
+
+      pending.push_back(i);
+    }
+  }
+
+  std::vector<RWSClientPool::Job> jobs;
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    IOSignalWriteResult* p_result = &results[pending[i]];
+
+    jobs.push_back([p_result](RWSClient& client)
+    {
+      RWSClient::RWSResult rws_result = client.setIOSignal(p_result->name, p_result->value);
+      p_result->outcome = (rws_result.success ? IOSignalWriteResult::WRITTEN : IOSignalWriteResult::FAILED);
+      p_result->error_message = rws_result.error_message;
+    });
+  }
+
+  client_pool_.execute(jobs);
+
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    if (results[pending[i]].outcome == IOSignalWriteResult::WRITTEN)
+    {
+      storeIOSignalState(results[pending[i]].name, results[pending[i]].value);
+    }
+  }
+
+  return results;
+}
+
+void RWSInterface::clearIOSignalStates()
+{
+  RWSTracer::Span span("RWSInterface", "clearIOSignalStates");
+  std::lock_guard<std::mutex> lock(iosignal_states_mutex_);
+  iosignal_states_.clear();
+}
+
+bool RWSInterface::pulseIOSignal(const std::string& iosignal, const int lenght)
+{
+  RWSTracer::Span span("RWSInterface", "pulseIOSignal");
   setIOSignal(iosignal, "0");
   setIOSignal(iosignal, "1");
   #ifdef _WIN32
@@ -362,59 +964,109 @@ std::string RWSInterface::getRAPIDSymbolData(const std::string& task,
                                              const std::string& module,
                                              const std::string& name)
 {
+  RWSTracer::Span span("RWSInterface", "getRAPIDSymbolData");
   return xmlFindTextContent(rws_client_.getRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name)).p_xml_document,
                             XMLAttributes::CLASS_VALUE);
 }
 
-bool RWSInterface::getRAPIDSymbolData(const std::string task,
-                                      const std::string module,
-                                      const std::string name,
+bool RWSInterface::getRAPIDSymbolData(const std::string& task,
+                                      const std::string& module,
+                                      const std::string& name,
                                       RAPIDSymbolDataAbstract* p_data)
 {
+  RWSTracer::Span span("RWSInterface", "getRAPIDSymbolData");
   return rws_client_.getRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name), p_data).success;
 }
 
-bool RWSInterface::getRAPIDSymbolData(const std::string task,
-                                      const RWSClient::RAPIDSymbolResource symbol,
+bool RWSInterface::getRAPIDSymbolData(const std::string& task,
+                                      const RWSClient::RAPIDSymbolResource& symbol,
                                       RAPIDSymbolDataAbstract* p_data)
 {
+  RWSTracer::Span span("RWSInterface", "getRAPIDSymbolData");
   return rws_client_.getRAPIDSymbolData(RWSClient::RAPIDResource(task, symbol), p_data).success;
 }
 
-bool RWSInterface::getFile(const RWSClient::FileResource resource, std::string* p_file_content)
+bool RWSInterface::getRAPIDSymbolData(const std::string& task,
+                                      const std::string& module,
+                                      const std::string& name,
+                                      RAPIDSymbolDataAbstract* p_data,
+                                      RAPIDSnapshot* p_snapshot)
+{
+  return getRAPIDSymbolData(task, RWSClient::RAPIDSymbolResource(module, name), p_data, p_snapshot);
+}
+
+bool RWSInterface::getRAPIDSymbolData(const std::string& task,
+                                      const RWSClient::RAPIDSymbolResource& symbol,
+                                      RAPIDSymbolDataAbstract* p_data,
+                                      RAPIDSnapshot* p_snapshot)
 {
+  RWSTracer::Span span("RWSInterface", "getRAPIDSymbolData");
+  bool success = rws_client_.getRAPIDSymbolData(RWSClient::RAPIDResource(task, symbol), p_data).success;
+
+  if (success && p_snapshot)
+  {
+    p_snapshot->take(*p_data);
+  }
+
+  return success;
+}
+
+bool RWSInterface::getRAPIDSymbolData(const std::string& task,
+                                      const std::string& module,
+                                      const std::string& name,
+                                      RAPIDValue* p_value)
+{
+  RWSTracer::Span span("RWSInterface", "getRAPIDSymbolData");
+  return rws_client_.getRAPIDSymbolData(RWSClient::RAPIDResource(task, module, name), p_value).success;
+}
+
+bool RWSInterface::getFile(const RWSClient::FileResource& resource, std::string* p_file_content)
+{
+  RWSTracer::Span span("RWSInterface", "getFile");
   return rws_client_.getFile(resource, p_file_content).success;
 }
 
-bool RWSInterface::uploadFile(const RWSClient::FileResource resource, const std::string file_content)
+bool RWSInterface::uploadFile(const RWSClient::FileResource& resource, const std::string& file_content)
 {
+  RWSTracer::Span span("RWSInterface", "uploadFile");
   return rws_client_.uploadFile(resource, file_content).success;
 }
 
-bool RWSInterface::deleteFile(const RWSClient::FileResource resource)
+bool RWSInterface::uploadFile(const RWSClient::FileResource& resource, std::string&& file_content)
 {
+  RWSTracer::Span span("RWSInterface", "uploadFile");
+  return rws_client_.uploadFile(resource, std::move(file_content)).success;
+}
+
+bool RWSInterface::deleteFile(const RWSClient::FileResource& resource)
+{
+  RWSTracer::Span span("RWSInterface", "deleteFile");
   return rws_client_.deleteFile(resource).success;
 }
 
-bool RWSInterface::startSubscription (RWSClient::SubscriptionResources resources)
+bool RWSInterface::startSubscription (const RWSClient::SubscriptionResources& resources)
 {
   return rws_client_.startSubscription(resources).success;
 }
 
 bool RWSInterface::waitForSubscriptionEvent()
 {
+  RWSTracer::Span span("RWSInterface", "waitForSubscriptionEvent");
   RWSClient::RWSResult rws_result = rws_client_.waitForSubscriptionEvent();
+  storeIOSignalStates(rws_result);
 
   return (rws_result.success && !rws_result.p_xml_document.isNull());
 }
 
 bool RWSInterface::waitForSubscriptionEvent(Poco::AutoPtr<Poco::XML::Document>* p_xml_document)
 {
+  RWSTracer::Span span("RWSInterface", "waitForSubscriptionEvent");
   bool result = false;
 
   if (p_xml_document)
   {
     RWSClient::RWSResult rws_result = rws_client_.waitForSubscriptionEvent();
+    storeIOSignalStates(rws_result);
 
     if (rws_result.success && !rws_result.p_xml_document.isNull())
     {
@@ -428,6 +1080,7 @@ bool RWSInterface::waitForSubscriptionEvent(Poco::AutoPtr<Poco::XML::Document>*
 
 bool RWSInterface::endSubscription()
 {
+  RWSTracer::Span span("RWSInterface", "endSubscription");
   return rws_client_.endSubscription().success;
 }
 
@@ -435,6 +1088,7 @@ bool RWSInterface::registerLocalUser(std::string username,
                                      std::string application,
                                      std::string location)
 {
+  RWSTracer::Span span("RWSInterface", "registerLocalUser");
   return rws_client_.registerLocalUser(username, application, location).success;
 }
 
@@ -442,16 +1096,19 @@ bool RWSInterface::registerRemoteUser(std::string username,
                                       std::string application,
                                       std::string location)
 {
+  RWSTracer::Span span("RWSInterface", "registerRemoteUser");
   return rws_client_.registerRemoteUser(username, application, location).success;
 }
 
 bool RWSInterface::requestMasterShip()
 {
+  RWSTracer::Span span("RWSInterface", "requestMasterShip");
   return rws_client_.requestMasterShip().success;
 }
 
 bool RWSInterface::releaseMasterShip()
 {
+  RWSTracer::Span span("RWSInterface", "releaseMasterShip");
   return rws_client_.releaseMasterShip().success;
 }
 
@@ -485,5 +1142,122 @@ TriBool RWSInterface::compareSingleContent(const RWSClient::RWSResult& rws_resul
   return result;
 }
 
+bool RWSInterface::writeWithMastership(const std::function<RWSClient::RWSResult()>& write)
+{
+  RWSClient::RWSResult rws_result = write();
+
+  if (rws_result.success)
+  {
+    return true;
+  }
+
+  if (rws_result.http_status != Poco::Net::HTTPResponse::HTTP_FORBIDDEN || !mastership_manager_.hasLeases())
+  {
+    return false;
+  }
+
+  // The mastership may have been lost (e.g. taken by the FlexPendant), so request it again and retry.
+  RWSMastershipManager::Lease lease = mastership_manager_.acquire();
+
+  return lease.refresh() && write().success;
+}
+
+void RWSInterface::parseMechanicalUnitJointTarget(const RWSClient::RWSResult& rws_result, JointTarget* p_jointtarget)
+{
+  std::stringstream ss;
+
+  ss << "[["
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_1")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_2")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_3")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_4")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_5")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "rax_6")) << "], ["
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_a")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_b")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_c")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_d")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_e")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_f")) << "]]";
+
+  p_jointtarget->parseString(ss.str());
+}
+
+void RWSInterface::parseMechanicalUnitRobTarget(const RWSClient::RWSResult& rws_result, RobTarget* p_robtarget)
+{
+  std::stringstream ss;
+
+  ss << "[["
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "x")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "y")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "z")) << "], ["
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "q1")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "q2")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "q3")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "q4")) << "], ["
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "cf1")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "cf4")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "cf6")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "cfx")) << "], ["
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_a")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_b")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_c")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_d")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_e")) << ","
+     << xmlFindTextContent(rws_result.p_xml_document, XMLAttribute("class", "eax_f")) << "]]";
+
+  p_robtarget->parseString(ss.str());
+}
+
+std::string RWSInterface::getIOSignalStateKey(const std::string& iosignal)
+{
+  return iosignal.substr(iosignal.find_last_of('/') + 1);
+}
+
+void RWSInterface::storeIOSignalState(const std::string& iosignal, const std::string& value)
+{
+  std::lock_guard<std::mutex> lock(iosignal_states_mutex_);
+  iosignal_states_[getIOSignalStateKey(iosignal)] = value;
+}
+
+void RWSInterface::storeIOSignalStates(const RWSClient::RWSResult& rws_result)
+{
+  if (!rws_result.success)
+  {
+    return;
+  }
+
+  // Each IO signal event links to the signal's state resource, e.g. "/rw/iosystem/signals/Local/DRV_1/DO1;state".
+  const std::string prefix = Resources::RW_IOSYSTEM_SIGNALS + "/";
+  std::vector<Poco::XML::Node*> node_list = xmlFindNodes(rws_result.p_xml_document,
+                                                         XMLAttributes::CLASS_IOS_SIGNALSTATE_EV);
+
+  for (size_t i = 0; i < node_list.size(); ++i)
+  {
+    std::string value = xmlFindTextContent(node_list.at(i), XMLAttributes::CLASS_LVALUE);
+    Poco::AutoPtr<Poco::XML::NodeList> p_children(node_list.at(i)->childNodes());
+
+    for (unsigned long j = 0; j < p_children->length() && !value.empty(); ++j)
+    {
+      Poco::XML::Node* p_child = p_children->item(j);
+
+      if (p_child->nodeType() == Poco::XML::Node::ELEMENT_NODE && p_child->nodeName() == "a")
+      {
+        std::string href = static_cast<Poco::XML::Element*>(p_child)->getAttribute("href");
+        size_t start = href.find(prefix);
+        size_t end = href.find(";");
+
+        if (start != std::string::npos)
+        {
+          start += prefix.size();
+          storeIOSignalState(href.substr(start, (end == std::string::npos ? end : end - start)), value);
+        }
+
+        break;
+      }
+    }
+  }
+}
+
 } // end namespace rws
 } // end namespace abb
@@ -0,0 +1,466 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A timer-wheel scheduler for timed and pulsed IO signal writes.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include "abb_librws/rws_io_scheduler.h"
+
+namespace abb
+{
+namespace rws
+{
+typedef SystemConstants::IOSignals IOSignals;
+
+/***********************************************************************************************************************
+ * Class definitions: RWSIOScheduler
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+RWSIOScheduler::RWSIOScheduler(RWSClientPool& client_pool, const Poco::Int64 tick)
+:
+client_pool_(client_pool),
+tick_(std::chrono::microseconds(tick < 1 ? 1 : tick)),
+start_(Clock::now()),
+wheel_(WHEEL_SIZE),
+number_of_actions_(0),
+current_tick_(0),
+next_id_(1),
+expected_latency_(0),
+stop_(false)
+{
+  thread_ = std::thread(&RWSIOScheduler::run, this);
+
+  for (size_t i = 0; i < client_pool_.getMaxSize(); ++i)
+  {
+    workers_.push_back(std::thread(&RWSIOScheduler::work, this));
+  }
+}
+
+RWSIOScheduler::~RWSIOScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+
+    // Falling edges must not be lost (that would leave outputs high), so they are handed to the workers right away.
+    // Everything else, which hasn't started yet, is discarded.
+    std::deque<Action> falls;
+    for (size_t i = 0; i < ready_.size(); ++i)
+    {
+      if (ready_[i].type == Action::PULSE_FALL)
+      {
+        falls.push_back(ready_[i]);
+      }
+    }
+
+    for (size_t i = 0; i < wheel_.size(); ++i)
+    {
+      for (std::list<Action>::const_iterator j = wheel_[i].begin(); j != wheel_[i].end(); ++j)
+      {
+        if (j->type == Action::PULSE_FALL)
+        {
+          falls.push_back(*j);
+        }
+      }
+
+      wheel_[i].clear();
+    }
+
+    number_of_actions_ = 0;
+    ready_.swap(falls);
+  }
+
+  wake_up_.notify_one();
+  work_available_.notify_all();
+
+  // The workers finish the queued falling edges, and the falling edges of pulses that are rising right now.
+  thread_.join();
+  for (size_t i = 0; i < workers_.size(); ++i)
+  {
+    workers_[i].join();
+  }
+}
+
+Poco::UInt64 RWSIOScheduler::pulse(const std::string& iosignal, const Poco::Int64 width, const Poco::Int64 delay)
+{
+  return add(Action::PULSE_RISE, iosignal, IOSignals::HIGH, width, 0, delay);
+}
+
+Poco::UInt64 RWSIOScheduler::setDelayed(const std::string& iosignal, const std::string& value, const Poco::Int64 delay)
+{
+  return add(Action::SET, iosignal, value, 0, 0, delay);
+}
+
+Poco::UInt64 RWSIOScheduler::togglePeriodically(const std::string& iosignal,
+                                                const Poco::Int64 period,
+                                                const unsigned int count)
+{
+  return add(Action::TOGGLE, iosignal, IOSignals::HIGH, period, count, 0);
+}
+
+void RWSIOScheduler::cancel(const Poco::UInt64 id)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (pending_.count(id) > 0)
+  {
+    cancelled_.insert(id);
+  }
+}
+
+void RWSIOScheduler::setPulseCallback(const PulseCallback& callback)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  pulse_callback_ = callback;
+}
+
+std::vector<RWSIOScheduler::PulseReport> RWSIOScheduler::getPulseReports()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<PulseReport> result;
+  result.swap(pulse_reports_);
+  return result;
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+Poco::UInt64 RWSIOScheduler::add(const Action::Type type,
+                                 const std::string& iosignal,
+                                 const std::string& value,
+                                 const Poco::Int64 duration,
+                                 const unsigned int remaining,
+                                 const Poco::Int64 delay)
+{
+  Action action;
+  action.type = type;
+  action.iosignal = iosignal;
+  action.value = value;
+  action.duration = duration;
+  action.remaining = remaining;
+  action.due_tick = 0;
+  action.rise_latency = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    action.id = next_id_++;
+    pending_.insert(action.id);
+  }
+
+  schedule(action, Clock::now() + std::chrono::microseconds(delay));
+
+  return action.id;
+}
+
+void RWSIOScheduler::schedule(Action action, const Clock::time_point due)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (stop_)
+    {
+      // Shutting down: a falling edge is set right away, and anything else is dropped.
+      if (action.type == Action::PULSE_FALL)
+      {
+        ready_.push_back(action);
+        work_available_.notify_all();
+      }
+
+      return;
+    }
+
+    // Round up, so that an action never fires early. Overdue actions are placed in the next tick's slot.
+    Poco::UInt64 due_tick = (due <= start_ ? 0 : (due - start_ + tick_ - Clock::duration(1)) / tick_);
+    action.due_tick = (due_tick <= current_tick_ ? current_tick_ + 1 : due_tick);
+
+    wheel_[action.due_tick % WHEEL_SIZE].push_back(action);
+    ++number_of_actions_;
+  }
+
+  wake_up_.notify_one();
+}
+
+void RWSIOScheduler::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (!stop_)
+  {
+    if (number_of_actions_ == 0)
+    {
+      wake_up_.wait(lock);
+      continue;
+    }
+
+    wake_up_.wait_until(lock, start_ + (current_tick_ + 1) * tick_);
+    if (stop_)
+    {
+      break;
+    }
+
+    // Collect all actions that have become due, and hand them over to the workers.
+    Poco::UInt64 now_tick = (Clock::now() - start_) / tick_;
+    std::vector<Action> due_actions;
+
+    // Visiting one full revolution is enough to find every due action, e.g. after having been idle for a while.
+    if (now_tick - current_tick_ > WHEEL_SIZE)
+    {
+      current_tick_ = now_tick - WHEEL_SIZE;
+    }
+
+    for (; current_tick_ < now_tick; ++current_tick_)
+    {
+      std::list<Action>& slot = wheel_[(current_tick_ + 1) % WHEEL_SIZE];
+
+      for (std::list<Action>::iterator i = slot.begin(); i != slot.end();)
+      {
+        if (i->due_tick <= current_tick_ + 1)
+        {
+          due_actions.push_back(*i);
+          i = slot.erase(i);
+          --number_of_actions_;
+        }
+        else
+        {
+          ++i;
+        }
+      }
+
+    }
+
+    for (size_t i = 0; i < due_actions.size(); ++i)
+    {
+      if (cancelled_.count(due_actions[i].id) > 0 && due_actions[i].type != Action::PULSE_FALL)
+      {
+        cancelled_.erase(due_actions[i].id);
+        pending_.erase(due_actions[i].id);
+      }
+      else
+      {
+        ready_.push_back(due_actions[i]);
+      }
+    }
+
+    if (!due_actions.empty())
+    {
+      work_available_.notify_all();
+    }
+  }
+}
+
+void RWSIOScheduler::work()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true)
+  {
+    // Take the oldest action whose signal isn't busy, so that the actions on each signal keep their order.
+    std::deque<Action>::iterator next = ready_.begin();
+    while (next != ready_.end() && busy_iosignals_.count(next->iosignal) > 0)
+    {
+      ++next;
+    }
+
+    if (next == ready_.end())
+    {
+      // When shutting down, a worker only leaves once nothing is queued. A worker that is executing a rising edge
+      // comes back for its falling edge.
+      if (stop_ && ready_.empty())
+      {
+        break;
+      }
+
+      work_available_.wait(lock);
+      continue;
+    }
+
+    Action action = *next;
+    ready_.erase(next);
+    busy_iosignals_.insert(action.iosignal);
+
+    lock.unlock();
+    execute(action);
+    lock.lock();
+
+    busy_iosignals_.erase(action.iosignal);
+    work_available_.notify_all();
+  }
+}
+
+void RWSIOScheduler::execute(Action& action)
+{
+  Poco::Int64 latency = 0;
+
+  switch (action.type)
+  {
+    case Action::SET:
+    {
+      timedSet(action.iosignal, action.value, &latency);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      cancelled_.erase(action.id);
+      pending_.erase(action.id);
+    }
+    break;
+
+    case Action::PULSE_RISE:
+    {
+      // Make sure the pulse starts from a low signal.
+      timedSet(action.iosignal, IOSignals::LOW, &latency);
+
+      action.rise_start = Clock::now();
+      if (timedSet(action.iosignal, IOSignals::HIGH, &action.rise_latency))
+      {
+        Poco::Int64 expected_latency = 0;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          expected_latency = expected_latency_;
+        }
+
+        // The controller applies a request roughly half way through its round trip. Aim for the falling edge to be
+        // applied exactly "width" after the rising edge was applied.
+        Poco::Int64 offset = action.rise_latency / 2 + action.duration - expected_latency / 2;
+
+        action.type = Action::PULSE_FALL;
+        schedule(action, action.rise_start + std::chrono::microseconds(offset < 0 ? 0 : offset));
+      }
+      else
+      {
+        PulseReport report;
+        report.iosignal = action.iosignal;
+        report.requested_width = action.duration;
+        report.rise_latency = action.rise_latency;
+
+        PulseCallback callback;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          pulse_reports_.push_back(report);
+          cancelled_.erase(action.id);
+          pending_.erase(action.id);
+          callback = pulse_callback_;
+        }
+
+        if (callback)
+        {
+          callback(report);
+        }
+      }
+    }
+    break;
+
+    case Action::PULSE_FALL:
+    {
+      Clock::time_point fall_start = Clock::now();
+
+      PulseReport report;
+      report.iosignal = action.iosignal;
+      report.requested_width = action.duration;
+      report.rise_latency = action.rise_latency;
+      report.success = timedSet(action.iosignal, IOSignals::LOW, &report.fall_latency);
+      report.actual_width = std::chrono::duration_cast<std::chrono::microseconds>(fall_start - action.rise_start).count() +
+                            (report.fall_latency - report.rise_latency) / 2;
+
+      PulseCallback callback;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pulse_reports_.push_back(report);
+        cancelled_.erase(action.id);
+        pending_.erase(action.id);
+        callback = pulse_callback_;
+      }
+
+      if (callback)
+      {
+        callback(report);
+      }
+    }
+    break;
+
+    case Action::TOGGLE:
+    {
+      Clock::time_point toggle_start = Clock::now();
+      timedSet(action.iosignal, action.value, &latency);
+
+      if (action.remaining != 1)
+      {
+        action.remaining = (action.remaining == 0 ? 0 : action.remaining - 1);
+        action.value = (action.value == IOSignals::HIGH ? IOSignals::LOW : IOSignals::HIGH);
+        schedule(action, toggle_start + std::chrono::microseconds(action.duration));
+      }
+      else
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_.erase(action.id);
+        pending_.erase(action.id);
+      }
+    }
+    break;
+  }
+}
+
+bool RWSIOScheduler::timedSet(const std::string& iosignal, const std::string& value, Poco::Int64* p_latency)
+{
+  RWSClientPool::Lease lease = client_pool_.acquire();
+
+  Clock::time_point start = Clock::now();
+  bool result = lease->setIOSignal(iosignal, value).success;
+  Poco::Int64 latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+  if (p_latency)
+  {
+    *p_latency = latency;
+  }
+
+  if (result)
+  {
+    // Exponential moving average, with a weight of 1/8 for the newest sample.
+    std::lock_guard<std::mutex> lock(mutex_);
+    expected_latency_ = (expected_latency_ == 0 ? latency : expected_latency_ + (latency - expected_latency_) / 8);
+  }
+
+  return result;
+}
+
+} // end namespace rws
+} // end namespace abb
@@ -0,0 +1,261 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Sharing of the mastership (of the edit domain) between several users of the same RWS session.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include "abb_librws/rws_mastership_manager.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Class definitions: RWSMastershipManager::Lease
+ */
+
+RWSMastershipManager::Lease::Lease(const Lease& other)
+:
+p_manager_(other.p_manager_),
+held_(other.held_)
+{
+  if (p_manager_)
+  {
+    p_manager_->retain();
+  }
+}
+
+RWSMastershipManager::Lease::Lease(Lease&& other)
+:
+p_manager_(other.p_manager_),
+held_(other.held_)
+{
+  other.p_manager_ = 0;
+  other.held_ = false;
+}
+
+RWSMastershipManager::Lease& RWSMastershipManager::Lease::operator=(Lease other)
+{
+  std::swap(p_manager_, other.p_manager_);
+  std::swap(held_, other.held_);
+  return *this;
+}
+
+RWSMastershipManager::Lease::~Lease()
+{
+  release();
+}
+
+bool RWSMastershipManager::Lease::refresh()
+{
+  if (p_manager_)
+  {
+    held_ = p_manager_->ensureHeld(true);
+  }
+
+  return held_;
+}
+
+void RWSMastershipManager::Lease::release()
+{
+  if (p_manager_)
+  {
+    p_manager_->unretain();
+    p_manager_ = 0;
+    held_ = false;
+  }
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RWSMastershipManager
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+RWSMastershipManager::RWSMastershipManager(RWSClient& client, const Poco::Int64 idle_timeout)
+:
+client_(client),
+idle_timeout_(std::chrono::microseconds(idle_timeout < 0 ? 0 : idle_timeout)),
+references_(0),
+held_(false),
+idle_since_(Clock::now()),
+stop_(false)
+{
+  thread_ = std::thread(&RWSMastershipManager::run, this);
+}
+
+RWSMastershipManager::~RWSMastershipManager()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+
+  wake_up_.notify_one();
+  thread_.join();
+
+  std::lock_guard<std::mutex> request_lock(request_mutex_);
+
+  if (held_)
+  {
+    client_.releaseMasterShip();
+    held_ = false;
+  }
+}
+
+RWSMastershipManager::Lease RWSMastershipManager::acquire()
+{
+  retain();
+  return Lease(this, ensureHeld(false));
+}
+
+void RWSMastershipManager::notifyLost()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  held_ = false;
+}
+
+bool RWSMastershipManager::isHeld()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return held_;
+}
+
+bool RWSMastershipManager::hasLeases()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return references_ > 0;
+}
+
+void RWSMastershipManager::setIdleTimeout(const Poco::Int64 idle_timeout)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_timeout_ = std::chrono::microseconds(idle_timeout < 0 ? 0 : idle_timeout);
+  }
+
+  wake_up_.notify_one();
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+void RWSMastershipManager::retain()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++references_;
+}
+
+void RWSMastershipManager::unretain()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (references_ > 0 && --references_ == 0)
+    {
+      idle_since_ = Clock::now();
+    }
+  }
+
+  wake_up_.notify_one();
+}
+
+bool RWSMastershipManager::ensureHeld(const bool force)
+{
+  // Serialize with other requests, and with the background thread's release.
+  std::lock_guard<std::mutex> request_lock(request_mutex_);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (held_ && !force)
+    {
+      return true;
+    }
+  }
+
+  bool result = client_.requestMasterShip().success;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  held_ = result;
+  return result;
+}
+
+void RWSMastershipManager::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (!stop_)
+  {
+    if (!held_ || references_ > 0)
+    {
+      wake_up_.wait(lock);
+      continue;
+    }
+
+    Clock::time_point deadline = idle_since_ + idle_timeout_;
+
+    if (Clock::now() < deadline)
+    {
+      wake_up_.wait_until(lock, deadline);
+      continue;
+    }
+
+    // Take the locks in the same order as ensureHeld(), and check again since a lease may have been acquired.
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> request_lock(request_mutex_);
+      lock.lock();
+
+      if (!stop_ && held_ && references_ == 0 && Clock::now() >= idle_since_ + idle_timeout_)
+      {
+        held_ = false;
+        lock.unlock();
+        client_.releaseMasterShip();
+        lock.lock();
+      }
+    }
+  }
+}
+
+} // end namespace rws
+} // end namespace abb
@@ -0,0 +1,611 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A registry of RWS client metrics, rendered as Prometheus text or JSON.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <sstream>
+
+#include "Poco/Exception.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/ServerSocket.h"
+
+#include "abb_librws/rws_metrics.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief A function for escaping a Prometheus label value, or a JSON string.
+ *
+ * \param value for the value to escape.
+ *
+ * \return std::string containing the escaped value.
+ */
+static std::string escapeValue(const std::string& value)
+{
+  std::string result;
+  result.reserve(value.size());
+
+  for (size_t i = 0; i < value.size(); ++i)
+  {
+    switch (value[i])
+    {
+      case '\\':
+        result += "\\\\";
+      break;
+
+      case '"':
+        result += "\\\"";
+      break;
+
+      case '\n':
+        result += "\\n";
+      break;
+
+      default:
+        result += value[i];
+      break;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * \brief A function for mapping a response status class (see RWSEndpointStatistics) to a label value.
+ *
+ * \param status_class for the status class.
+ *
+ * \return std::string containing the label value (e.g. "2xx", or "error" for communications without a response).
+ */
+static std::string mapStatusClass(const size_t status_class)
+{
+  return (status_class == 0 ? "error" : std::to_string(status_class) + "xx");
+}
+
+/**
+ * \brief A function for writing the header of a Prometheus metric family.
+ *
+ * \param ss for the stream to write to.
+ * \param name for the metric's name.
+ * \param type for the metric's type (e.g. "counter").
+ * \param help for the metric's description.
+ */
+static void writeFamily(std::stringstream& ss, const char* name, const char* type, const char* help)
+{
+  ss << "# HELP " << name << " " << help << "\n"
+     << "# TYPE " << name << " " << type << "\n";
+}
+
+/**
+ * \brief A function for writing a Prometheus sample of a client-level metric.
+ *
+ * \param ss for the stream to write to.
+ * \param name for the metric's name.
+ * \param client for the client's name.
+ * \param value for the sample's value.
+ */
+template <typename T>
+static void writeSample(std::stringstream& ss, const char* name, const std::string& client, const T value)
+{
+  ss << name << "{client=\"" << escapeValue(client) << "\"} " << value << "\n";
+}
+
+/**
+ * \brief The phase names used for the phase timing metrics.
+ */
+static const char* const PHASE_NAMES[] = {"lock_wait", "connect", "send", "server", "receive", "authentication"};
+
+/**
+ * \brief A function for retrieving a phase's time from a timing struct.
+ *
+ * \param timing for the timing.
+ * \param phase for the phase's index (see PHASE_NAMES).
+ *
+ * \return Poco::Int64 containing the phase's time [microseconds].
+ */
+static Poco::Int64 getPhase(const POCOClient::POCOResult::Timing& timing, const size_t phase)
+{
+  const Poco::Int64 phases[] = {timing.lock_wait, timing.connect, timing.send,
+                                timing.server, timing.receive, timing.authentication};
+  return phases[phase];
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RWSMetricsRequestHandler
+ */
+
+/**
+ * \brief A class for handling the embedded HTTP server's requests.
+ */
+class RWSMetricsRequestHandler : public Poco::Net::HTTPRequestHandler
+{
+public:
+  /**
+   * \brief A constructor.
+   *
+   * \param metrics for the metrics registry to serve.
+   */
+  RWSMetricsRequestHandler(RWSMetrics& metrics) : metrics_(metrics) {}
+
+  /**
+   * \brief A method for handling a request.
+   *
+   * \param request for the request.
+   * \param response for the response.
+   */
+  void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+  {
+    std::string body;
+
+    if (request.getURI() == "/metrics")
+    {
+      body = metrics_.renderPrometheus();
+      response.setContentType("text/plain; version=0.0.4");
+    }
+    else if (request.getURI() == "/metrics.json")
+    {
+      body = metrics_.renderJSON();
+      response.setContentType("application/json");
+    }
+    else
+    {
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
+    }
+
+    response.sendBuffer(body.data(), body.size());
+  }
+
+private:
+  /**
+   * \brief The metrics registry to serve.
+   */
+  RWSMetrics& metrics_;
+};
+
+/***********************************************************************************************************************
+ * Class definitions: RWSMetricsRequestHandlerFactory
+ */
+
+/**
+ * \brief A class for creating the embedded HTTP server's request handlers.
+ */
+class RWSMetricsRequestHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory
+{
+public:
+  /**
+   * \brief A constructor.
+   *
+   * \param metrics for the metrics registry to serve.
+   */
+  RWSMetricsRequestHandlerFactory(RWSMetrics& metrics) : metrics_(metrics) {}
+
+  /**
+   * \brief A method for creating a request handler (the same kind for every request).
+   *
+   * \return Poco::Net::HTTPRequestHandler* for the request handler.
+   */
+  Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest&)
+  {
+    return new RWSMetricsRequestHandler(metrics_);
+  }
+
+private:
+  /**
+   * \brief The metrics registry to serve.
+   */
+  RWSMetrics& metrics_;
+};
+
+/***********************************************************************************************************************
+ * Class definitions: RWSMetrics
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+RWSMetrics::RWSMetrics() {}
+
+RWSMetrics::~RWSMetrics()
+{
+  stopServer();
+}
+
+void RWSMetrics::add(const std::string& name, RWSClient& client, RWSClientPool* p_pool)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Source& source = sources_[name];
+  source.p_client = &client;
+  source.p_pool = p_pool;
+}
+
+void RWSMetrics::remove(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  sources_.erase(name);
+}
+
+std::vector<RWSMetrics::ClientSnapshot> RWSMetrics::collect()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<ClientSnapshot> result;
+  result.reserve(sources_.size());
+
+  for (std::map<std::string, Source>::const_iterator it = sources_.begin(); it != sources_.end(); ++it)
+  {
+    ClientSnapshot snapshot;
+    snapshot.name = it->first;
+    snapshot.transport = it->second.p_client->getTransportStatistics();
+    snapshot.response_cache = it->second.p_client->getResponseCacheStatistics();
+    snapshot.endpoints = it->second.p_client->getEndpointStatistics();
+    snapshot.has_pool = (it->second.p_pool != 0);
+    snapshot.pool = (snapshot.has_pool ? it->second.p_pool->getStatistics() : RWSClientPool::Statistics());
+
+    result.push_back(snapshot);
+  }
+
+  return result;
+}
+
+std::string RWSMetrics::renderPrometheus()
+{
+  std::vector<ClientSnapshot> snapshots = collect();
+  std::stringstream ss;
+
+  writeFamily(ss, "rws_requests_total", "counter", "RWS requests, by endpoint and response status class.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    for (size_t j = 0; j < snapshots[i].endpoints.size(); ++j)
+    {
+      const RWSEndpointStatistics::Snapshot& endpoint = snapshots[i].endpoints[j];
+
+      for (size_t k = 0; k < RWSEndpointStatistics::NUMBER_OF_STATUS_CLASSES; ++k)
+      {
+        if (endpoint.statuses[k] > 0)
+        {
+          ss << "rws_requests_total{client=\"" << escapeValue(snapshots[i].name) << "\",endpoint=\"" << endpoint.name
+             << "\",status=\"" << mapStatusClass(k) << "\"} " << endpoint.statuses[k] << "\n";
+        }
+      }
+    }
+  }
+
+  writeFamily(ss, "rws_request_failures_total", "counter",
+              "RWS requests that failed (communication errors or unexpected statuses), by endpoint.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    for (size_t j = 0; j < snapshots[i].endpoints.size(); ++j)
+    {
+      const RWSEndpointStatistics::Snapshot& endpoint = snapshots[i].endpoints[j];
+      ss << "rws_request_failures_total{client=\"" << escapeValue(snapshots[i].name) << "\",endpoint=\""
+         << endpoint.name << "\"} " << endpoint.failures << "\n";
+    }
+  }
+
+  writeFamily(ss, "rws_request_duration_seconds", "histogram", "RWS request latencies, by endpoint.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    for (size_t j = 0; j < snapshots[i].endpoints.size(); ++j)
+    {
+      const RWSEndpointStatistics::Snapshot& endpoint = snapshots[i].endpoints[j];
+      std::string labels = "client=\"" + escapeValue(snapshots[i].name) + "\",endpoint=\"" + endpoint.name + "\"";
+
+      Poco::UInt64 cumulative = 0;
+      for (size_t k = 0; k < RWSEndpointStatistics::NUMBER_OF_BUCKETS - 1; ++k)
+      {
+        cumulative += endpoint.buckets[k];
+        ss << "rws_request_duration_seconds_bucket{" << labels << ",le=\""
+           << RWSEndpointStatistics::BUCKET_UPPER_BOUNDS[k] / 1e6 << "\"} " << cumulative << "\n";
+      }
+      ss << "rws_request_duration_seconds_bucket{" << labels << ",le=\"+Inf\"} " << endpoint.count << "\n"
+         << "rws_request_duration_seconds_sum{" << labels << "} " << endpoint.total_duration / 1e6 << "\n"
+         << "rws_request_duration_seconds_count{" << labels << "} " << endpoint.count << "\n";
+    }
+  }
+
+  writeFamily(ss, "rws_request_phase_seconds_total", "counter", "Time spent in the RWS requests' phases, by endpoint.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    for (size_t j = 0; j < snapshots[i].endpoints.size(); ++j)
+    {
+      const RWSEndpointStatistics::Snapshot& endpoint = snapshots[i].endpoints[j];
+
+      for (size_t k = 0; k < sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]); ++k)
+      {
+        ss << "rws_request_phase_seconds_total{client=\"" << escapeValue(snapshots[i].name) << "\",endpoint=\""
+           << endpoint.name << "\",phase=\"" << PHASE_NAMES[k] << "\"} "
+           << getPhase(endpoint.total_timing, k) / 1e6 << "\n";
+      }
+    }
+  }
+
+  writeFamily(ss, "rws_subscription_events_total", "counter", "Received RWS subscription events.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    Poco::UInt64 events = 0;
+    for (size_t j = 0; j < snapshots[i].endpoints.size(); ++j)
+    {
+      if (snapshots[i].endpoints[j].endpoint == EndpointDescriptor::WAIT_FOR_SUBSCRIPTION_EVENT)
+      {
+        events = snapshots[i].endpoints[j].count - snapshots[i].endpoints[j].failures;
+      }
+    }
+    writeSample(ss, "rws_subscription_events_total", snapshots[i].name, events);
+  }
+
+  writeFamily(ss, "rws_http_exchanges_total", "counter", "HTTP exchanges, including retries and authentications.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_http_exchanges_total", snapshots[i].name, snapshots[i].transport.exchanges);
+  }
+
+  writeFamily(ss, "rws_reconnects_total", "counter", "HTTP (re)connections.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_reconnects_total", snapshots[i].name, snapshots[i].transport.reconnects);
+  }
+
+  writeFamily(ss, "rws_authentications_total", "counter", "HTTP exchanges repeated with credentials.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_authentications_total", snapshots[i].name, snapshots[i].transport.authentications);
+  }
+
+  writeFamily(ss, "rws_server_error_retries_total", "counter", "HTTP requests repeated because of a server error.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_server_error_retries_total", snapshots[i].name, snapshots[i].transport.server_error_retries);
+  }
+
+  writeFamily(ss, "rws_transport_failures_total", "counter", "Failed communications (e.g. timeouts).");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_transport_failures_total", snapshots[i].name, snapshots[i].transport.failures);
+  }
+
+  writeFamily(ss, "rws_websocket_connects_total", "counter", "WebSocket connections.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_websocket_connects_total", snapshots[i].name, snapshots[i].transport.websocket_connects);
+  }
+
+  writeFamily(ss, "rws_websocket_frames_total", "counter", "Received (non-ping) WebSocket frames.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_websocket_frames_total", snapshots[i].name, snapshots[i].transport.websocket_frames);
+  }
+
+  writeFamily(ss, "rws_response_cache_hits_total", "counter", "Requests answered from the response cache.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_response_cache_hits_total", snapshots[i].name, snapshots[i].response_cache.hits);
+  }
+
+  writeFamily(ss, "rws_response_cache_misses_total", "counter", "Cacheable requests sent to the robot controller.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    writeSample(ss, "rws_response_cache_misses_total", snapshots[i].name, snapshots[i].response_cache.misses);
+  }
+
+  writeFamily(ss, "rws_response_cache_hit_ratio", "gauge", "Ratio of cacheable requests answered from the cache.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    Poco::UInt64 total = snapshots[i].response_cache.hits + snapshots[i].response_cache.misses;
+    writeSample(ss, "rws_response_cache_hit_ratio", snapshots[i].name,
+                (total == 0 ? 0.0 : double(snapshots[i].response_cache.hits) / total));
+  }
+
+  writeFamily(ss, "rws_pool_acquisitions_total", "counter", "Leases of pooled clients.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    if (snapshots[i].has_pool)
+    {
+      writeSample(ss, "rws_pool_acquisitions_total", snapshots[i].name, snapshots[i].pool.acquisitions);
+    }
+  }
+
+  writeFamily(ss, "rws_pool_waits_total", "counter", "Leases that had to wait for a pooled client.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    if (snapshots[i].has_pool)
+    {
+      writeSample(ss, "rws_pool_waits_total", snapshots[i].name, snapshots[i].pool.waits);
+    }
+  }
+
+  writeFamily(ss, "rws_pool_wait_seconds_total", "counter", "Time spent waiting for pooled clients.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    if (snapshots[i].has_pool)
+    {
+      writeSample(ss, "rws_pool_wait_seconds_total", snapshots[i].name, snapshots[i].pool.total_wait / 1e6);
+    }
+  }
+
+  writeFamily(ss, "rws_pool_clients", "gauge", "Clients created by the pool.");
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    if (snapshots[i].has_pool)
+    {
+      writeSample(ss, "rws_pool_clients", snapshots[i].name, snapshots[i].pool.clients);
+    }
+  }
+
+  return ss.str();
+}
+
+std::string RWSMetrics::renderJSON()
+{
+  std::vector<ClientSnapshot> snapshots = collect();
+  std::stringstream ss;
+
+  ss << "{\"clients\":[";
+
+  for (size_t i = 0; i < snapshots.size(); ++i)
+  {
+    const ClientSnapshot& snapshot = snapshots[i];
+
+    ss << (i == 0 ? "" : ",")
+       << "{\"name\":\"" << escapeValue(snapshot.name) << "\""
+       << ",\"transport\":{\"exchanges\":" << snapshot.transport.exchanges
+       << ",\"reconnects\":" << snapshot.transport.reconnects
+       << ",\"authentications\":" << snapshot.transport.authentications
+       << ",\"server_error_retries\":" << snapshot.transport.server_error_retries
+       << ",\"failures\":" << snapshot.transport.failures
+       << ",\"websocket_connects\":" << snapshot.transport.websocket_connects
+       << ",\"websocket_frames\":" << snapshot.transport.websocket_frames << "}"
+       << ",\"response_cache\":{\"hits\":" << snapshot.response_cache.hits
+       << ",\"misses\":" << snapshot.response_cache.misses << "}";
+
+    if (snapshot.has_pool)
+    {
+      ss << ",\"pool\":{\"acquisitions\":" << snapshot.pool.acquisitions
+         << ",\"waits\":" << snapshot.pool.waits
+         << ",\"total_wait_us\":" << snapshot.pool.total_wait
+         << ",\"clients\":" << snapshot.pool.clients << "}";
+    }
+
+    ss << ",\"endpoints\":[";
+
+    for (size_t j = 0; j < snapshot.endpoints.size(); ++j)
+    {
+      const RWSEndpointStatistics::Snapshot& endpoint = snapshot.endpoints[j];
+
+      ss << (j == 0 ? "" : ",")
+         << "{\"name\":\"" << endpoint.name << "\""
+         << ",\"count\":" << endpoint.count
+         << ",\"failures\":" << endpoint.failures
+         << ",\"statuses\":{";
+
+      bool first = true;
+      for (size_t k = 0; k < RWSEndpointStatistics::NUMBER_OF_STATUS_CLASSES; ++k)
+      {
+        if (endpoint.statuses[k] > 0)
+        {
+          ss << (first ? "" : ",") << "\"" << mapStatusClass(k) << "\":" << endpoint.statuses[k];
+          first = false;
+        }
+      }
+
+      ss << "},\"buckets_us\":[";
+      for (size_t k = 0; k < RWSEndpointStatistics::NUMBER_OF_BUCKETS; ++k)
+      {
+        ss << (k == 0 ? "" : ",") << "{\"le\":";
+        if (k < RWSEndpointStatistics::NUMBER_OF_BUCKETS - 1)
+        {
+          ss << RWSEndpointStatistics::BUCKET_UPPER_BOUNDS[k];
+        }
+        else
+        {
+          ss << "null";
+        }
+        ss << ",\"count\":" << endpoint.buckets[k] << "}";
+      }
+
+      ss << "],\"total_duration_us\":" << endpoint.total_duration << ",\"phases_us\":{";
+      for (size_t k = 0; k < sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]); ++k)
+      {
+        ss << (k == 0 ? "" : ",") << "\"" << PHASE_NAMES[k] << "\":" << getPhase(endpoint.total_timing, k);
+      }
+      ss << "},\"exchanges\":" << endpoint.total_timing.exchanges << "}";
+    }
+
+    ss << "]}";
+  }
+
+  ss << "]}";
+
+  return ss.str();
+}
+
+bool RWSMetrics::startServer(const unsigned short port)
+{
+  std::lock_guard<std::mutex> lock(server_mutex_);
+
+  if (p_server_)
+  {
+    return false;
+  }
+
+  try
+  {
+    Poco::Net::HTTPServerParams::Ptr p_params = new Poco::Net::HTTPServerParams();
+    p_params->setMaxThreads(1);
+
+    p_server_.reset(new Poco::Net::HTTPServer(new RWSMetricsRequestHandlerFactory(*this),
+                                              Poco::Net::ServerSocket(Poco::Net::SocketAddress("127.0.0.1", port)),
+                                              p_params));
+    p_server_->start();
+  }
+  catch (const Poco::Exception&)
+  {
+    p_server_.reset();
+    return false;
+  }
+
+  return true;
+}
+
+void RWSMetrics::stopServer()
+{
+  std::lock_guard<std::mutex> lock(server_mutex_);
+
+  if (p_server_)
+  {
+    p_server_->stop();
+    p_server_.reset();
+  }
+}
+
+} // end namespace rws
+} // end namespace abb
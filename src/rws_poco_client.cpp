@@ -43,13 +43,16 @@
  ***********************************************************************************************************************
  */
 
+#include <chrono>
 #include <sstream>
+#include <utility>
 
 #include "Poco/Net/HTTPRequest.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/StreamCopier.h"
 
 #include "abb_librws/rws_poco_client.h"
+#include "abb_librws/rws_tracer.h"
 
 using namespace Poco;
 using namespace Poco::Net;
@@ -58,6 +61,22 @@ namespace abb
 {
 namespace rws
 {
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief A function for computing the time elapsed since a time point.
+ *
+ * \param start for the time point.
+ *
+ * \return Poco::Int64 containing the elapsed time [microseconds].
+ */
+static Poco::Int64 elapsedMicroseconds(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 /***********************************************************************************************************************
  * Struct definitions: POCOClient::POCOResult
  */
@@ -67,7 +86,7 @@ namespace rws
  */
 
 void POCOClient::POCOResult::addHTTPRequestInfo(const Poco::Net::HTTPRequest& request,
-                                                const std::string request_content)
+                                                const std::string& request_content)
 {
   poco_info.http.request.method = request.getMethod();
   poco_info.http.request.uri = request.getURI();
@@ -75,7 +94,7 @@ void POCOClient::POCOResult::addHTTPRequestInfo(const Poco::Net::HTTPRequest& re
 }
 
 void POCOClient::POCOResult::addHTTPResponseInfo(const Poco::Net::HTTPResponse& response,
-                                                 const std::string response_content)
+                                                 std::string response_content)
 {
   std::string header_info;
 
@@ -86,14 +105,14 @@ void POCOClient::POCOResult::addHTTPResponseInfo(const Poco::Net::HTTPResponse&
 
   poco_info.http.response.status = response.getStatus();
   poco_info.http.response.header_info = header_info;
-  poco_info.http.response.content = response_content;
+  poco_info.http.response.content = std::move(response_content);
 }
 
 void POCOClient::POCOResult::addWebSocketFrameInfo(const int flags,
-                                                   const std::string frame_content)
+                                                   std::string frame_content)
 {
   poco_info.websocket.flags = flags;
-  poco_info.websocket.frame_content = frame_content;
+  poco_info.websocket.frame_content = std::move(frame_content);
 }
 
 /************************************************************
@@ -101,6 +120,16 @@ void POCOClient::POCOResult::addWebSocketFrameInfo(const int flags,
  */
 
 std::string POCOClient::POCOResult::mapGeneralStatus() const
+{
+  return mapGeneralStatus(status);
+}
+
+std::string POCOClient::POCOResult::mapWebSocketOpcode() const
+{
+  return mapWebSocketOpcode(poco_info.websocket.flags);
+}
+
+std::string POCOClient::POCOResult::mapGeneralStatus(const GeneralStatus status)
 {
   std::string result;
 
@@ -142,11 +171,11 @@ std::string POCOClient::POCOResult::mapGeneralStatus() const
   return result;
 }
 
-std::string POCOClient::POCOResult::mapWebSocketOpcode() const
+std::string POCOClient::POCOResult::mapWebSocketOpcode(const int flags)
 {
   std::string result;
 
-  switch (poco_info.websocket.flags & WebSocket::FRAME_OP_BITMASK)
+  switch (flags & WebSocket::FRAME_OP_BITMASK)
   {
     case WebSocket::FRAME_OP_CONT:
       result = "FRAME_OP_CONT";
@@ -222,35 +251,41 @@ std::string POCOClient::POCOResult::toString(const bool verbose, const size_t in
  * Primary methods
  */
 
-POCOClient::POCOResult POCOClient::httpGet(const std::string uri)
+POCOClient::POCOResult POCOClient::httpGet(const std::string& uri)
 {
   return makeHTTPRequest(HTTPRequest::HTTP_GET, uri);
 }
 
-POCOClient::POCOResult POCOClient::httpPost(const std::string uri, const std::string content)
+POCOClient::POCOResult POCOClient::httpPost(const std::string& uri, std::string content)
 {
-  return makeHTTPRequest(HTTPRequest::HTTP_POST, uri, content);
+  return makeHTTPRequest(HTTPRequest::HTTP_POST, uri, std::move(content));
 }
 
-POCOClient::POCOResult POCOClient::httpPut(const std::string uri, const std::string content)
+POCOClient::POCOResult POCOClient::httpPut(const std::string& uri, std::string content)
 {
-  return makeHTTPRequest(HTTPRequest::HTTP_PUT, uri, content);
+  return makeHTTPRequest(HTTPRequest::HTTP_PUT, uri, std::move(content));
 }
 
-POCOClient::POCOResult POCOClient::httpDelete(const std::string uri)
+POCOClient::POCOResult POCOClient::httpDelete(const std::string& uri)
 {
   return makeHTTPRequest(HTTPRequest::HTTP_DELETE, uri);
 }
 
-POCOClient::POCOResult POCOClient::makeHTTPRequest(const std::string method,
-                                                   const std::string uri,
-                                                   const std::string content)
+POCOClient::POCOResult POCOClient::makeHTTPRequest(const std::string& method,
+                                                   const std::string& uri,
+                                                   std::string content)
 {
-  // Lock the object's mutex. It is released when the method goes out of scope.
-  ScopedLock<Mutex> lock(http_mutex_);
+  // The method is one of Poco's (static) method names, i.e. it outlives the trace.
+  RWSTracer::Span span("HTTP", method.c_str());
 
   // Result of the communication.
   POCOResult result;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  result.timing.start = std::chrono::duration_cast<std::chrono::microseconds>(start.time_since_epoch()).count();
+
+  // Lock the object's mutex. It is released when the method goes out of scope.
+  ScopedLock<Mutex> lock(http_mutex_);
+  result.timing.lock_wait = elapsedMicroseconds(start);
 
   // The response and the request.
   HTTPResponse response;
@@ -295,6 +330,7 @@ POCOClient::POCOResult POCOClient::makeHTTPRequest(const std::string method,
     // Check if there was a server error, if so, make another attempt with a clean sheet.
     if (response.getStatus() >= HTTPResponse::HTTP_INTERNAL_SERVER_ERROR)
     {
+      count(SERVER_ERROR_RETRIES);
       http_client_session_.reset();
       request.erase(HTTPRequest::COOKIE);
       sendAndReceive(result, request, response, content);
@@ -330,22 +366,32 @@ POCOClient::POCOResult POCOClient::makeHTTPRequest(const std::string method,
 
   if (result.status != POCOResult::OK)
   {
+    count(FAILURES);
     cookies_.clear();
     http_client_session_.reset();
   }
 
+  // Record the request content once (instead of once per attempt), without copying it.
+  result.poco_info.http.request.content = std::move(content);
+  result.duration = elapsedMicroseconds(start);
+
   return result;
 }
 
-POCOClient::POCOResult POCOClient::webSocketConnect(const std::string uri,
-                                                    const std::string protocol,
+POCOClient::POCOResult POCOClient::webSocketConnect(const std::string& uri,
+                                                    const std::string& protocol,
                                                     const Poco::Int64 timeout)
 {
-  // Lock the object's mutex. It is released when the method goes out of scope.
-  ScopedLock<Mutex> lock(http_mutex_);
+  RWSTracer::Span span("WebSocket", "connect");
 
   // Result of the communication.
   POCOResult result;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  result.timing.start = std::chrono::duration_cast<std::chrono::microseconds>(start.time_since_epoch()).count();
+
+  // Lock the object's mutex. It is released when the method goes out of scope.
+  ScopedLock<Mutex> lock(http_mutex_);
+  result.timing.lock_wait = elapsedMicroseconds(start);
 
   // The response and the request.
   HTTPResponse response;
@@ -357,7 +403,11 @@ POCOClient::POCOResult POCOClient::webSocketConnect(const std::string uri,
   try
   {
     result.addHTTPRequestInfo(request);
+    std::chrono::steady_clock::time_point connect_start = std::chrono::steady_clock::now();
     p_websocket_ = new WebSocket(http_client_session_, request, response);
+    result.timing.connect = elapsedMicroseconds(connect_start);
+    result.timing.exchanges = 1;
+    count(WEBSOCKET_CONNECTS);
     p_websocket_->setReceiveTimeout(Poco::Timespan(timeout));
       
     result.addHTTPResponseInfo(response);
@@ -386,19 +436,27 @@ POCOClient::POCOResult POCOClient::webSocketConnect(const std::string uri,
 
   if (result.status != POCOResult::OK)
   {
+    count(FAILURES);
     http_client_session_.reset();
   }
 
+  result.duration = elapsedMicroseconds(start);
+
   return result;
 }
 
 POCOClient::POCOResult POCOClient::webSocketRecieveFrame()
 {
-  // Lock the object's mutex. It is released when the method goes out of scope.
-  ScopedLock<Mutex> lock(websocket_mutex_);
+  RWSTracer::Span span("WebSocket", "receiveFrame");
 
   // Result of the communication.
   POCOResult result;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  result.timing.start = std::chrono::duration_cast<std::chrono::microseconds>(start.time_since_epoch()).count();
+
+  // Lock the object's mutex. It is released when the method goes out of scope.
+  ScopedLock<Mutex> lock(websocket_mutex_);
+  result.timing.lock_wait = elapsedMicroseconds(start);
 
   // Attempt the communication.
   try
@@ -437,7 +495,8 @@ POCOClient::POCOResult POCOClient::webSocketRecieveFrame()
         p_websocket_ = 0;
       }
 
-      result.addWebSocketFrameInfo(flags, content);
+      result.addWebSocketFrameInfo(flags, std::move(content));
+      count(WEBSOCKET_FRAMES);
       result.status = POCOResult::OK;
     }
     else
@@ -468,12 +527,30 @@ POCOClient::POCOResult POCOClient::webSocketRecieveFrame()
 
   if (result.status != POCOResult::OK)
   {
+    count(FAILURES);
     http_client_session_.reset();
   }
 
+  result.duration = elapsedMicroseconds(start);
+
   return result;
 }
 
+POCOClient::TransportStatistics POCOClient::getTransportStatistics() const
+{
+  TransportStatistics statistics;
+
+  statistics.exchanges = transport_counters_[EXCHANGES].load(std::memory_order_relaxed);
+  statistics.reconnects = transport_counters_[RECONNECTS].load(std::memory_order_relaxed);
+  statistics.authentications = transport_counters_[AUTHENTICATIONS].load(std::memory_order_relaxed);
+  statistics.server_error_retries = transport_counters_[SERVER_ERROR_RETRIES].load(std::memory_order_relaxed);
+  statistics.failures = transport_counters_[FAILURES].load(std::memory_order_relaxed);
+  statistics.websocket_connects = transport_counters_[WEBSOCKET_CONNECTS].load(std::memory_order_relaxed);
+  statistics.websocket_frames = transport_counters_[WEBSOCKET_FRAMES].load(std::memory_order_relaxed);
+
+  return statistics;
+}
+
 /************************************************************
  * Auxiliary methods
  */
@@ -481,28 +558,53 @@ POCOClient::POCOResult POCOClient::webSocketRecieveFrame()
 void POCOClient::sendAndReceive(POCOResult& result,
                                 HTTPRequest& request,
                                 HTTPResponse& response,
-                                const std::string request_content)
+                                const std::string& request_content)
 {
-  // Add request info to the result.
-  result.addHTTPRequestInfo(request, request_content);
+  // Add request info to the result (the request content is recorded by the caller).
+  result.addHTTPRequestInfo(request);
+
+  // Contact the server (timing each phase).
+  bool connected = http_client_session_.connected();
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  std::ostream& request_stream = http_client_session_.sendRequest(request);
+  (connected ? result.timing.send : result.timing.connect) += elapsedMicroseconds(start);
+
+  start = std::chrono::steady_clock::now();
+  request_stream << request_content;
+  result.timing.send += elapsedMicroseconds(start);
 
-  // Contact the server.
+  start = std::chrono::steady_clock::now();
+  std::istream& response_stream = http_client_session_.receiveResponse(response);
+  result.timing.server += elapsedMicroseconds(start);
+
+  start = std::chrono::steady_clock::now();
   std::string response_content;
-  http_client_session_.sendRequest(request) << request_content;
-  StreamCopier::copyToString(http_client_session_.receiveResponse(response), response_content);
+  StreamCopier::copyToString(response_stream, response_content);
+  result.timing.receive += elapsedMicroseconds(start);
+  ++result.timing.exchanges;
+  count(EXCHANGES);
+  if (!connected)
+  {
+    count(RECONNECTS);
+  }
 
   // Add response info to the result.
-  result.addHTTPResponseInfo(response, response_content);
+  result.addHTTPResponseInfo(response, std::move(response_content));
 }
 
 void POCOClient::authenticate(POCOResult& result,
                               HTTPRequest& request,
                               HTTPResponse& response,
-                              const std::string request_content)
+                              const std::string& request_content)
 {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
   // Remove any old cookies.
   cookies_.clear();
 
+  count(AUTHENTICATIONS);
+
   // Authenticate with the provided credentials.
   http_credentials_.authenticate(request, response);
 
@@ -515,9 +617,11 @@ void POCOClient::authenticate(POCOResult& result,
   {
     extractAndStoreCookie(temp_cookies[i].toString());
   }
+
+  result.timing.authentication += elapsedMicroseconds(start);
 }
 
-void POCOClient::extractAndStoreCookie(const std::string cookie_string)
+void POCOClient::extractAndStoreCookie(const std::string& cookie_string)
 {
   // Find the positions of the cookie delimiters.
   size_t position_1 = cookie_string.find_first_of("=");
@@ -533,9 +637,9 @@ void POCOClient::extractAndStoreCookie(const std::string cookie_string)
   }
 }
 
-std::string POCOClient::findSubstringContent(const std::string whole_string,
-                                             const std::string substring_start,
-                                             const std::string substring_end)
+std::string POCOClient::findSubstringContent(std::string_view whole_string,
+                                             std::string_view substring_start,
+                                             std::string_view substring_end)
 {
   std::string result;
   size_t start_postion = whole_string.find(substring_start);
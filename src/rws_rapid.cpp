@@ -43,17 +43,782 @@
  ***********************************************************************************************************************
  */
 
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
 #include <string>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RWS_RAPID_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define RWS_RAPID_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Poco/Types.h"
+
 #include "abb_librws/rws_common.h"
 #include "abb_librws/rws_rapid.h"
+#include "abb_librws/rws_rapid_schema.h"
+
+namespace abb
+{
+namespace rws
+{
+typedef SystemConstants::RAPID RAPID;
+
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief Parses the next value as a number (e.g. "-1.5" or "9E+09").
+ *
+ * \param parser for the parser, positioned at the value.
+ * \param value for storing the parsed number (left unchanged if the parsing fails).
+ */
+template <typename T>
+static void parseNumber(RAPIDParser& parser, T& value)
+{
+  std::string_view token = parser.nextValue();
+
+  if (!parser.hasFailed())
+  {
+    T result = 0;
+    std::from_chars_result status = std::from_chars(token.data(), token.data() + token.size(), result);
+
+    if (status.ec == std::errc() && status.ptr == token.data() + token.size())
+    {
+      value = result;
+    }
+    else
+    {
+      parser.fail("expected a number", token);
+    }
+  }
+}
+
+/**
+ * \brief Appends a number's shortest string representation, which parses back to the exact same value.
+ *
+ * \param output for the string to append to.
+ * \param value for the number to append.
+ */
+template <typename T>
+static void appendNumber(std::string& output, const T value)
+{
+  // 9E9 is RAPID's sentinel for e.g. unused external axes (compared in the number's own precision).
+  if (value == static_cast<T>(9E9))
+  {
+    output += "9E+09";
+    return;
+  }
+
+  char buffer[32];
+  std::to_chars_result status = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+  for (char* p = buffer; p != status.ptr; ++p)
+  {
+    if (*p == 'e')
+    {
+      *p = 'E';
+    }
+  }
+
+  output.append(buffer, status.ptr - buffer);
+}
+
+void parseRAPIDValue(RAPIDParser& parser, float& value)
+{
+  parseNumber(parser, value);
+}
+
+void parseRAPIDValue(RAPIDParser& parser, double& value)
+{
+  parseNumber(parser, value);
+}
+
+void parseRAPIDValue(RAPIDParser& parser, bool& value)
+{
+  std::string_view token = parser.nextValue();
+
+  if (!parser.hasFailed())
+  {
+    if (token == RAPID::RAPID_TRUE)
+    {
+      value = true;
+    }
+    else if (token == RAPID::RAPID_FALSE)
+    {
+      value = false;
+    }
+    else
+    {
+      parser.fail("expected TRUE or FALSE", token);
+    }
+  }
+}
+
+void parseRAPIDValue(RAPIDParser& parser, std::string& value)
+{
+  std::string_view token = parser.nextValue();
+
+  if (!parser.hasFailed())
+  {
+    if (token.size() >= 2 && token.front() == '"' && token.back() == '"')
+    {
+      token = token.substr(1, token.size() - 2);
+    }
+
+    value.assign(token.data(), token.size());
+  }
+}
+
+void appendRAPIDValue(std::string& output, const float value)
+{
+  appendNumber(output, value);
+}
+
+void appendRAPIDValue(std::string& output, const double value)
+{
+  appendNumber(output, value);
+}
+
+void appendRAPIDValue(std::string& output, const bool value)
+{
+  output += (value ? RAPID::RAPID_TRUE : RAPID::RAPID_FALSE);
+}
+
+void appendRAPIDValue(std::string& output, const std::string& value)
+{
+  output += '"';
+  output += value;
+  output += '"';
+}
+
+/**
+ * \brief Splits a bracketed value string (i.e. a record or an array) into its top level components.
+ *
+ * \param value containing the value string.
+ * \param p_components for storing the components (viewing the value string).
+ *
+ * \return bool indicating if the value string is bracketed, and was split.
+ */
+static bool splitComponents(std::string_view value, std::vector<std::string_view>* p_components)
+{
+  RAPIDParser parser(value);
+
+  if (!parser.accept('['))
+  {
+    return false;
+  }
+
+  if (!parser.accept(']'))
+  {
+    do
+    {
+      p_components->push_back(parser.nextValue());
+    }
+    while (!parser.hasFailed() && parser.accept(','));
+
+    parser.expect(']');
+  }
+
+  return parser.finish();
+}
+
+/**
+ * \brief Finds the changed components of a value string, compared to an old value string (of the same symbol).
+ *
+ * \param old_value containing the old value string.
+ * \param new_value containing the new value string.
+ * \param path for the components' path (used while descending into the components).
+ * \param p_changes for storing the changes.
+ */
+static void findComponentChanges(std::string_view old_value,
+                                 std::string_view new_value,
+                                 std::vector<size_t>& path,
+                                 std::vector<RAPIDSnapshot::Change>* p_changes)
+{
+  if (old_value == new_value)
+  {
+    return;
+  }
+
+  std::vector<std::string_view> old_components;
+  std::vector<std::string_view> new_components;
+
+  if (splitComponents(old_value, &old_components) &&
+      splitComponents(new_value, &new_components) &&
+      old_components.size() == new_components.size())
+  {
+    size_t changed = 0;
+
+    for (size_t i = 0; i < new_components.size(); ++i)
+    {
+      changed += (old_components[i] != new_components[i] ? 1 : 0);
+    }
+
+    // One write of the complete value is cheaper than one write per component, if all components have changed.
+    if (changed < new_components.size() || new_components.size() == 1)
+    {
+      for (size_t i = 0; i < new_components.size(); ++i)
+      {
+        path.push_back(i);
+        findComponentChanges(old_components[i], new_components[i], path, p_changes);
+        path.pop_back();
+      }
+
+      return;
+    }
+  }
+
+  RAPIDSnapshot::Change change;
+  change.path = path;
+  change.value.assign(new_value.data(), new_value.size());
+  p_changes->push_back(change);
+}
+
+/**
+ * \brief Type of the functions that locate the delimiters (',' and ']') of a numeric list in a block of 32 characters.
+ *
+ * The returned mask has bit i set if character i is a delimiter.
+ */
+typedef Poco::UInt32 (*DelimiterMaskFunction)(const char* p_block);
+
+/**
+ * \brief Locates the delimiters in up to 32 characters, one character at a time.
+ *
+ * \param p_block for the characters.
+ * \param size for the number of characters (at most 32).
+ *
+ * \return Poco::UInt32 containing the delimiter mask.
+ */
+static Poco::UInt32 findDelimitersScalar(const char* p_block, const size_t size)
+{
+  Poco::UInt32 mask = 0;
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    if (p_block[i] == ',' || p_block[i] == ']')
+    {
+      mask |= (Poco::UInt32(1) << i);
+    }
+  }
+
+  return mask;
+}
+
+/**
+ * \brief Locates the delimiters in a block of 32 characters, one character at a time.
+ *
+ * \param p_block for the characters.
+ *
+ * \return Poco::UInt32 containing the delimiter mask.
+ */
+static Poco::UInt32 findDelimitersScalar(const char* p_block)
+{
+  return findDelimitersScalar(p_block, 32);
+}
+
+#ifdef RWS_RAPID_SSE2
+/**
+ * \brief Locates the delimiters in a block of 32 characters, with SSE2 instructions (16 characters at a time).
+ *
+ * \param p_block for the characters.
+ *
+ * \return Poco::UInt32 containing the delimiter mask.
+ */
+static Poco::UInt32 findDelimitersSSE2(const char* p_block)
+{
+  const __m128i comma = _mm_set1_epi8(',');
+  const __m128i bracket = _mm_set1_epi8(']');
+  __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_block));
+  __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_block + 16));
+
+  Poco::UInt32 low_mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(low, comma), _mm_cmpeq_epi8(low, bracket)));
+  Poco::UInt32 high_mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(high, comma), _mm_cmpeq_epi8(high, bracket)));
+
+  return low_mask | (high_mask << 16);
+}
+#endif
+
+#ifdef RWS_RAPID_AVX2
+/**
+ * \brief Locates the delimiters in a block of 32 characters, with AVX2 instructions.
+ *
+ * \param p_block for the characters.
+ *
+ * \return Poco::UInt32 containing the delimiter mask.
+ */
+__attribute__((target("avx2")))
+static Poco::UInt32 findDelimitersAVX2(const char* p_block)
+{
+  const __m256i comma = _mm256_set1_epi8(',');
+  const __m256i bracket = _mm256_set1_epi8(']');
+  __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_block));
+
+  return _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, comma), _mm256_cmpeq_epi8(block, bracket)));
+}
+#endif
+
+/**
+ * \brief Looks up the delimiter function of a kernel.
+ *
+ * \param kernel for the kernel. AUTOMATIC selects the fastest kernel supported by the build and the CPU.
+ *
+ * \return DelimiterMaskFunction containing the function (null if the kernel isn't supported).
+ */
+static DelimiterMaskFunction findDelimiterMaskFunction(const RAPIDParser::DelimiterKernel kernel)
+{
+  switch (kernel)
+  {
+    case RAPIDParser::SCALAR:
+      return static_cast<DelimiterMaskFunction>(&findDelimitersScalar);
+
+    case RAPIDParser::SSE2:
+#ifdef RWS_RAPID_SSE2
+      return &findDelimitersSSE2;
+#else
+      return 0;
+#endif
+
+    case RAPIDParser::AVX2:
+#ifdef RWS_RAPID_AVX2
+      return (__builtin_cpu_supports("avx2") ? &findDelimitersAVX2 : 0);
+#else
+      return 0;
+#endif
+
+    default:
+    {
+      DelimiterMaskFunction function = findDelimiterMaskFunction(RAPIDParser::AVX2);
+      function = (function ? function : findDelimiterMaskFunction(RAPIDParser::SSE2));
+      return (function ? function : findDelimiterMaskFunction(RAPIDParser::SCALAR));
+    }
+  }
+}
+
+/**
+ * \brief The delimiter function selected with RAPIDParser::setDelimiterKernel(...) (null until then).
+ */
+static std::atomic<DelimiterMaskFunction> selected_delimiter_mask_function(0);
+
+/**
+ * \brief Retrieves the selected delimiter function, or else the fastest one supported by the build and the CPU.
+ *
+ * \return DelimiterMaskFunction containing the function.
+ */
+static DelimiterMaskFunction getDelimiterMaskFunction()
+{
+  static const DelimiterMaskFunction automatic_function = findDelimiterMaskFunction(RAPIDParser::AUTOMATIC);
+
+  DelimiterMaskFunction function = selected_delimiter_mask_function.load(std::memory_order_relaxed);
+
+  return (function ? function : automatic_function);
+}
+
+/**
+ * \brief Finds the index of the lowest set bit.
+ *
+ * \param mask for the bits (at least one set).
+ *
+ * \return unsigned int containing the index.
+ */
+static unsigned int findLowestBit(const Poco::UInt32 mask)
+{
+#ifdef _MSC_VER
+  unsigned long index = 0;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * \brief Parses one number of a numeric list (surrounding whitespace allowed) and appends it to the output.
+ *
+ * \param p_first for the number's first character.
+ * \param p_last for the position after the number's last character.
+ * \param output for the numbers.
+ *
+ * \return bool indicating if the number was parsed.
+ */
+template <typename T>
+static bool parseListNumber(const char* p_first, const char* p_last, std::vector<T>& output)
+{
+  while (p_first < p_last && std::isspace(static_cast<unsigned char>(*p_first)))
+  {
+    ++p_first;
+  }
+
+  while (p_first < p_last && std::isspace(static_cast<unsigned char>(*(p_last - 1))))
+  {
+    --p_last;
+  }
+
+  T value = 0;
+  std::from_chars_result status = std::from_chars(p_first, p_last, value);
+
+  if (p_first == p_last || status.ec != std::errc() || status.ptr != p_last)
+  {
+    return false;
+  }
+
+  output.push_back(value);
+
+  return true;
+}
+
+/**
+ * \brief Parses a flat bracketed numeric list (e.g. "[1,2.5,-3E+02]").
+ *
+ * \param input for the value string.
+ * \param position for the position of the list's '[' (moved after the ']' if the list was parsed).
+ * \param output for the numbers (cleared if the list couldn't be parsed).
+ *
+ * \return bool indicating if the list was parsed.
+ */
+template <typename T>
+static bool parseNumberList(std::string_view input, size_t& position, std::vector<T>& output)
+{
+  output.clear();
+
+  if (position >= input.size() || input[position] != '[')
+  {
+    return false;
+  }
+
+  const DelimiterMaskFunction find_delimiters = getDelimiterMaskFunction();
+  const char* p_end = input.data() + input.size();
+  const char* p_block = input.data() + position + 1;
+  const char* p_number = p_block;
+
+  // An empty list has no number before its ']'.
+  while (p_number < p_end && std::isspace(static_cast<unsigned char>(*p_number)))
+  {
+    ++p_number;
+  }
+
+  if (p_number < p_end && *p_number == ']')
+  {
+    position = p_number + 1 - input.data();
+    return true;
+  }
+
+  while (p_block < p_end)
+  {
+    size_t block_size = std::min<size_t>(32, p_end - p_block);
+    Poco::UInt32 mask = (block_size == 32 ? find_delimiters(p_block) : findDelimitersScalar(p_block, block_size));
+
+    while (mask != 0)
+    {
+      const char* p_delimiter = p_block + findLowestBit(mask);
+      mask &= mask - 1;
+
+      if (!parseListNumber(p_number, p_delimiter, output))
+      {
+        output.clear();
+        return false;
+      }
+
+      p_number = p_delimiter + 1;
+
+      if (*p_delimiter == ']')
+      {
+        position = p_number - input.data();
+        return true;
+      }
+    }
+
+    p_block += block_size;
+  }
+
+  output.clear();
+
+  return false;
+}
+
+
+
+
+/***********************************************************************************************************************
+ * Class definitions: RAPIDParser
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+bool RAPIDParser::parse(RAPIDSymbolDataAbstract& data)
+{
+  data.parse(*this);
+
+  return finish();
+}
+
+bool RAPIDParser::finish()
+{
+  if (!hasFailed() && !atEnd())
+  {
+    fail("unexpected characters after the value");
+  }
+
+  return !hasFailed();
+}
+
+bool RAPIDParser::accept(const char character)
+{
+  skipWhitespace();
+
+  if (!hasFailed() && position_ < input_.size() && input_[position_] == character)
+  {
+    ++position_;
+    return true;
+  }
+
+  return false;
+}
+
+bool RAPIDParser::expect(const char character)
+{
+  if (accept(character))
+  {
+    return true;
+  }
+
+  switch (character)
+  {
+    case '[':
+      fail("expected '['");
+    break;
+
+    case ']':
+      fail("expected ']' (too many components?)");
+    break;
+
+    case ',':
+      fail("expected ',' (too few components?)");
+    break;
+
+    default:
+      fail("unexpected character");
+    break;
+  }
+
+  return false;
+}
+
+bool RAPIDParser::parseNumbers(std::vector<float>& output)
+{
+  skipWhitespace();
+
+  return !hasFailed() && parseNumberList(input_, position_, output);
+}
+
+bool RAPIDParser::parseNumbers(std::vector<double>& output)
+{
+  skipWhitespace();
+
+  return !hasFailed() && parseNumberList(input_, position_, output);
+}
+
+bool RAPIDParser::setDelimiterKernel(const DelimiterKernel kernel)
+{
+  DelimiterMaskFunction function = findDelimiterMaskFunction(kernel);
+
+  if (function)
+  {
+    selected_delimiter_mask_function.store(function, std::memory_order_relaxed);
+  }
+
+  return function != 0;
+}
+
+bool RAPIDParser::atEnd()
+{
+  skipWhitespace();
+
+  return position_ >= input_.size();
+}
+
+std::string_view RAPIDParser::nextValue()
+{
+  skipWhitespace();
+
+  if (hasFailed())
+  {
+    return std::string_view();
+  }
+
+  const size_t start = position_;
+  size_t end = position_;
+
+  if (position_ < input_.size() && input_[position_] == '"')
+  {
+    // A string, where any quotation mark inside it is doubled.
+    ++position_;
+
+    while (position_ < input_.size())
+    {
+      if (input_[position_] == '"')
+      {
+        if (position_ + 1 < input_.size() && input_[position_ + 1] == '"')
+        {
+          ++position_;
+        }
+        else
+        {
+          break;
+        }
+      }
+
+      ++position_;
+    }
+
+    if (position_ >= input_.size())
+    {
+      fail("unterminated string", input_.substr(start));
+      return std::string_view();
+    }
+
+    end = ++position_;
+  }
+  else if (position_ < input_.size() && input_[position_] == '[')
+  {
+    // A record or an array, which ends at the matching bracket (brackets inside strings are ignored).
+    int depth = 0;
+    bool in_string = false;
+
+    for (; position_ < input_.size() && end == start; ++position_)
+    {
+      const char character = input_[position_];
+
+      if (character == '"')
+      {
+        in_string = !in_string;
+      }
+      else if (!in_string && character == '[')
+      {
+        ++depth;
+      }
+      else if (!in_string && character == ']' && --depth == 0)
+      {
+        end = position_ + 1;
+      }
+    }
+
+    if (end == start)
+    {
+      fail("unbalanced brackets", input_.substr(start));
+      return std::string_view();
+    }
+  }
+  else
+  {
+    // An atom (e.g. a number, TRUE/FALSE or an enumeration), which ends before the next delimiter.
+    while (position_ < input_.size() && input_[position_] != ',' && input_[position_] != ']')
+    {
+      ++position_;
+    }
+
+    end = position_;
+
+    while (end > start && std::isspace(static_cast<unsigned char>(input_[end - 1])))
+    {
+      --end;
+    }
+
+    if (end == start)
+    {
+      fail("expected a value");
+      return std::string_view();
+    }
+  }
+
+  return input_.substr(start, end - start);
+}
+
+void RAPIDParser::fail(const char* p_message)
+{
+  if (!hasFailed())
+  {
+    p_error_message_ = p_message;
+    error_position_ = position_;
+  }
+}
+
+void RAPIDParser::fail(const char* p_message, std::string_view value)
+{
+  if (!hasFailed())
+  {
+    p_error_message_ = p_message;
+    error_position_ = value.data() - input_.data();
+  }
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+void RAPIDParser::skipWhitespace()
+{
+  while (position_ < input_.size() && std::isspace(static_cast<unsigned char>(input_[position_])))
+  {
+    ++position_;
+  }
+}
 
-namespace abb
+
+
+
+/***********************************************************************************************************************
+ * Struct definitions: RAPIDSymbolDataAbstract
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+void RAPIDSymbolDataAbstract::appendString(std::string& output) const
 {
-namespace rws
+  output += constructString();
+}
+
+void RAPIDSymbolDataAbstract::parse(RAPIDParser& parser)
 {
-typedef SystemConstants::RAPID RAPID;
+  std::string_view value = parser.nextValue();
+
+  if (!parser.hasFailed())
+  {
+    parseString(std::string(value));
+  }
+}
+
+bool RAPIDSymbolDataAbstract::tryParse(RAPIDParser& parser)
+{
+  std::string previous_value = constructString();
+
+  if (parser.parse(*this))
+  {
+    return true;
+  }
+
+  RAPIDParser restorer(previous_value);
+  restorer.parse(*this);
+  return false;
+}
+
+
+
 
 /***********************************************************************************************************************
  * Struct definitions: RAPIDAtomic<RAPIDAtomicTypes>
@@ -85,64 +850,70 @@ std::string RAPIDAtomic<RAPID_STRING>::getType() const
 
 std::string RAPIDAtomic<RAPID_BOOL>::constructString() const
 {
-  return (value ? RAPID::RAPID_TRUE : RAPID::RAPID_FALSE);
+  std::string result;
+  appendString(result);
+  return result;
 }
 
 std::string RAPIDAtomic<RAPID_NUM>::constructString() const
 {
-  std::string result("9000000000");
+  std::string result;
+  appendString(result);
+  return result;
+}
 
-  if (value != (float) 9E9)
-  {
-    std::stringstream ss;
-    ss << value;
-    result = ss.str();
-  }
+std::string RAPIDAtomic<RAPID_DNUM>::constructString() const
+{
+  std::string result;
+  appendString(result);
+  return result;
+}
 
+std::string RAPIDAtomic<RAPID_STRING>::constructString() const
+{
+  std::string result;
+  appendString(result);
   return result;
 }
 
-std::string RAPIDAtomic<RAPID_DNUM>::constructString() const
+void RAPIDAtomic<RAPID_BOOL>::appendString(std::string& output) const
 {
-  std::string result("9000000000");
+  appendRAPIDValue(output, value);
+}
 
-  if (value != (float) 9E9)
-  {
-    std::stringstream ss;
-    ss << value;
-    result = ss.str();
-  }
+void RAPIDAtomic<RAPID_NUM>::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, value);
+}
 
-  return result;
+void RAPIDAtomic<RAPID_DNUM>::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, value);
 }
 
-std::string RAPIDAtomic<RAPID_STRING>::constructString() const
+void RAPIDAtomic<RAPID_STRING>::appendString(std::string& output) const
 {
-  return "\"" + value + "\"";
+  appendRAPIDValue(output, value);
 }
 
-void RAPIDAtomic<RAPID_BOOL>::parseString(const std::string& value_string)
+void RAPIDAtomic<RAPID_BOOL>::parse(RAPIDParser& parser)
 {
-  value = value_string.compare(RAPID::RAPID_TRUE) == 0 ? true : false;
+  parseRAPIDValue(parser, value);
 }
 
-void RAPIDAtomic<RAPID_STRING>::parseString(const std::string& value_string)
+void RAPIDAtomic<RAPID_NUM>::parse(RAPIDParser& parser)
 {
-  std::string temp = value_string;
+  parseRAPIDValue(parser, value);
+}
 
-  size_t position = temp.find_first_of("\"");
-  if (position == 0)
-  {
-    temp.erase(position, 1);
-  }
-  position = temp.find_last_of("\"");
-  if (position == temp.size() - 1)
-  {
-    temp.erase(position, 1);
-  }
+void RAPIDAtomic<RAPID_DNUM>::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, value);
+}
 
-  std::stringstream ss(temp);
-  ss >> value;
+void RAPIDAtomic<RAPID_STRING>::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, value);
 }
 
 
@@ -168,36 +939,51 @@ std::string RAPIDRecord::getType() const
 
 void RAPIDRecord::parseString(const std::string& value_string)
 {
-  std::vector<std::string> substrings = extractDelimitedSubstrings(value_string);
+  RAPIDParser parser(value_string);
+  parser.parse(*this);
+}
 
-  if (components_.size() == substrings.size())
+void RAPIDRecord::parse(RAPIDParser& parser)
+{
+  if (parser.expect('['))
   {
-    for (size_t i = 0; i < components_.size(); ++i)
+    for (size_t i = 0; i < components_.size() && !parser.hasFailed(); ++i)
+    {
+      if (i == 0 || parser.expect(','))
+      {
+        components_[i]->parse(parser);
+      }
+    }
+
+    if (!parser.hasFailed())
     {
-      components_.at(i)->parseString(substrings.at(i));
+      parser.expect(']');
     }
   }
 }
 
 std::string RAPIDRecord::constructString() const
 {
-  std::stringstream ss;
+  std::string result;
+  appendString(result);
+  return result;
+}
 
-  ss << "[";
+void RAPIDRecord::appendString(std::string& output) const
+{
+  output += '[';
 
   for (size_t i = 0; i < components_.size(); ++i)
   {
-    ss << components_.at(i)->constructString();
-
-    if (i != components_.size() - 1)
+    if (i != 0)
     {
-      ss << ",";
+      output += ',';
     }
-  }
 
-  ss << "]";
+    components_[i]->appendString(output);
+  }
 
-  return ss.str();
+  output += ']';
 }
 
 RAPIDRecord& RAPIDRecord::operator=(const RAPIDRecord& other)
@@ -223,80 +1009,327 @@ RAPIDRecord& RAPIDRecord::operator=(const RAPIDRecord& other)
  * Auxiliary methods
  */
 
-unsigned int RAPIDRecord::countCharInString(std::string input, const char character)
+unsigned int RAPIDRecord::countCharInString(const std::string& input, const char character)
 {
-  bool done = false;
   unsigned int count = 0;
-  size_t position = 0;
 
-  do
+  for (size_t i = 0; i < input.size(); ++i)
   {
-    position = input.find_first_of(character);
-
-    if (position != std::string::npos)
+    if (input[i] == character)
     {
       ++count;
-      input.erase(position, 1);
     }
-    else
-    {
-      done = true;
-    }
-  } while (!done);
+  }
 
   return count;
 }
 
-std::vector<std::string> RAPIDRecord::extractDelimitedSubstrings(const std::string input)
+std::vector<std::string> RAPIDRecord::extractDelimitedSubstrings(const std::string& input)
 {
-  // Prepare the input by removing any starting and ending '[' respective ']'
-  std::string temp_0(input);
-  size_t position_1 = 0;
-  size_t position_2 = 0;
+  // Only consider the content between any starting and ending '[' respective ']'.
+  std::string_view content(input);
+  size_t position_1 = content.find_first_of('[');
+  size_t position_2 = content.find_last_of(']');
 
-  position_1 = temp_0.find_first_of('[');
-  position_2 = temp_0.find_last_of(']');
-
-  if (position_1 != std::string::npos && position_2 != std::string::npos)
+  if (position_1 != std::string::npos && position_2 != std::string::npos && position_1 < position_2)
   {
-    temp_0.erase(position_1, 1);
-    temp_0.erase(position_2 - 1, 1);
+    content = content.substr(position_1 + 1, position_2 - position_1 - 1);
   }
 
-  // Extract and merge the delimited substrings in the prepared input string.
-  std::stringstream ss(temp_0);
+  // Extract the (top level) comma delimited values in the content.
+  RAPIDParser parser(content);
   std::vector<std::string> values;
-  std::string temp_1;
-  std::string temp_2;
-  int counter = 0;
 
-  while (std::getline(ss, temp_1, ','))
+  while (!parser.atEnd())
   {
-    if (!temp_1.empty())
+    std::string_view value = parser.nextValue();
+
+    if (parser.hasFailed())
+    {
+      break;
+    }
+
+    values.push_back(std::string(value));
+
+    if (!parser.accept(','))
     {
-      counter += countCharInString(temp_1, '[');
-      counter -= countCharInString(temp_1, ']');
+      break;
+    }
+  }
+
+  return values;
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RobJoint
+ */
+
+void RobJoint::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void RobJoint::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: ExtJoint
+ */
+
+void ExtJoint::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void ExtJoint::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: JointTarget
+ */
+
+void JointTarget::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void JointTarget::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: Pos
+ */
+
+void Pos::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void Pos::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: Orient
+ */
+
+void Orient::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void Orient::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: Pose
+ */
+
+void Pose::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void Pose::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: ConfData
+ */
+
+void ConfData::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void ConfData::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RobTarget
+ */
+
+void RobTarget::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void RobTarget::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: LoadData
+ */
+
+void LoadData::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void LoadData::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: ToolData
+ */
+
+void ToolData::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void ToolData::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: WObjData
+ */
+
+void WObjData::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
+
+void WObjData::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: SpeedData
+ */
+
+void SpeedData::parse(RAPIDParser& parser)
+{
+  parseRAPIDValue(parser, *this);
+}
 
-      if (counter == 0)
+void SpeedData::appendString(std::string& output) const
+{
+  appendRAPIDValue(output, *this);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RAPIDArrayAbstract
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+void RAPIDArrayAbstract::markModified(const size_t first, const size_t count)
+{
+  for (size_t i = first; i < first + count && i < modified_.size(); ++i)
+  {
+    modified_[i] = true;
+  }
+}
+
+void RAPIDArrayAbstract::markUnmodified()
+{
+  modified_.assign(modified_.size(), false);
+}
+
+void RAPIDArrayAbstract::markUnmodified(const size_t first, const size_t count)
+{
+  for (size_t i = first; i < first + count && i < modified_.size(); ++i)
+  {
+    modified_[i] = false;
+  }
+}
+
+bool RAPIDArrayAbstract::isModified(const size_t index) const
+{
+  return index < modified_.size() && modified_[index];
+}
+
+size_t RAPIDArrayAbstract::getModifiedCount() const
+{
+  return std::count(modified_.begin(), modified_.end(), true);
+}
+
+std::vector<std::pair<size_t, size_t>> RAPIDArrayAbstract::getModifiedRanges() const
+{
+  std::vector<std::pair<size_t, size_t>> ranges;
+
+  for (size_t i = 0; i < modified_.size(); ++i)
+  {
+    if (modified_[i])
+    {
+      if (!ranges.empty() && ranges.back().first + ranges.back().second == i)
       {
-        if (!temp_2.empty())
-        {
-          values.push_back(temp_2 + temp_1);
-          temp_2 = "";
-        }
-        else
-        {
-          values.push_back(temp_1);
-        }
+        ++ranges.back().second;
       }
       else
       {
-        temp_2 += temp_1 + ",";
+        ranges.push_back(std::make_pair(i, 1));
       }
     }
   }
 
-  return values;
+  return ranges;
+}
+
+bool RAPIDArrayAbstract::isLoaded(const size_t index) const
+{
+  return index < loaded_.size() && loaded_[index];
+}
+
+size_t RAPIDArrayAbstract::getUnloadedCount() const
+{
+  return std::count(loaded_.begin(), loaded_.end(), false);
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RAPIDSnapshot
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+void RAPIDSnapshot::take(const RAPIDSymbolDataAbstract& data)
+{
+  value_.clear();
+  data.appendString(value_);
+}
+
+bool RAPIDSnapshot::findChanges(const std::string& value, std::vector<Change>* p_changes) const
+{
+  p_changes->clear();
+
+  if (value_.empty())
+  {
+    Change change;
+    change.value = value;
+    p_changes->push_back(change);
+  }
+  else
+  {
+    std::vector<size_t> path;
+    findComponentChanges(value_, value, path, p_changes);
+  }
+
+  return !p_changes->empty();
 }
 
 } // end namespace rws
@@ -0,0 +1,551 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A dynamically typed RAPID value, for symbols whose type is only known at runtime.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include "abb_librws/rws_rapid_value.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Struct definitions: RAPIDTypeDescriptor
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+void RAPIDTypeDescriptor::addComponent(const std::string& component_name,
+                                       const std::shared_ptr<const RAPIDTypeDescriptor>& p_component_type)
+{
+  Component component;
+  component.name = component_name;
+  component.p_type = p_component_type;
+
+  component_indices[component_name] = static_cast<int>(components.size());
+  components.push_back(component);
+}
+
+int RAPIDTypeDescriptor::findComponent(std::string_view component_name) const
+{
+  std::map<std::string, int, std::less<>>::const_iterator it = component_indices.find(component_name);
+
+  return (it != component_indices.end() ? it->second : -1);
+}
+
+std::shared_ptr<const RAPIDTypeDescriptor> RAPIDTypeDescriptor::getBuiltIn(std::string_view type_name)
+{
+  static const std::shared_ptr<const RAPIDTypeDescriptor> NUM(new RAPIDTypeDescriptor("num", KIND_NUM));
+  static const std::shared_ptr<const RAPIDTypeDescriptor> DNUM(new RAPIDTypeDescriptor("dnum", KIND_DNUM));
+  static const std::shared_ptr<const RAPIDTypeDescriptor> BOOL(new RAPIDTypeDescriptor("bool", KIND_BOOL));
+  static const std::shared_ptr<const RAPIDTypeDescriptor> STRING(new RAPIDTypeDescriptor("string", KIND_STRING));
+
+  if (type_name == NUM->name)
+  {
+    return NUM;
+  }
+  else if (type_name == DNUM->name)
+  {
+    return DNUM;
+  }
+  else if (type_name == BOOL->name)
+  {
+    return BOOL;
+  }
+  else if (type_name == STRING->name)
+  {
+    return STRING;
+  }
+
+  return std::shared_ptr<const RAPIDTypeDescriptor>();
+}
+
+
+
+
+/***********************************************************************************************************************
+ * Class definitions: RAPIDValue::ConstRef
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+RAPIDValue::ConstRef RAPIDValue::ConstRef::operator[](std::string_view component_name) const
+{
+  if (p_value_ && node().dimensions == 0 && node().p_type->kind == RAPIDTypeDescriptor::KIND_RECORD)
+  {
+    int index = node().p_type->findComponent(component_name);
+
+    if (index >= 0)
+    {
+      return ConstRef(p_value_, node().data.span.first + index);
+    }
+  }
+
+  return ConstRef(0, 0);
+}
+
+RAPIDValue::ConstRef RAPIDValue::ConstRef::operator[](const size_t index) const
+{
+  if (p_value_ && (node().dimensions > 0 || node().p_type->kind == RAPIDTypeDescriptor::KIND_RECORD) &&
+      index < node().data.span.count)
+  {
+    return ConstRef(p_value_, node().data.span.first + static_cast<Poco::UInt32>(index));
+  }
+
+  return ConstRef(0, 0);
+}
+
+bool RAPIDValue::ConstRef::isArray() const
+{
+  return p_value_ && node().dimensions > 0;
+}
+
+const RAPIDTypeDescriptor* RAPIDValue::ConstRef::getType() const
+{
+  return (p_value_ ? node().p_type : 0);
+}
+
+size_t RAPIDValue::ConstRef::size() const
+{
+  if (p_value_ && (node().dimensions > 0 || node().p_type->kind == RAPIDTypeDescriptor::KIND_RECORD))
+  {
+    return node().data.span.count;
+  }
+
+  return 0;
+}
+
+double RAPIDValue::ConstRef::asNumber() const
+{
+  if (p_value_ && node().dimensions == 0 && (node().p_type->kind == RAPIDTypeDescriptor::KIND_NUM ||
+                                             node().p_type->kind == RAPIDTypeDescriptor::KIND_DNUM))
+  {
+    return node().data.number;
+  }
+
+  return 0.0;
+}
+
+bool RAPIDValue::ConstRef::asBool() const
+{
+  return p_value_ && node().dimensions == 0 && node().p_type->kind == RAPIDTypeDescriptor::KIND_BOOL &&
+         node().data.flag;
+}
+
+std::string_view RAPIDValue::ConstRef::asString() const
+{
+  if (p_value_ && node().dimensions == 0 && (node().p_type->kind == RAPIDTypeDescriptor::KIND_STRING ||
+                                             node().p_type->kind == RAPIDTypeDescriptor::KIND_ATOMIC))
+  {
+    return std::string_view(p_value_->text_).substr(node().data.span.first, node().data.span.count);
+  }
+
+  return std::string_view();
+}
+
+std::string RAPIDValue::ConstRef::constructString() const
+{
+  std::string result;
+
+  if (p_value_)
+  {
+    p_value_->appendNode(result, index_);
+  }
+
+  return result;
+}
+
+
+
+
+/***********************************************************************************************************************
+ * Class definitions: RAPIDValue::Ref
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+bool RAPIDValue::Ref::setNumber(const double value) const
+{
+  if (p_value_ && node().dimensions == 0 && (node().p_type->kind == RAPIDTypeDescriptor::KIND_NUM ||
+                                             node().p_type->kind == RAPIDTypeDescriptor::KIND_DNUM))
+  {
+    mutableNode().data.number = value;
+    return true;
+  }
+
+  return false;
+}
+
+bool RAPIDValue::Ref::setBool(const bool value) const
+{
+  if (p_value_ && node().dimensions == 0 && node().p_type->kind == RAPIDTypeDescriptor::KIND_BOOL)
+  {
+    mutableNode().data.flag = value;
+    return true;
+  }
+
+  return false;
+}
+
+bool RAPIDValue::Ref::setString(std::string_view value) const
+{
+  if (p_value_ && node().dimensions == 0 && (node().p_type->kind == RAPIDTypeDescriptor::KIND_STRING ||
+                                             node().p_type->kind == RAPIDTypeDescriptor::KIND_ATOMIC))
+  {
+    // Overwrite the old text if the new text fits, and otherwise append it (compacting the buffer once most of it
+    // is unused). Either way, string views into the value are invalidated.
+    RAPIDValue* p_value = const_cast<RAPIDValue*>(p_value_);
+    Node::Span& span = mutableNode().data.span;
+
+    if (value.size() <= span.count)
+    {
+      p_value->text_.replace(span.first, value.size(), value.data(), value.size());
+      p_value->unused_text_ += span.count - value.size();
+      span.count = static_cast<Poco::UInt32>(value.size());
+    }
+    else
+    {
+      p_value->unused_text_ += span.count;
+      span = p_value->storeText(value);
+
+      if (p_value->unused_text_ > p_value->text_.size() / 2)
+      {
+        p_value->compactText();
+      }
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+
+
+
+/***********************************************************************************************************************
+ * Class definitions: RAPIDValue
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+RAPIDValue::RAPIDValue(const std::shared_ptr<const RAPIDTypeDescriptor>& p_type,
+                       const unsigned int number_of_dimensions)
+:
+p_type_(p_type),
+number_of_dimensions_(number_of_dimensions),
+unused_text_(0)
+{}
+
+void RAPIDValue::reset(const std::shared_ptr<const RAPIDTypeDescriptor>& p_type,
+                       const unsigned int number_of_dimensions)
+{
+  p_type_ = p_type;
+  number_of_dimensions_ = number_of_dimensions;
+  nodes_.clear();
+  text_.clear();
+  unused_text_ = 0;
+}
+
+std::string RAPIDValue::getType() const
+{
+  return (p_type_ ? p_type_->name : std::string());
+}
+
+void RAPIDValue::parseString(const std::string& value_string)
+{
+  RAPIDParser parser(value_string);
+  parser.parse(*this);
+}
+
+std::string RAPIDValue::constructString() const
+{
+  std::string result;
+  appendString(result);
+  return result;
+}
+
+void RAPIDValue::appendString(std::string& output) const
+{
+  if (!nodes_.empty())
+  {
+    appendNode(output, 0);
+  }
+}
+
+void RAPIDValue::parse(RAPIDParser& parser)
+{
+  nodes_.clear();
+  text_.clear();
+  unused_text_ = 0;
+
+  if (!p_type_)
+  {
+    parser.fail("the RAPID value has no type descriptor");
+    return;
+  }
+
+  allocateNodes(1);
+  parseNode(parser, 0, p_type_.get(), number_of_dimensions_);
+
+  if (parser.hasFailed())
+  {
+    nodes_.clear();
+    text_.clear();
+    unused_text_ = 0;
+  }
+}
+
+bool RAPIDValue::tryParse(RAPIDParser& parser)
+{
+  RAPIDValue temp(p_type_, number_of_dimensions_);
+
+  if (!parser.parse(temp))
+  {
+    return false;
+  }
+
+  *this = std::move(temp);
+  return true;
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+void RAPIDValue::parseNode(RAPIDParser& parser,
+                           const Poco::UInt32 index,
+                           const RAPIDTypeDescriptor* p_type,
+                           const unsigned int dimensions)
+{
+  // Note: The arena may grow while parsing the children, so the node is always accessed by its index.
+  nodes_[index].p_type = p_type;
+  nodes_[index].dimensions = dimensions;
+  nodes_[index].data.span.first = 0;
+  nodes_[index].data.span.count = 0;
+
+  if (dimensions > 0)
+  {
+    // Count the elements with a copy of the parser, so they can be allocated contiguously.
+    RAPIDParser probe(parser);
+    size_t count = 0;
+
+    if (probe.expect('['))
+    {
+      do
+      {
+        probe.nextValue();
+        ++count;
+      } while (!probe.hasFailed() && probe.accept(','));
+    }
+
+    if (parser.expect('['))
+    {
+      Poco::UInt32 first = allocateNodes(count);
+      nodes_[index].data.span.first = first;
+      nodes_[index].data.span.count = static_cast<Poco::UInt32>(count);
+
+      for (size_t i = 0; i < count && !parser.hasFailed(); ++i)
+      {
+        if (i == 0 || parser.expect(','))
+        {
+          parseNode(parser, first + static_cast<Poco::UInt32>(i), p_type, dimensions - 1);
+        }
+      }
+
+      parser.expect(']');
+    }
+
+    return;
+  }
+
+  switch (p_type->kind)
+  {
+    case RAPIDTypeDescriptor::KIND_NUM:
+    case RAPIDTypeDescriptor::KIND_DNUM:
+    {
+      double number = 0.0;
+      parseRAPIDValue(parser, number);
+      nodes_[index].data.number = number;
+    }
+    break;
+
+    case RAPIDTypeDescriptor::KIND_BOOL:
+    {
+      bool flag = false;
+      parseRAPIDValue(parser, flag);
+      nodes_[index].data.flag = flag;
+    }
+    break;
+
+    case RAPIDTypeDescriptor::KIND_STRING:
+    case RAPIDTypeDescriptor::KIND_ATOMIC:
+    {
+      std::string_view token = parser.nextValue();
+
+      if (p_type->kind == RAPIDTypeDescriptor::KIND_STRING &&
+          token.size() >= 2 && token.front() == '"' && token.back() == '"')
+      {
+        token = token.substr(1, token.size() - 2);
+      }
+
+      nodes_[index].data.span = storeText(token);
+    }
+    break;
+
+    case RAPIDTypeDescriptor::KIND_RECORD:
+    {
+      if (parser.expect('['))
+      {
+        Poco::UInt32 first = allocateNodes(p_type->components.size());
+        nodes_[index].data.span.first = first;
+        nodes_[index].data.span.count = static_cast<Poco::UInt32>(p_type->components.size());
+
+        for (size_t i = 0; i < p_type->components.size() && !parser.hasFailed(); ++i)
+        {
+          if (i == 0 || parser.expect(','))
+          {
+            parseNode(parser, first + static_cast<Poco::UInt32>(i), p_type->components[i].p_type.get(), 0);
+          }
+        }
+
+        parser.expect(']');
+      }
+    }
+    break;
+  }
+}
+
+void RAPIDValue::appendNode(std::string& output, const Poco::UInt32 index) const
+{
+  const Node& node = nodes_[index];
+
+  if (node.dimensions > 0 || node.p_type->kind == RAPIDTypeDescriptor::KIND_RECORD)
+  {
+    output += '[';
+
+    for (Poco::UInt32 i = 0; i < node.data.span.count; ++i)
+    {
+      if (i != 0)
+      {
+        output += ',';
+      }
+
+      appendNode(output, node.data.span.first + i);
+    }
+
+    output += ']';
+    return;
+  }
+
+  switch (node.p_type->kind)
+  {
+    case RAPIDTypeDescriptor::KIND_NUM:
+      appendRAPIDValue(output, static_cast<float>(node.data.number));
+    break;
+
+    case RAPIDTypeDescriptor::KIND_DNUM:
+      appendRAPIDValue(output, node.data.number);
+    break;
+
+    case RAPIDTypeDescriptor::KIND_BOOL:
+      appendRAPIDValue(output, node.data.flag);
+    break;
+
+    case RAPIDTypeDescriptor::KIND_STRING:
+      output += '"';
+      output.append(text_, node.data.span.first, node.data.span.count);
+      output += '"';
+    break;
+
+    default:
+      output.append(text_, node.data.span.first, node.data.span.count);
+    break;
+  }
+}
+
+Poco::UInt32 RAPIDValue::allocateNodes(const size_t count)
+{
+  Poco::UInt32 first = static_cast<Poco::UInt32>(nodes_.size());
+  nodes_.resize(nodes_.size() + count);
+  return first;
+}
+
+RAPIDValue::Node::Span RAPIDValue::storeText(std::string_view text)
+{
+  Node::Span span;
+  span.first = static_cast<Poco::UInt32>(text_.size());
+  span.count = static_cast<Poco::UInt32>(text.size());
+  text_.append(text.data(), text.size());
+  return span;
+}
+
+void RAPIDValue::compactText()
+{
+  std::string text;
+  text.reserve(text_.size() - unused_text_);
+
+  for (size_t i = 0; i < nodes_.size(); ++i)
+  {
+    Node& node = nodes_[i];
+
+    if (node.p_type && node.dimensions == 0 && (node.p_type->kind == RAPIDTypeDescriptor::KIND_STRING ||
+                                                node.p_type->kind == RAPIDTypeDescriptor::KIND_ATOMIC))
+    {
+      Poco::UInt32 first = static_cast<Poco::UInt32>(text.size());
+      text.append(text_, node.data.span.first, node.data.span.count);
+      node.data.span.first = first;
+    }
+  }
+
+  text_.swap(text);
+  unused_text_ = 0;
+}
+
+} // end namespace rws
+} // end namespace abb
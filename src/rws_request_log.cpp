@@ -0,0 +1,236 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: A fixed-size, preallocated log of RWS requests.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/Timestamp.h"
+
+#include "abb_librws/rws_request_log.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Class definitions: RWSRequestLog
+ */
+
+/************************************************************
+ * Primary methods
+ */
+
+RWSRequestLog::RWSRequestLog(const size_t capacity, const size_t capture_limit)
+:
+records_(capacity),
+captures_(capacity * capture_limit),
+capture_limit_(capture_limit),
+next_(0),
+size_(0)
+{}
+
+void RWSRequestLog::add(const EndpointDescriptor& endpoint, const POCOClient::POCOResult& poco_result)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (records_.empty())
+  {
+    return;
+  }
+
+  records_[next_] = makeRecord(endpoint,
+                               poco_result,
+                               (capture_limit_ > 0 ? &captures_[next_ * capture_limit_] : 0),
+                               capture_limit_);
+
+  next_ = (next_ + 1) % records_.size();
+  size_ = std::min(size_ + 1, records_.size());
+}
+
+void RWSRequestLog::setCaptureLimit(const size_t capture_limit)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  captures_.assign(records_.size() * capture_limit, 0);
+  capture_limit_ = capture_limit;
+  next_ = 0;
+  size_ = 0;
+}
+
+std::vector<RWSRequestLog::Record> RWSRequestLog::getRecords()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<Record> result;
+  result.reserve(size_);
+
+  for (size_t i = 0; i < size_; ++i)
+  {
+    result.push_back(records_[(next_ + records_.size() - 1 - i) % records_.size()]);
+  }
+
+  return result;
+}
+
+std::string RWSRequestLog::getText(const bool verbose)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::stringstream ss;
+
+  for (size_t i = 0; i < size_; ++i)
+  {
+    std::stringstream temp;
+    temp << i + 1 << ". ";
+    ss << temp.str()
+       << format((next_ + records_.size() - 1 - i) % records_.size(), verbose, temp.str().size())
+       << std::endl;
+  }
+
+  return ss.str();
+}
+
+std::string RWSRequestLog::getTextLatestEvent(const bool verbose)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return (size_ == 0 ? "" : format((next_ + records_.size() - 1) % records_.size(), verbose, 0));
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+RWSRequestLog::Record RWSRequestLog::makeRecord(const EndpointDescriptor& endpoint,
+                                                const POCOClient::POCOResult& poco_result,
+                                                char* p_capture,
+                                                const size_t capture_limit)
+{
+  const POCOClient::POCOResult::POCOInfo& info = poco_result.poco_info;
+  const std::string& content = (info.http.response.content.empty() ?
+                                info.websocket.frame_content : info.http.response.content);
+
+  Record record;
+  record.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+  record.duration = poco_result.duration;
+  record.request_bytes = info.http.request.content.size();
+  record.response_bytes = content.size();
+  record.captured_bytes = (p_capture ? std::min(content.size(), capture_limit) : 0);
+  record.websocket_flags = info.websocket.flags;
+  record.http_status = info.http.response.status;
+  record.endpoint_id = endpoint.id;
+  record.method = endpoint.method;
+  record.general_status = poco_result.status;
+
+  size_t uri_length = std::min(info.http.request.uri.size(), URI_SIZE - 1);
+  std::memcpy(record.uri, info.http.request.uri.data(), uri_length);
+  record.uri[uri_length] = '\0';
+
+  if (record.captured_bytes > 0)
+  {
+    std::memcpy(p_capture, content.data(), record.captured_bytes);
+  }
+
+  return record;
+}
+
+std::string RWSRequestLog::formatRecord(const Record& record,
+                                        const char* p_capture,
+                                        const bool verbose,
+                                        const size_t indent)
+{
+  POCOClient::POCOResult::GeneralStatus status = POCOClient::POCOResult::GeneralStatus(record.general_status);
+
+  std::stringstream ss;
+
+  std::string seperator = (indent == 0 ? " | " : "\n" + std::string(indent, ' '));
+
+  ss << "General status: " << POCOClient::POCOResult::mapGeneralStatus(status);
+
+  if (record.uri[0] != '\0')
+  {
+    ss << seperator << "HTTP Request: " << mapEndpointMethod(EndpointDescriptor::Method(record.method))
+       << " " << record.uri;
+
+    if (status == POCOClient::POCOResult::OK)
+    {
+      Poco::Net::HTTPResponse::HTTPStatus http_status = Poco::Net::HTTPResponse::HTTPStatus(record.http_status);
+      ss << seperator << "HTTP Response: " << record.http_status << " - "
+         << Poco::Net::HTTPResponse::getReasonForStatus(http_status);
+    }
+  }
+  else if (status == POCOClient::POCOResult::OK)
+  {
+    ss << seperator << "WebSocket frame: " << POCOClient::POCOResult::mapWebSocketOpcode(record.websocket_flags);
+  }
+
+  ss << seperator << "Endpoint: "
+     << (record.endpoint_id < EndpointDescriptor::NUMBER_OF_ENDPOINTS ?
+         getEndpointDescriptor(EndpointDescriptor::Id(record.endpoint_id)).name : "UNDEFINED")
+     << " at " << Poco::DateTimeFormatter::format(Poco::Timestamp(record.timestamp), "%Y-%m-%d %H:%M:%S.%F")
+     << " (" << record.duration << " us, " << record.request_bytes << " B sent, "
+     << record.response_bytes << " B received)";
+
+  if (verbose && status == POCOClient::POCOResult::OK)
+  {
+    ss << seperator << "HTTP Response Content: "
+       << std::string(p_capture ? p_capture : "", p_capture ? record.captured_bytes : 0)
+       << (record.captured_bytes < record.response_bytes ? " [...]" : "");
+  }
+
+  return ss.str();
+}
+
+std::string RWSRequestLog::format(const size_t index, const bool verbose, const size_t indent) const
+{
+  return formatRecord(records_[index],
+                      (capture_limit_ > 0 ? &captures_[index * capture_limit_] : 0),
+                      verbose,
+                      indent);
+}
+
+} // end namespace rws
+} // end namespace abb
@@ -44,6 +44,7 @@
  */
 
 #include "abb_librws/rws_state_machine_interface.h"
+#include "abb_librws/rws_tracer.h"
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -138,8 +139,9 @@ namespace abb
      * Primary methods
      */
 
-    EGMActions RWSStateMachineInterface::Services::EGM::getCurrentAction(const std::string task) const
+    EGMActions RWSStateMachineInterface::Services::EGM::getCurrentAction(const std::string& task) const
     {
+      RWSTracer::Span span("Services::EGM", "getCurrentAction");
       EGMActions result;
       RAPIDNum temp_current_action;
 
@@ -172,28 +174,37 @@ namespace abb
       return result;
     }
 
-    bool RWSStateMachineInterface::Services::EGM::getSettings(const std::string task, EGMSettings *p_settings) const
+    bool RWSStateMachineInterface::Services::EGM::getSettings(const std::string& task,
+                                                              EGMSettings *p_settings,
+                                                              RAPIDSnapshot* p_snapshot) const
     {
-      return p_rws_interface_->getRAPIDSymbolData(task, Symbols::EGM_SETTINGS, p_settings);
+      RWSTracer::Span span("Services::EGM", "getSettings");
+      return p_rws_interface_->getRAPIDSymbolData(task, Symbols::EGM_SETTINGS, p_settings, p_snapshot);
     }
 
-    bool RWSStateMachineInterface::Services::EGM::setSettings(const std::string task, EGMSettings settings) const
+    bool RWSStateMachineInterface::Services::EGM::setSettings(const std::string& task,
+                                                              EGMSettings settings,
+                                                              RAPIDSnapshot* p_snapshot) const
     {
-      return p_rws_interface_->setRAPIDSymbolData(task, Symbols::EGM_SETTINGS, settings);
+      RWSTracer::Span span("Services::EGM", "setSettings");
+      return p_rws_interface_->setRAPIDSymbolData(task, Symbols::EGM_SETTINGS, settings, p_snapshot);
     }
 
     bool RWSStateMachineInterface::Services::EGM::signalEGMStartJoint() const
     {
+      RWSTracer::Span span("Services::EGM", "signalEGMStartJoint");
       return p_rws_interface_->toggleIOSignal(IOSignals::EGM_START_JOINT);
     }
 
     bool RWSStateMachineInterface::Services::EGM::signalEGMStartPose() const
     {
+      RWSTracer::Span span("Services::EGM", "signalEGMStartPose");
       return p_rws_interface_->toggleIOSignal(IOSignals::EGM_START_POSE);
     }
 
     bool RWSStateMachineInterface::Services::EGM::signalEGMStop() const
     {
+      RWSTracer::Span span("Services::EGM", "signalEGMStop");
       return p_rws_interface_->toggleIOSignal(IOSignals::EGM_STOP);
     }
 
@@ -205,8 +216,9 @@ namespace abb
      * Primary methods
      */
 
-    States RWSStateMachineInterface::Services::Main::getCurrentState(const std::string task) const
+    States RWSStateMachineInterface::Services::Main::getCurrentState(const std::string& task) const
     {
+      RWSTracer::Span span("Services::Main", "getCurrentState");
       States result;
       RAPIDNum temp_current_state;
 
@@ -243,8 +255,9 @@ namespace abb
       return result;
     }
 
-    TriBool RWSStateMachineInterface::Services::Main::isStateIdle(const std::string task) const
+    TriBool RWSStateMachineInterface::Services::Main::isStateIdle(const std::string& task) const
     {
+      RWSTracer::Span span("Services::Main", "isStateIdle");
       TriBool result;
       States temp_current_state = getCurrentState(task);
 
@@ -256,8 +269,9 @@ namespace abb
       return result;
     }
 
-    TriBool RWSStateMachineInterface::Services::Main::isStationary(const std::string mechanical_unit) const
+    TriBool RWSStateMachineInterface::Services::Main::isStationary(const std::string& mechanical_unit) const
     {
+      RWSTracer::Span span("Services::Main", "isStationary");
       TriBool result;
 
       std::string temp_stationary = p_rws_interface_->getIOSignal(IOSignals::OUTPUT_STATIONARY + "_" + mechanical_unit);
@@ -278,10 +292,11 @@ namespace abb
      * Primary methods
      */
 
-    bool RWSStateMachineInterface::Services::RAPID::runCallByVar(const std::string task,
-                                                                 const std::string routine_name,
+    bool RWSStateMachineInterface::Services::RAPID::runCallByVar(const std::string& task,
+                                                                 const std::string& routine_name,
                                                                  const unsigned int routine_number) const
     {
+      RWSTracer::Span span("Services::RAPID", "runCallByVar");
       RAPIDString temp_routine_name(routine_name);
       RAPIDNum temp_routine_number(routine_number);
       return p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_CALL_BY_VAR_NAME_INPUT, temp_routine_name) &&
@@ -289,52 +304,78 @@ namespace abb
              setRoutineName(task, Procedures::RUN_CALL_BY_VAR) && signalRunRAPIDRoutine();
     }
 
-    bool RWSStateMachineInterface::Services::RAPID::runModuleLoad(const std::string task, const std::string file_path) const
+    bool RWSStateMachineInterface::Services::RAPID::runModuleLoad(const std::string& task, const std::string& file_path) const
     {
+      RWSTracer::Span span("Services::RAPID", "runModuleLoad");
       RAPIDString temp_file_path(file_path);
-      return p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_MODULE_FILE_PATH_INPUT, temp_file_path) &&
-             setRoutineName(task, Procedures::RUN_MODULE_LOAD) && signalRunRAPIDRoutine();
+
+      bool result = p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_MODULE_FILE_PATH_INPUT, temp_file_path) &&
+                    setRoutineName(task, Procedures::RUN_MODULE_LOAD) && signalRunRAPIDRoutine();
+
+      // Symbols and modules may be added, removed or redeclared, so the cached metadata and responses are dropped once
+      // the routine has been signalled. The routine runs asynchronously, so reads can still cache stale metadata until
+      // it has finished, but those are detected (and retried) by the typed RAPID symbol reads.
+      p_rws_interface_->invalidateRAPIDSymbolMetadata();
+      p_rws_interface_->invalidateResponseCache();
+
+      return result;
     }
 
-    bool RWSStateMachineInterface::Services::RAPID::runModuleUnload(const std::string task,
-                                                                    const std::string file_path) const
+    bool RWSStateMachineInterface::Services::RAPID::runModuleUnload(const std::string& task,
+                                                                    const std::string& file_path) const
     {
+      RWSTracer::Span span("Services::RAPID", "runModuleUnload");
       RAPIDString temp_file_path(file_path);
-      return p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_MODULE_FILE_PATH_INPUT, temp_file_path) &&
-             setRoutineName(task, Procedures::RUN_MODULE_UNLOAD) && signalRunRAPIDRoutine();
+
+      bool result = p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_MODULE_FILE_PATH_INPUT, temp_file_path) &&
+                    setRoutineName(task, Procedures::RUN_MODULE_UNLOAD) && signalRunRAPIDRoutine();
+
+      // Symbols and modules may be added, removed or redeclared, so the cached metadata and responses are dropped once
+      // the routine has been signalled. The routine runs asynchronously, so reads can still cache stale metadata until
+      // it has finished, but those are detected (and retried) by the typed RAPID symbol reads.
+      p_rws_interface_->invalidateRAPIDSymbolMetadata();
+      p_rws_interface_->invalidateResponseCache();
+
+      return result;
     }
 
-    bool RWSStateMachineInterface::Services::RAPID::runMoveAbsJ(const std::string task, JointTarget joint_target) const
+    bool RWSStateMachineInterface::Services::RAPID::runMoveAbsJ(const std::string& task, JointTarget joint_target) const
     {
+      RWSTracer::Span span("Services::RAPID", "runMoveAbsJ");
       return p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_MOVE_JOINT_TARGET_INPUT, joint_target) &&
              setRoutineName(task, Procedures::RUN_MOVE_ABS_J) && signalRunRAPIDRoutine();
     }
 
-    bool RWSStateMachineInterface::Services::RAPID::runMoveJ(const std::string task, RobTarget rob_target) const
+    bool RWSStateMachineInterface::Services::RAPID::runMoveJ(const std::string& task, RobTarget rob_target) const
     {
+      RWSTracer::Span span("Services::RAPID", "runMoveJ");
       return p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_MOVE_ROB_TARGET_INPUT, rob_target) &&
              setRoutineName(task, Procedures::RUN_MOVE_J) && signalRunRAPIDRoutine();
     }
 
-    bool RWSStateMachineInterface::Services::RAPID::runMoveToCalibrationPosition(const std::string task) const
+    bool RWSStateMachineInterface::Services::RAPID::runMoveToCalibrationPosition(const std::string& task) const
     {
+      RWSTracer::Span span("Services::RAPID", "runMoveToCalibrationPosition");
       return setRoutineName(task, Procedures::RUN_MOVE_TO_CALIBRATION_POSITION) && signalRunRAPIDRoutine();
     }
 
-    bool RWSStateMachineInterface::Services::RAPID::setMoveSpeed(const std::string task, SpeedData speed_data) const
+    bool RWSStateMachineInterface::Services::RAPID::setMoveSpeed(const std::string& task, SpeedData speed_data) const
     {
+      RWSTracer::Span span("Services::RAPID", "setMoveSpeed");
       return p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_MOVE_SPEED_INPUT, speed_data);
     }
 
-    bool RWSStateMachineInterface::Services::RAPID::setRoutineName(const std::string task,
-                                                                   const std::string routine_name) const
+    bool RWSStateMachineInterface::Services::RAPID::setRoutineName(const std::string& task,
+                                                                   const std::string& routine_name) const
     {
+      RWSTracer::Span span("Services::RAPID", "setRoutineName");
       RAPIDString temp_routine_name(routine_name);
       return p_rws_interface_->setRAPIDSymbolData(task, Symbols::RAPID_ROUTINE_NAME_INPUT, temp_routine_name);
     }
 
     bool RWSStateMachineInterface::Services::RAPID::signalRunRAPIDRoutine() const
     {
+      RWSTracer::Span span("Services::RAPID", "signalRunRAPIDRoutine");
       return p_rws_interface_->toggleIOSignal(IOSignals::RUN_RAPID_ROUTINE);
     }
 
@@ -348,6 +389,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualBlow1Off() const
     {
+      RWSTracer::Span span("Services::SG", "dualBlow1Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_BLOW_OFF_1) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_BLOW_OFF_1) &&
              signalRunSGRoutine();
@@ -355,6 +397,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualBlow1On() const
     {
+      RWSTracer::Span span("Services::SG", "dualBlow1On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_BLOW_ON_1) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_BLOW_ON_1) &&
              signalRunSGRoutine();
@@ -362,6 +405,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualBlow2Off() const
     {
+      RWSTracer::Span span("Services::SG", "dualBlow2Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_BLOW_OFF_2) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_BLOW_OFF_2) &&
              signalRunSGRoutine();
@@ -369,6 +413,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualBlow2On() const
     {
+      RWSTracer::Span span("Services::SG", "dualBlow2On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_BLOW_ON_2) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_BLOW_ON_2) &&
              signalRunSGRoutine();
@@ -376,6 +421,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualCalibrate() const
     {
+      RWSTracer::Span span("Services::SG", "dualCalibrate");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_CALIBRATE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_CALIBRATE) &&
              signalRunSGRoutine();
@@ -384,12 +430,14 @@ namespace abb
     bool RWSStateMachineInterface::Services::SG::dualGetSettings(SGSettings *p_left_settings,
                                                                  SGSettings *p_right_settings) const
     {
+      RWSTracer::Span span("Services::SG", "dualGetSettings");
       return getSettings(SystemConstants::RAPID::TASK_ROB_L, p_left_settings) &&
              getSettings(SystemConstants::RAPID::TASK_ROB_R, p_right_settings);
     }
 
     bool RWSStateMachineInterface::Services::SG::dualGripIn() const
     {
+      RWSTracer::Span span("Services::SG", "dualGripIn");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_GRIP_IN) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_GRIP_IN) &&
              signalRunSGRoutine();
@@ -397,6 +445,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualGripOut() const
     {
+      RWSTracer::Span span("Services::SG", "dualGripOut");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_GRIP_OUT) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_GRIP_OUT) &&
              signalRunSGRoutine();
@@ -404,6 +453,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualInitialize() const
     {
+      RWSTracer::Span span("Services::SG", "dualInitialize");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_INITIALIZE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_INITIALIZE) &&
              signalRunSGRoutine();
@@ -411,6 +461,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualMoveTo(const float left_position, const float right_position) const
     {
+      RWSTracer::Span span("Services::SG", "dualMoveTo");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_MOVE_TO) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_MOVE_TO) &&
              setTargetPositionInput(SystemConstants::RAPID::TASK_ROB_L, left_position) &&
@@ -420,12 +471,14 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualSetSettings(SGSettings left_settings, SGSettings right_settings) const
     {
+      RWSTracer::Span span("Services::SG", "dualSetSettings");
       return setSettings(SystemConstants::RAPID::TASK_ROB_L, left_settings) &&
              setSettings(SystemConstants::RAPID::TASK_ROB_R, right_settings);
     }
 
     bool RWSStateMachineInterface::Services::SG::dualVacuum1Off() const
     {
+      RWSTracer::Span span("Services::SG", "dualVacuum1Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_VACUUM_OFF_1) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_VACUUM_OFF_1) &&
              signalRunSGRoutine();
@@ -433,6 +486,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualVacuum1On() const
     {
+      RWSTracer::Span span("Services::SG", "dualVacuum1On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_VACUUM_ON_1) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_VACUUM_ON_1) &&
              signalRunSGRoutine();
@@ -440,6 +494,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualVacuum2Off() const
     {
+      RWSTracer::Span span("Services::SG", "dualVacuum2Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_VACUUM_OFF_2) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_VACUUM_OFF_2) &&
              signalRunSGRoutine();
@@ -447,6 +502,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::dualVacuum2On() const
     {
+      RWSTracer::Span span("Services::SG", "dualVacuum2On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_VACUUM_ON_2) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_VACUUM_ON_2) &&
              signalRunSGRoutine();
@@ -454,6 +510,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftBlow1Off() const
     {
+      RWSTracer::Span span("Services::SG", "leftBlow1Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_BLOW_OFF_1) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -461,6 +518,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftBlow1On() const
     {
+      RWSTracer::Span span("Services::SG", "leftBlow1On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_BLOW_ON_1) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -468,6 +526,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftBlow2Off() const
     {
+      RWSTracer::Span span("Services::SG", "leftBlow2Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_BLOW_OFF_2) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -475,6 +534,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftBlow2On() const
     {
+      RWSTracer::Span span("Services::SG", "leftBlow2On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_BLOW_ON_2) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -482,6 +542,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftCalibrate() const
     {
+      RWSTracer::Span span("Services::SG", "leftCalibrate");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_CALIBRATE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -489,11 +550,13 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftGetSettings(SGSettings *p_settings) const
     {
+      RWSTracer::Span span("Services::SG", "leftGetSettings");
       return getSettings(SystemConstants::RAPID::TASK_ROB_L, p_settings);
     }
 
     bool RWSStateMachineInterface::Services::SG::leftGripIn() const
     {
+      RWSTracer::Span span("Services::SG", "leftGripIn");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_GRIP_IN) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -501,6 +564,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftGripOut() const
     {
+      RWSTracer::Span span("Services::SG", "leftGripOut");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_GRIP_OUT) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -508,6 +572,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftInitialize() const
     {
+      RWSTracer::Span span("Services::SG", "leftInitialize");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_INITIALIZE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -515,6 +580,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftMoveTo(const float position) const
     {
+      RWSTracer::Span span("Services::SG", "leftMoveTo");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_MOVE_TO) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              setTargetPositionInput(SystemConstants::RAPID::TASK_ROB_L, position) &&
@@ -523,11 +589,13 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftSetSettings(SGSettings settings) const
     {
+      RWSTracer::Span span("Services::SG", "leftSetSettings");
       return setSettings(SystemConstants::RAPID::TASK_ROB_L, settings);
     }
 
     bool RWSStateMachineInterface::Services::SG::leftVacuum1Off() const
     {
+      RWSTracer::Span span("Services::SG", "leftVacuum1Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_VACUUM_OFF_1) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -535,6 +603,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftVacuum1On() const
     {
+      RWSTracer::Span span("Services::SG", "leftVacuum1On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_VACUUM_ON_1) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -542,6 +611,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftVacuum2Off() const
     {
+      RWSTracer::Span span("Services::SG", "leftVacuum2Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_VACUUM_OFF_2) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -549,6 +619,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::leftVacuum2On() const
     {
+      RWSTracer::Span span("Services::SG", "leftVacuum2On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_VACUUM_ON_2) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_NONE) &&
              signalRunSGRoutine();
@@ -556,6 +627,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightBlow1Off() const
     {
+      RWSTracer::Span span("Services::SG", "rightBlow1Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_BLOW_OFF_1) &&
              signalRunSGRoutine();
@@ -563,6 +635,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightBlow1On() const
     {
+      RWSTracer::Span span("Services::SG", "rightBlow1On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_BLOW_ON_1) &&
              signalRunSGRoutine();
@@ -570,6 +643,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightBlow2Off() const
     {
+      RWSTracer::Span span("Services::SG", "rightBlow2Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_BLOW_OFF_2) &&
              signalRunSGRoutine();
@@ -577,6 +651,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightBlow2On() const
     {
+      RWSTracer::Span span("Services::SG", "rightBlow2On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_BLOW_ON_2) &&
              signalRunSGRoutine();
@@ -584,6 +659,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightCalibrate() const
     {
+      RWSTracer::Span span("Services::SG", "rightCalibrate");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_CALIBRATE) &&
              signalRunSGRoutine();
@@ -591,11 +667,13 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightGetSettings(SGSettings *p_settings) const
     {
+      RWSTracer::Span span("Services::SG", "rightGetSettings");
       return getSettings(SystemConstants::RAPID::TASK_ROB_R, p_settings);
     }
 
     bool RWSStateMachineInterface::Services::SG::rightGripIn() const
     {
+      RWSTracer::Span span("Services::SG", "rightGripIn");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_GRIP_IN) &&
              signalRunSGRoutine();
@@ -603,6 +681,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightGripOut() const
     {
+      RWSTracer::Span span("Services::SG", "rightGripOut");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_GRIP_OUT) &&
              signalRunSGRoutine();
@@ -610,6 +689,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightInitialize() const
     {
+      RWSTracer::Span span("Services::SG", "rightInitialize");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_INITIALIZE) &&
              signalRunSGRoutine();
@@ -617,6 +697,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightMoveTo(const float position) const
     {
+      RWSTracer::Span span("Services::SG", "rightMoveTo");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_MOVE_TO) &&
              setTargetPositionInput(SystemConstants::RAPID::TASK_ROB_R, position) &&
@@ -625,11 +706,13 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightSetSettings(SGSettings settings) const
     {
+      RWSTracer::Span span("Services::SG", "rightSetSettings");
       return setSettings(SystemConstants::RAPID::TASK_ROB_R, settings);
     }
 
     bool RWSStateMachineInterface::Services::SG::rightVacuum1Off() const
     {
+      RWSTracer::Span span("Services::SG", "rightVacuum1Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_VACUUM_OFF_1) &&
              signalRunSGRoutine();
@@ -637,6 +720,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightVacuum1On() const
     {
+      RWSTracer::Span span("Services::SG", "rightVacuum1On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_VACUUM_ON_1) &&
              signalRunSGRoutine();
@@ -644,6 +728,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightVacuum2Off() const
     {
+      RWSTracer::Span span("Services::SG", "rightVacuum2Off");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_VACUUM_OFF_2) &&
              signalRunSGRoutine();
@@ -651,6 +736,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::rightVacuum2On() const
     {
+      RWSTracer::Span span("Services::SG", "rightVacuum2On");
       return setCommandInput(SystemConstants::RAPID::TASK_ROB_L, SG_COMMAND_NONE) &&
              setCommandInput(SystemConstants::RAPID::TASK_ROB_R, SG_COMMAND_VACUUM_ON_2) &&
              signalRunSGRoutine();
@@ -658,11 +744,13 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::signalRunSGRoutine() const
     {
+      RWSTracer::Span span("Services::SG", "signalRunSGRoutine");
       return p_rws_interface_->toggleIOSignal(IOSignals::RUN_SG_ROUTINE);
     }
 
     bool RWSStateMachineInterface::Services::SG::GripIn() const
     {
+      RWSTracer::Span span("Services::SG", "GripIn");
       if (p_rws_interface_->getIOSignal(IOSignals::SG_STATUS_CALIBRATED) == SystemConstants::IOSignals::LOW)
         return false;
       else
@@ -686,6 +774,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::GripOut() const
     {
+      RWSTracer::Span span("Services::SG", "GripOut");
       if (p_rws_interface_->getIOSignal(IOSignals::SG_STATUS_CALIBRATED) == SystemConstants::IOSignals::LOW)
         return false;
       else
@@ -709,6 +798,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::JogIn() const
     {
+      RWSTracer::Span span("Services::SG", "JogIn");
       p_rws_interface_->setIOSignal(IOSignals::SG_CMD_GRIPPER, SG_CMD_GO_TO_READY);
       while (p_rws_interface_->getIOSignal(IOSignals::SG_SYS_STATE) != SG_STATE_READY)
       {
@@ -733,6 +823,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::JogOut() const
     {
+      RWSTracer::Span span("Services::SG", "JogOut");
       p_rws_interface_->setIOSignal(IOSignals::SG_CMD_GRIPPER, SG_CMD_GO_TO_READY);
       while (p_rws_interface_->getIOSignal(IOSignals::SG_SYS_STATE) != SG_STATE_READY)
       {
@@ -757,6 +848,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::Calibrate(uint32_t max_force, uint32_t max_speed) const
     {
+      RWSTracer::Span span("Services::SG", "Calibrate");
       if (max_force > 200)
         max_force = 200;
       if (max_speed > 250)
@@ -784,11 +876,13 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::Calibrate() const
     {
+      RWSTracer::Span span("Services::SG", "Calibrate");
       return Calibrate(200, 250);
     }
 
-    bool RWSStateMachineInterface::Services::SG::Initialize(const std::string task) const
+    bool RWSStateMachineInterface::Services::SG::Initialize(const std::string& task) const
     {
+      RWSTracer::Span span("Services::SG", "Initialize");
       return setCommandInput(task, SG_COMMAND_INITIALIZE) &&
              signalRunSGRoutine();
     }
@@ -801,6 +895,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::VacuumOn(uint32_t num_valve = 1) const
     {
+      RWSTracer::Span span("Services::SG", "VacuumOn");
       std::string sg_status_blow = IOSignals::SG_STATUS_BLOW + std::to_string(num_valve);
       std::string sg_cmd_blow = IOSignals::SG_CMD_BLOW + std::to_string(num_valve);
       std::string sg_cmd_vacuum = IOSignals::SG_CMD_VACUUM + std::to_string(num_valve);
@@ -817,6 +912,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::VacuumOff(uint32_t num_valve = 1) const
     {
+      RWSTracer::Span span("Services::SG", "VacuumOff");
       std::string sg_cmd_vacuum = IOSignals::SG_CMD_VACUUM + std::to_string(num_valve);
       p_rws_interface_->setIOSignal(sg_cmd_vacuum, SystemConstants::IOSignals::LOW);
       return true;
@@ -824,6 +920,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::BlowOn(uint32_t num_valve = 1) const
     {
+      RWSTracer::Span span("Services::SG", "BlowOn");
       std::string sg_status_vacuum = IOSignals::SG_STATUS_VACUUM + std::to_string(num_valve);
       std::string sg_cmd_blow = IOSignals::SG_CMD_BLOW + std::to_string(num_valve);
       std::string sg_cmd_vacuum = IOSignals::SG_CMD_VACUUM + std::to_string(num_valve);
@@ -840,6 +937,7 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::SG::BlowOff(uint32_t num_valve = 1) const
     {
+      RWSTracer::Span span("Services::SG", "BlowOff");
       std::string sg_cmd_blow = IOSignals::SG_CMD_BLOW + std::to_string(num_valve);
       p_rws_interface_->setIOSignal(sg_cmd_blow, SystemConstants::IOSignals::HIGH);
       return true;
@@ -847,6 +945,7 @@ namespace abb
 
     std::string RWSStateMachineInterface::Services::SG::getPressure(uint32_t num_valve = 1) const
     {
+      RWSTracer::Span span("Services::SG", "getPressure");
       std::string sg_actual_pressure = IOSignals::SG_ACTUAL_PRESSURE + std::to_string(num_valve);
       return p_rws_interface_->getIOSignal(sg_actual_pressure);
     }
@@ -855,24 +954,28 @@ namespace abb
      * Auxiliary methods
      */
 
-    bool RWSStateMachineInterface::Services::SG::getSettings(const std::string task, SGSettings *p_settings) const
+    bool RWSStateMachineInterface::Services::SG::getSettings(const std::string& task, SGSettings *p_settings) const
     {
+      RWSTracer::Span span("Services::SG", "getSettings");
       return p_rws_interface_->getRAPIDSymbolData(task, Symbols::SG_SETTINGS, p_settings);
     }
 
-    bool RWSStateMachineInterface::Services::SG::setCommandInput(const std::string task, const SGCommands command) const
+    bool RWSStateMachineInterface::Services::SG::setCommandInput(const std::string& task, const SGCommands command) const
     {
+      RWSTracer::Span span("Services::SG", "setCommandInput");
       RAPIDNum temp_command(command);
       return p_rws_interface_->setRAPIDSymbolData(task, Symbols::SG_COMMAND_INPUT, temp_command);
     }
 
-    bool RWSStateMachineInterface::Services::SG::setSettings(const std::string task, SGSettings settings) const
+    bool RWSStateMachineInterface::Services::SG::setSettings(const std::string& task, SGSettings settings) const
     {
+      RWSTracer::Span span("Services::SG", "setSettings");
       return p_rws_interface_->setRAPIDSymbolData(task, Symbols::SG_SETTINGS, settings);
     }
 
-    bool RWSStateMachineInterface::Services::SG::setTargetPositionInput(const std::string task, const float position) const
+    bool RWSStateMachineInterface::Services::SG::setTargetPositionInput(const std::string& task, const float position) const
     {
+      RWSTracer::Span span("Services::SG", "setTargetPositionInput");
       RAPIDNum temp_position(position);
       return p_rws_interface_->setRAPIDSymbolData(task, Symbols::SG_TARGET_POSTION_INPUT, temp_position);
     }
@@ -885,14 +988,16 @@ namespace abb
      * Primary methods
      */
 
-    bool RWSStateMachineInterface::Services::Utility::getBaseFrame(const std::string task, Pose *p_base_frame) const
+    bool RWSStateMachineInterface::Services::Utility::getBaseFrame(const std::string& task, Pose *p_base_frame) const
     {
+      RWSTracer::Span span("Services::Utility", "getBaseFrame");
       return p_rws_interface_->getRAPIDSymbolData(task, Symbols::UTILITY_BASE_FRAME, p_base_frame);
     }
 
-    bool RWSStateMachineInterface::Services::Utility::getCalibrationTarget(const std::string task,
+    bool RWSStateMachineInterface::Services::Utility::getCalibrationTarget(const std::string& task,
                                                                            JointTarget *p_calibration_joint_target) const
     {
+      RWSTracer::Span span("Services::Utility", "getCalibrationTarget");
       return p_rws_interface_->getRAPIDSymbolData(task, Symbols::UTILITY_CALIBRATION_TARGET, p_calibration_joint_target);
     }
 
@@ -904,8 +1009,9 @@ namespace abb
      * Primary methods
      */
 
-    TriBool RWSStateMachineInterface::Services::Watchdog::isActive(const std::string task) const
+    TriBool RWSStateMachineInterface::Services::Watchdog::isActive(const std::string& task) const
     {
+      RWSTracer::Span span("Services::Watchdog", "isActive");
       TriBool result;
       RAPIDBool temp_active;
 
@@ -917,8 +1023,9 @@ namespace abb
       return result;
     }
 
-    TriBool RWSStateMachineInterface::Services::Watchdog::isCheckingExternalStatus(const std::string task) const
+    TriBool RWSStateMachineInterface::Services::Watchdog::isCheckingExternalStatus(const std::string& task) const
     {
+      RWSTracer::Span span("Services::Watchdog", "isCheckingExternalStatus");
       TriBool result;
       RAPIDBool temp_check_external_status;
 
@@ -932,11 +1039,13 @@ namespace abb
 
     bool RWSStateMachineInterface::Services::Watchdog::setExternalStatusSignal() const
     {
+      RWSTracer::Span span("Services::Watchdog", "setExternalStatusSignal");
       return p_rws_interface_->setIOSignal(IOSignals::WD_EXTERNAL_STATUS, SystemConstants::IOSignals::HIGH);
     }
 
     bool RWSStateMachineInterface::Services::Watchdog::signalStopRequest() const
     {
+      RWSTracer::Span span("Services::Watchdog", "signalStopRequest");
       return p_rws_interface_->toggleIOSignal(IOSignals::WD_STOP_REQUEST);
     }
 
@@ -948,8 +1057,9 @@ namespace abb
      * Auxiliary methods
      */
 
-    bool RWSStateMachineInterface::toggleIOSignal(const std::string iosignal)
+    bool RWSStateMachineInterface::toggleIOSignal(const std::string& iosignal)
     {
+      RWSTracer::Span span("RWSStateMachineInterface", "toggleIOSignal");
       bool result = false;
       int max_number_of_attempts = 5;
 
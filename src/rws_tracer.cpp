@@ -0,0 +1,214 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Process-wide tracing of the library's activity as timed spans.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include "abb_librws/rws_tracer.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Class definitions: RWSTracer
+ */
+
+/************************************************************
+ * Static members
+ */
+
+std::atomic<bool> RWSTracer::enabled_(false);
+std::atomic<size_t> RWSTracer::thread_capacity_(RWSTracer::DEFAULT_THREAD_CAPACITY);
+std::mutex RWSTracer::mutex_;
+std::vector<std::shared_ptr<RWSTracer::ThreadBuffer>> RWSTracer::buffers_;
+
+/**
+ * \brief The tracer's epoch (all span timestamps are relative to it).
+ */
+static const std::chrono::steady_clock::time_point TRACER_EPOCH = std::chrono::steady_clock::now();
+
+/************************************************************
+ * Primary methods
+ */
+
+RWSTracer::Span::Span(const char* category, const char* name)
+:
+category_(category),
+name_(name),
+start_(isEnabled() ? now() : -1)
+{}
+
+RWSTracer::Span::~Span()
+{
+  if (start_ >= 0)
+  {
+    record(category_, name_, start_, now() - start_);
+  }
+}
+
+void RWSTracer::enable(const size_t thread_capacity)
+{
+  thread_capacity_.store(thread_capacity, std::memory_order_relaxed);
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void RWSTracer::disable()
+{
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void RWSTracer::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (size_t i = 0; i < buffers_.size(); ++i)
+  {
+    buffers_[i]->size.store(0, std::memory_order_release);
+    buffers_[i]->dropped.store(0, std::memory_order_relaxed);
+  }
+}
+
+Poco::UInt64 RWSTracer::getDroppedSpans()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Poco::UInt64 result = 0;
+  for (size_t i = 0; i < buffers_.size(); ++i)
+  {
+    result += buffers_[i]->dropped.load(std::memory_order_relaxed);
+  }
+
+  return result;
+}
+
+std::string RWSTracer::exportChromeTrace()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::stringstream ss;
+
+  ss << "{\"traceEvents\":[";
+
+  bool first = true;
+  for (size_t i = 0; i < buffers_.size(); ++i)
+  {
+    const ThreadBuffer& buffer = *buffers_[i];
+
+    ss << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.id
+       << ",\"args\":{\"name\":\"thread " << buffer.id << "\"}}";
+    first = false;
+
+    // Only the published spans are read, the owning thread never rewrites them (unless cleared).
+    size_t size = buffer.size.load(std::memory_order_acquire);
+    for (size_t j = 0; j < size; ++j)
+    {
+      const Event& event = buffer.events[j];
+
+      ss << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category << "\",\"ph\":\"X\""
+         << ",\"ts\":" << event.start << ",\"dur\":" << event.duration << ",\"pid\":1,\"tid\":" << buffer.id << "}";
+    }
+  }
+
+  ss << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  return ss.str();
+}
+
+bool RWSTracer::writeChromeTrace(const std::string& path)
+{
+  std::ofstream file(path.c_str(), std::ios::out | std::ios::trunc);
+  file << exportChromeTrace();
+  file.close();
+
+  return !file.fail();
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+Poco::Int64 RWSTracer::now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                               TRACER_EPOCH).count();
+}
+
+void RWSTracer::record(const char* category, const char* name, const Poco::Int64 start, const Poco::Int64 duration)
+{
+  ThreadBuffer& buffer = getThreadBuffer();
+  size_t size = buffer.size.load(std::memory_order_relaxed);
+
+  if (size < buffer.events.size())
+  {
+    Event& event = buffer.events[size];
+    event.category = category;
+    event.name = name;
+    event.start = start;
+    event.duration = duration;
+
+    buffer.size.store(size + 1, std::memory_order_release);
+  }
+  else
+  {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+RWSTracer::ThreadBuffer& RWSTracer::getThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> p_buffer;
+
+  if (!p_buffer)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    p_buffer = std::make_shared<ThreadBuffer>(static_cast<int>(buffers_.size()) + 1,
+                                              thread_capacity_.load(std::memory_order_relaxed));
+    buffers_.push_back(p_buffer);
+  }
+
+  return *p_buffer;
+}
+
+} // end namespace rws
+} // end namespace abb
@@ -0,0 +1,142 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Test that large request bodies are not copied on their way to the socket.
+ * 
+ ***********************************************************************************************************************
+ */
+
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "abb_librws/rws_client.h"
+#include "bench_allocations.h"
+#include "test_environment.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief The size of the request bodies [bytes], i.e. large enough for any copy of a body to stand out.
+ */
+static const size_t BODY_SIZE = 4 * 1024 * 1024;
+
+/**
+ * \brief A function for checking the heap bytes allocated (by the calling thread) during an operation.
+ *
+ * \param name for the operation's name.
+ * \param allocated_bytes for the bytes allocated during the operation.
+ * \param copies for the number of copies of the body that the operation is allowed to make.
+ * \param p_failures for counting the failed checks.
+ */
+static void checkCopies(const std::string& name, const size_t allocated_bytes, const size_t copies, int* p_failures)
+{
+  // Everything except the body copies (e.g. headers and the response) must fit in half a body.
+  check(allocated_bytes >= copies * BODY_SIZE && allocated_bytes < copies * BODY_SIZE + BODY_SIZE / 2,
+        name + " allocated " + std::to_string(allocated_bytes) + " bytes (expected " + std::to_string(copies) +
+        " copies of a " + std::to_string(BODY_SIZE) + " byte body)", p_failures);
+
+  std::cout << name << ": " << allocated_bytes << " bytes allocated" << std::endl;
+}
+
+} // end namespace rws
+} // end namespace abb
+
+/**
+ * \brief A test of the heap allocations per operation, which checks that the request bodies are not copied.
+ *
+ * \return int zero if all checks passed.
+ */
+int main()
+{
+  using namespace abb::rws;
+
+  TestEnvironment environment;
+
+  if (!environment.error.empty())
+  {
+    std::cerr << "FAILED: " << environment.error << std::endl;
+    return 1;
+  }
+
+  int failures = 0;
+  RWSClient client("127.0.0.1", environment.p_simulator->getPort(), environment.p_context);
+  const RWSClient::FileResource resource("allocation_test.txt");
+
+  // Warm up (i.e. connect and authenticate), so that the measurements only contain the operations themselves.
+  check(client.getIOSignal("ALLOCATION_DI").success, "the client failed to communicate with the simulator", &failures);
+
+  // A body moved into httpPost is sent without being copied.
+  std::string body(BODY_SIZE, 'x');
+  size_t allocated_bytes = getAllocatedBytes();
+  POCOClient::POCOResult poco_result = client.httpPost("/allocation-test", std::move(body));
+  allocated_bytes = getAllocatedBytes() - allocated_bytes;
+  check(poco_result.status == POCOClient::POCOResult::OK, "httpPost(...) failed", &failures);
+  checkCopies("httpPost(uri, std::move(content))", allocated_bytes, 0, &failures);
+
+  // A file content moved into uploadFile is sent without being copied.
+  std::string file_content(BODY_SIZE, 'y');
+  allocated_bytes = getAllocatedBytes();
+  RWSClient::RWSResult result = client.uploadFile(resource, std::move(file_content));
+  allocated_bytes = getAllocatedBytes() - allocated_bytes;
+  check(result.success, "uploadFile(resource, std::move(file_content)) failed", &failures);
+  checkCopies("uploadFile(resource, std::move(file_content))", allocated_bytes, 0, &failures);
+
+  // A file content passed by reference is copied exactly once (into the request).
+  const std::string kept_content(BODY_SIZE, 'z');
+  allocated_bytes = getAllocatedBytes();
+  result = client.uploadFile(resource, kept_content);
+  allocated_bytes = getAllocatedBytes() - allocated_bytes;
+  check(result.success, "uploadFile(resource, file_content) failed", &failures);
+  checkCopies("uploadFile(resource, file_content)", allocated_bytes, 1, &failures);
+
+  // The controller must have received the complete content.
+  std::string downloaded_content;
+  check(client.getFile(resource, &downloaded_content).success && downloaded_content == kept_content,
+        "getFile(...) didn't return the uploaded content", &failures);
+
+  std::cout << (failures == 0 ? "PASSED" : "FAILED") << " (" << failures << " failures)" << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}
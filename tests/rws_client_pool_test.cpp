@@ -0,0 +1,292 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Test of the RWS client pool, and of the pooled IO signal writes, run against the RWS simulator.
+ * 
+ ***********************************************************************************************************************
+ */
+
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "abb_librws/rws_client_pool.h"
+#include "abb_librws/rws_interface.h"
+#include "test_environment.h"
+
+namespace abb
+{
+namespace rws
+{
+typedef RWSInterface::IOSignalWrite IOSignalWrite;
+typedef RWSInterface::IOSignalWriteResult IOSignalWriteResult;
+
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief A function for testing that the pool grows lazily, up to its maximum size, and that clients are reused.
+ *
+ * \param environment for the test environment.
+ * \param p_failures for counting the failed checks.
+ */
+static void testPoolGrowth(TestEnvironment& environment, int* p_failures)
+{
+  RWSClientPool pool("127.0.0.1",
+                     environment.p_simulator->getPort(),
+                     SystemConstants::General::DEFAULT_USERNAME,
+                     SystemConstants::General::DEFAULT_PASSWORD,
+                     environment.p_context,
+                     2);
+
+  check(pool.getStatistics().clients == 0, "pool: clients were created before the first lease", p_failures);
+
+  RWSClient* p_first = 0;
+  {
+    RWSClientPool::Lease lease = pool.acquire();
+    p_first = &lease.client();
+  }
+
+  {
+    RWSClientPool::Lease lease = pool.acquire();
+    check(&lease.client() == p_first, "pool: a returned client was not reused", p_failures);
+    check(pool.getStatistics().clients == 1, "pool: a client was created while one was idle", p_failures);
+
+    RWSClientPool::Lease other = pool.acquire();
+    check(&other.client() != p_first, "pool: a leased client was handed out twice", p_failures);
+    check(pool.getStatistics().clients == 2, "pool: the pool did not grow for a concurrent lease", p_failures);
+
+    // The pool is at its maximum size, so a third lease must wait for one of the clients to be returned.
+    std::atomic<bool> acquired(false);
+    std::thread waiter([&pool, &acquired]()
+    {
+      RWSClientPool::Lease third = pool.acquire();
+      acquired = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check(!acquired, "pool: a lease was granted beyond the maximum size", p_failures);
+
+    {
+      RWSClientPool::Lease released(std::move(other));
+    }
+
+    waiter.join();
+    check(acquired, "pool: a waiting lease was not granted", p_failures);
+  }
+
+  RWSClientPool::Statistics statistics = pool.getStatistics();
+  check(statistics.clients == 2, "pool: the pool grew beyond its maximum size", p_failures);
+  check(statistics.acquisitions == 4, "pool: wrong number of acquisitions", p_failures);
+  check(statistics.waits == 1, "pool: wrong number of waits", p_failures);
+
+  // All jobs run, on at most the pool's clients, and the clients' requests succeed.
+  std::vector<int> results(6, 0);
+  std::vector<RWSClientPool::Job> jobs;
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    jobs.push_back([&results, i](RWSClient& client)
+    {
+      results[i] = client.getIOSignal("POOL_DI").success ? 1 : -1;
+    });
+  }
+
+  pool.execute(jobs);
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    check(results[i] == 1, "pool: job " + std::to_string(i) + " was not executed successfully", p_failures);
+  }
+  check(pool.getStatistics().clients == 2, "pool: execute(...) grew the pool beyond its maximum size", p_failures);
+}
+
+/**
+ * \brief A function for testing that an exception thrown by a job is rethrown on the calling thread.
+ *
+ * \param environment for the test environment.
+ * \param p_failures for counting the failed checks.
+ */
+static void testPoolExceptions(TestEnvironment& environment, int* p_failures)
+{
+  RWSClientPool pool("127.0.0.1",
+                     environment.p_simulator->getPort(),
+                     SystemConstants::General::DEFAULT_USERNAME,
+                     SystemConstants::General::DEFAULT_PASSWORD,
+                     environment.p_context,
+                     4);
+
+  std::vector<RWSClientPool::Job> jobs;
+  for (int i = 0; i < 8; ++i)
+  {
+    jobs.push_back([i](RWSClient&)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+      if (i == 3)
+      {
+        throw std::runtime_error("job 3");
+      }
+    });
+  }
+
+  std::string message;
+  try
+  {
+    pool.execute(jobs);
+  }
+  catch (const std::runtime_error& e)
+  {
+    message = e.what();
+  }
+
+  check(message == "job 3", "pool: a job's exception was not rethrown by execute(...)", p_failures);
+
+  // All clients must have been returned to the pool.
+  std::vector<RWSClientPool::Lease> leases;
+  for (int i = 0; i < 4; ++i)
+  {
+    leases.push_back(pool.acquire());
+  }
+  check(pool.getStatistics().waits == 0, "pool: a client was not returned after an exception", p_failures);
+}
+
+/**
+ * \brief A function for testing the coalescing, and the skipping of unchanged values, of pooled IO signal writes.
+ *
+ * \param environment for the test environment.
+ * \param p_failures for counting the failed checks.
+ */
+static void testSetIOSignals(TestEnvironment& environment, int* p_failures)
+{
+  environment.p_simulator->setIOSignal("POOL_DO_A", "0");
+  environment.p_simulator->setIOSignal("POOL_DO_B", "0");
+
+  RWSInterface interface("127.0.0.1", environment.p_simulator->getPort(), environment.p_context);
+
+  // Writes to the same signal are coalesced, so only the last one is sent.
+  std::vector<IOSignalWrite> writes;
+  writes.push_back(IOSignalWrite("POOL_DO_A", "1"));
+  writes.push_back(IOSignalWrite("POOL_DO_B", "1"));
+  writes.push_back(IOSignalWrite("POOL_DO_A", "0"));
+
+  std::vector<IOSignalWriteResult> results = interface.setIOSignals(writes);
+
+  check(results.size() == 3 &&
+        results[0].outcome == IOSignalWriteResult::SKIPPED_SUPERSEDED &&
+        results[1].outcome == IOSignalWriteResult::WRITTEN &&
+        results[2].outcome == IOSignalWriteResult::WRITTEN,
+        "setIOSignals: wrong outcomes of coalesced writes", p_failures);
+  check(environment.p_simulator->getIOSignal("POOL_DO_A") == "0" &&
+        environment.p_simulator->getIOSignal("POOL_DO_B") == "1",
+        "setIOSignals: the simulator holds wrong values after coalesced writes", p_failures);
+
+  // Writes of the last known values are skipped, without any request.
+  writes.clear();
+  writes.push_back(IOSignalWrite("POOL_DO_A", "0"));
+  writes.push_back(IOSignalWrite("POOL_DO_B", "1"));
+
+  Poco::UInt64 requests = environment.p_simulator->getRequestCount();
+  results = interface.setIOSignals(writes);
+
+  check(results.size() == 2 &&
+        results[0].outcome == IOSignalWriteResult::SKIPPED_UNCHANGED &&
+        results[1].outcome == IOSignalWriteResult::SKIPPED_UNCHANGED,
+        "setIOSignals: unchanged values were not skipped", p_failures);
+  check(environment.p_simulator->getRequestCount() == requests,
+        "setIOSignals: skipped writes made requests", p_failures);
+
+  // Unless skipping is disabled, or the last known values are forgotten.
+  results = interface.setIOSignals(writes, false);
+  check(results[0].outcome == IOSignalWriteResult::WRITTEN && results[1].outcome == IOSignalWriteResult::WRITTEN,
+        "setIOSignals: unchanged values were skipped, although skipping was disabled", p_failures);
+
+  interface.clearIOSignalStates();
+  results = interface.setIOSignals(writes);
+  check(results[0].outcome == IOSignalWriteResult::WRITTEN && results[1].outcome == IOSignalWriteResult::WRITTEN,
+        "setIOSignals: values were skipped after clearIOSignalStates()", p_failures);
+
+  // Writes that change a value are sent.
+  writes.clear();
+  writes.push_back(IOSignalWrite("POOL_DO_A", "1"));
+  writes.push_back(IOSignalWrite("POOL_DO_B", "1"));
+
+  results = interface.setIOSignals(writes);
+  check(results[0].outcome == IOSignalWriteResult::WRITTEN &&
+        results[1].outcome == IOSignalWriteResult::SKIPPED_UNCHANGED,
+        "setIOSignals: wrong outcomes of a partially changed batch", p_failures);
+  check(environment.p_simulator->getIOSignal("POOL_DO_A") == "1",
+        "setIOSignals: the simulator holds a wrong value after a changed write", p_failures);
+}
+
+} // end namespace rws
+} // end namespace abb
+
+/**
+ * \brief A test of the RWS client pool, and of the pooled IO signal writes.
+ *
+ * \return int zero if all checks passed.
+ */
+int main()
+{
+  using namespace abb::rws;
+
+  TestEnvironment environment;
+
+  if (!environment.error.empty())
+  {
+    std::cerr << "FAILED: " << environment.error << std::endl;
+    return 1;
+  }
+
+  environment.p_simulator->setIOSignal("POOL_DI", "1");
+
+  int failures = 0;
+
+  testPoolGrowth(environment, &failures);
+  testPoolExceptions(environment, &failures);
+  testSetIOSignals(environment, &failures);
+
+  std::cout << (failures == 0 ? "PASSED" : "FAILED") << " (" << failures << " failures)" << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Test that one RWS client can be shared by several threads, run against the RWS simulator.
+ * 
+ ***********************************************************************************************************************
+ */
+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "abb_librws/rws_client.h"
+#include "abb_librws/rws_rapid.h"
+#include "test_environment.h"
+
+namespace abb
+{
+namespace rws
+{
+typedef SystemConstants::RWS::XMLAttributes XMLAttributes;
+
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief The number of threads sharing the client.
+ */
+static const int NUMBER_OF_THREADS = 8;
+
+/**
+ * \brief The number of iterations per thread.
+ */
+static const int NUMBER_OF_ITERATIONS = 50;
+
+/**
+ * \brief A function for one thread's share of the stress test.
+ *
+ * Each thread owns an IO signal and a RAPID symbol (so the expected values are known), and it interleaves reads and
+ * writes of them with reads of the RobotWare system resource (which are served by the client's response cache).
+ *
+ * \param p_client for the client shared by all threads.
+ * \param id for the thread's id.
+ * \param p_failures for counting the thread's failed checks.
+ */
+static void stressClient(RWSClient* p_client, const int id, int* p_failures)
+{
+  const std::string iosignal = "STRESS_DI_" + std::to_string(id);
+  const RWSClient::RAPIDResource resource("T_ROB1", "Stress", "value_" + std::to_string(id));
+  const std::string prefix = "thread " + std::to_string(id) + ": ";
+
+  for (int i = 0; i < NUMBER_OF_ITERATIONS; ++i)
+  {
+    RWSClient::RWSResult result = p_client->getIOSignal(iosignal);
+    check(result.success &&
+          xmlFindTextContent(result.p_xml_document, XMLAttributes::CLASS_LVALUE) == std::to_string(id % 2),
+          prefix + "getIOSignal(" + iosignal + ") returned a wrong value", p_failures);
+
+    RAPIDNum written(static_cast<float>(id * 1000 + i));
+    check(p_client->setRAPIDSymbolData(resource, written).success,
+          prefix + "setRAPIDSymbolData(...) failed", p_failures);
+
+    RAPIDNum read;
+    check(p_client->getRAPIDSymbolData(resource, &read).success && read.value == written.value,
+          prefix + "getRAPIDSymbolData(...) returned " + read.constructString() + " (expected " +
+          written.constructString() + ")", p_failures);
+
+    result = p_client->getRobotWareSystem();
+    check(result.success &&
+          xmlFindTextContent(result.p_xml_document, XMLAttribute("class", "rwversion")) == "6.08.0000",
+          prefix + "getRobotWareSystem() returned a wrong version", p_failures);
+  }
+}
+
+} // end namespace rws
+} // end namespace abb
+
+/**
+ * \brief A stress test for a client shared by several threads (see RWSClient's thread safety notes).
+ *
+ * \return int zero if all checks passed.
+ */
+int main()
+{
+  using namespace abb::rws;
+
+  TestEnvironment environment;
+
+  if (!environment.error.empty())
+  {
+    std::cerr << "FAILED: " << environment.error << std::endl;
+    return 1;
+  }
+
+  for (int id = 0; id < NUMBER_OF_THREADS; ++id)
+  {
+    environment.p_simulator->setIOSignal("STRESS_DI_" + std::to_string(id), std::to_string(id % 2));
+    environment.p_simulator->setRAPIDSymbol("T_ROB1", "Stress", "value_" + std::to_string(id), "0", "num");
+  }
+
+  RWSClient client("127.0.0.1", environment.p_simulator->getPort(), environment.p_context);
+  std::vector<std::thread> threads;
+  std::vector<int> failures(NUMBER_OF_THREADS, 0);
+
+  for (int id = 0; id < NUMBER_OF_THREADS; ++id)
+  {
+    threads.emplace_back(stressClient, &client, id, &failures[id]);
+  }
+
+  int total_failures = 0;
+
+  for (int id = 0; id < NUMBER_OF_THREADS; ++id)
+  {
+    threads[id].join();
+    total_failures += failures[id];
+  }
+
+  // The final values must be the last values written by each thread.
+  for (int id = 0; id < NUMBER_OF_THREADS; ++id)
+  {
+    RAPIDNum expected(static_cast<float>(id * 1000 + NUMBER_OF_ITERATIONS - 1));
+    check(environment.p_simulator->getRAPIDSymbol("T_ROB1", "Stress", "value_" + std::to_string(id)) ==
+          expected.constructString(), "the simulator holds a wrong final value", &total_failures);
+  }
+
+  std::cout << (total_failures == 0 ? "PASSED" : "FAILED") << " (" << NUMBER_OF_THREADS << " threads, "
+            << NUMBER_OF_ITERATIONS << " iterations each, " << total_failures << " failures)" << std::endl;
+
+  return total_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,425 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Unit tests of the RAPID data parsing, serialization and change tracking (no controller needed).
+ * 
+ ***********************************************************************************************************************
+ */
+
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abb_librws/rws_client.h"
+#include "abb_librws/rws_rapid.h"
+#include "abb_librws/rws_rapid_schema.h"
+#include "abb_librws/rws_rapid_value.h"
+#include "test_check.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief A function for checking that a value string is parsed, and constructed back into the same string.
+ *
+ * \param data for the data to parse into.
+ * \param value containing the value string.
+ * \param p_failures for counting the failed checks.
+ */
+static void checkRoundTrip(RAPIDSymbolDataAbstract& data, const std::string& value, int* p_failures)
+{
+  RAPIDParser parser(value);
+
+  if (check(parser.parse(data), "round trip: " + value + " failed at position " +
+            std::to_string(parser.getErrorPosition()) + " (" + parser.getErrorMessage() + ")", p_failures))
+  {
+    check(data.constructString() == value, "round trip: " + value + " became " + data.constructString(), p_failures);
+  }
+}
+
+/**
+ * \brief A function for checking that a value string fails to parse at a position, and leaves the data untouched.
+ *
+ * \param data for the data to parse into (holding a value, which must be kept).
+ * \param value containing the malformed value string.
+ * \param position for the expected error position.
+ * \param p_failures for counting the failed checks.
+ */
+static void checkParseError(RAPIDSymbolDataAbstract& data,
+                            const std::string& value,
+                            const size_t position,
+                            int* p_failures)
+{
+  const std::string before = data.constructString();
+  RAPIDParser parser(value);
+
+  check(!data.tryParse(parser), "error: " + value + " was parsed", p_failures);
+  check(parser.hasFailed() && parser.getErrorPosition() == position,
+        "error: " + value + " failed at position " + std::to_string(parser.getErrorPosition()) + " (expected " +
+        std::to_string(position) + ")", p_failures);
+  check(data.constructString() == before,
+        "error: " + value + " changed the data from " + before + " to " + data.constructString(), p_failures);
+}
+
+/**
+ * \brief A function for testing parse and construct round trips.
+ *
+ * \param p_failures for counting the failed checks.
+ */
+static void testRoundTrips(int* p_failures)
+{
+  const std::string rob_target = "[[515,0,712.5],[1,0,0,0],[0,-1,2,0],[9E+09,9E+09,9E+09,9E+09,9E+09,9E+09]]";
+  const std::string tool_data = "[TRUE,[[0,0,100],[1,0,0,0]],[1.5,[0,0,50],[1,0,0,0],0,0,0]]";
+
+  // Nested records, with both the legacy structs and the schema generated records.
+  RobTarget legacy_rob_target;
+  checkRoundTrip(legacy_rob_target, rob_target, p_failures);
+  ToolData legacy_tool_data;
+  checkRoundTrip(legacy_tool_data, tool_data, p_failures);
+
+  RAPIDTypedRecord<rapid::RobTarget> typed_rob_target;
+  checkRoundTrip(typed_rob_target, rob_target, p_failures);
+  check(typed_rob_target.value.pos.z == 712.5f && typed_rob_target.value.robconf.cf4 == -1.0f &&
+        typed_rob_target.value.extax.eax_f == 9E+09f, "round trip: wrong robtarget components", p_failures);
+
+  RAPIDTypedRecord<rapid::ToolData> typed_tool_data;
+  checkRoundTrip(typed_tool_data, tool_data, p_failures);
+  check(typed_tool_data.value.robhold && typed_tool_data.value.tframe.pos.z == 100.0f &&
+        typed_tool_data.value.tload.mass == 1.5f, "round trip: wrong tooldata components", p_failures);
+
+  // Unconnected external axes (9E+09), as num and dnum.
+  RAPIDNum num;
+  checkRoundTrip(num, "9E+09", p_failures);
+  check(num.value == 9E+09f, "round trip: wrong num value of 9E+09", p_failures);
+  RAPIDDnum dnum;
+  checkRoundTrip(dnum, "9E+09", p_failures);
+  check(dnum.value == 9E+09, "round trip: wrong dnum value of 9E+09", p_failures);
+
+  // Quoted strings are kept in RAPID syntax, i.e. an embedded quote stays doubled (""), and delimiters inside the
+  // quotes don't split the value.
+  RAPIDString string;
+  checkRoundTrip(string, "\"say \"\"hi\"\", [ok]\"", p_failures);
+  check(string.value == "say \"\"hi\"\", [ok]", "round trip: wrong string value " + string.value, p_failures);
+
+  RAPIDArray<std::string> strings(0, "string");
+  checkRoundTrip(strings, "[\"a\"\",b]\",\"\"\"\",\"\"]", p_failures);
+  check(strings.size() == 3 && strings.get(0) == "a\"\",b]" && strings.get(1) == "\"\"" && strings.get(2).empty(),
+        "round trip: wrong string array elements", p_failures);
+
+  // Whitespace is skipped.
+  RAPIDArray<float> nums(0, "num");
+  RAPIDParser parser(" [ 1 , -2.5 ,3E-02 ] ");
+  check(parser.parse(nums) && nums.size() == 3 && nums.get(1) == -2.5f && nums.get(2) == 3E-02f,
+        "round trip: whitespace wasn't skipped", p_failures);
+
+  RAPIDArray<rapid::Pos> positions(0, "pos");
+  checkRoundTrip(positions, "[[1,2,3],[4,5,6]]", p_failures);
+  checkRoundTrip(positions, "[]", p_failures);
+}
+
+/**
+ * \brief A function for testing parse errors, i.e. their positions, and that the data is left untouched.
+ *
+ * \param p_failures for counting the failed checks.
+ */
+static void testParseErrors(int* p_failures)
+{
+  RobTarget legacy_rob_target;
+  legacy_rob_target.parseString("[[1,2,3],[1,0,0,0],[0,0,0,0],[9E+09,9E+09,9E+09,9E+09,9E+09,9E+09]]");
+  checkParseError(legacy_rob_target, "[[1,2,x],[1,0,0,0],[0,0,0,0],[0,0,0,0,0,0]]", 6, p_failures);
+
+  RAPIDTypedRecord<rapid::RobTarget> typed_rob_target;
+  typed_rob_target.value.pos.x = 42.0f;
+  checkParseError(typed_rob_target, "[[1,2,3],[1,0,0,0],[0,0,0],[0,0,0,0,0,0]]", 25, p_failures);
+  checkParseError(typed_rob_target, "[[1,2,3],[1,0,0,0],[0,0,0,0],[0,0,0,0,0,0]] x", 44, p_failures);
+  checkParseError(typed_rob_target, "[[1,2,3],[1,0,0,0],[0,0,0,0],[0,0,0,0,0,0]", 42, p_failures);
+
+  RAPIDNum num(7.0f);
+  checkParseError(num, "1,2", 1, p_failures);
+  checkParseError(num, "", 0, p_failures);
+
+  RAPIDBool flag(true);
+  checkParseError(flag, "maybe", 0, p_failures);
+
+  RAPIDString string("kept");
+  checkParseError(string, "\"unterminated", 0, p_failures);
+
+  // Both the bulk numeric path and the per-element path must keep the array on failure.
+  RAPIDArray<float> nums(0, "num");
+  nums.parseString("[1,2,3]");
+  checkParseError(nums, "[1,2,x]", 5, p_failures);
+  checkParseError(nums, "[1,[2],3]", 3, p_failures);
+
+  RAPIDArray<rapid::Pos> positions(0, "pos");
+  positions.parseString("[[1,2,3]]");
+  checkParseError(positions, "[[1,2,3],[4,5]]", 13, p_failures);
+
+  // Element ranges are all or nothing.
+  size_t failed_index = 0;
+  std::vector<std::string_view> values = {"4", "5", "x"};
+  check(!nums.parseElements(2, values, &failed_index) && failed_index == 4 && nums.constructString() == "[1,2,3]",
+        "error: parseElements(...) changed the array, or reported a wrong element", p_failures);
+  values.back() = "6";
+  check(nums.parseElements(2, values, &failed_index) && nums.constructString() == "[1,2,4,5,6]",
+        "error: parseElements(...) didn't grow the array", p_failures);
+}
+
+/**
+ * \brief A function for testing that all delimiter kernels parse numeric arrays the same way.
+ *
+ * \param p_failures for counting the failed checks.
+ */
+static void testDelimiterKernels(int* p_failures)
+{
+  // Enough elements, with varying lengths, for delimiters to fall on every position of the 32 character blocks.
+  RAPIDArray<float> sample(0, "num");
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    float value = (i % 7 == 0 ? 9E+09f : 0.5f * float(i * 7919 % 10007) - 2500.0f);
+    sample.set(i, &value, 1);
+  }
+  const std::string value = sample.constructString();
+
+  const RAPIDParser::DelimiterKernel kernels[] = {RAPIDParser::SCALAR, RAPIDParser::SSE2, RAPIDParser::AVX2};
+  const char* names[] = {"scalar", "SSE2", "AVX2"};
+
+  check(RAPIDParser::setDelimiterKernel(RAPIDParser::SCALAR), "kernels: the scalar kernel isn't supported", p_failures);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (!RAPIDParser::setDelimiterKernel(kernels[i]))
+    {
+      std::cout << "Skipping the " << names[i] << " kernel (not supported by the build or the CPU)" << std::endl;
+      continue;
+    }
+
+    RAPIDArray<float> nums(0, "num");
+    RAPIDParser parser(value);
+    check(parser.parse(nums) && nums.getElements() == sample.getElements(),
+          std::string("kernels: the ") + names[i] + " kernel parsed a wrong array", p_failures);
+
+    // A malformed element near the end is reported at its position, and the array is kept.
+    RAPIDArray<double> dnums(0, "dnum");
+    dnums.parseString("[1,2,3]");
+    const std::string malformed = value.substr(0, value.size() - 1) + ",x]";
+    RAPIDParser malformed_parser(malformed);
+    check(!dnums.tryParse(malformed_parser) && malformed_parser.getErrorPosition() == value.size() &&
+          dnums.constructString() == "[1,2,3]",
+          std::string("kernels: the ") + names[i] + " kernel mishandled a malformed array", p_failures);
+  }
+
+  RAPIDParser::setDelimiterKernel(RAPIDParser::AUTOMATIC);
+}
+
+/**
+ * \brief A function for creating the descriptor of a RAPID pose.
+ *
+ * \return std::shared_ptr<const RAPIDTypeDescriptor> containing the descriptor.
+ */
+static std::shared_ptr<const RAPIDTypeDescriptor> createPoseDescriptor()
+{
+  std::shared_ptr<const RAPIDTypeDescriptor> p_num = RAPIDTypeDescriptor::getBuiltIn("num");
+
+  std::shared_ptr<RAPIDTypeDescriptor> p_pos(new RAPIDTypeDescriptor("pos", RAPIDTypeDescriptor::KIND_RECORD));
+  p_pos->addComponent("x", p_num);
+  p_pos->addComponent("y", p_num);
+  p_pos->addComponent("z", p_num);
+
+  std::shared_ptr<RAPIDTypeDescriptor> p_orient(new RAPIDTypeDescriptor("orient", RAPIDTypeDescriptor::KIND_RECORD));
+  p_orient->addComponent("q1", p_num);
+  p_orient->addComponent("q2", p_num);
+  p_orient->addComponent("q3", p_num);
+  p_orient->addComponent("q4", p_num);
+
+  std::shared_ptr<RAPIDTypeDescriptor> p_pose(new RAPIDTypeDescriptor("pose", RAPIDTypeDescriptor::KIND_RECORD));
+  p_pose->addComponent("trans", p_pos);
+  p_pose->addComponent("rot", p_orient);
+
+  return p_pose;
+}
+
+/**
+ * \brief A function for testing dynamic RAPID values.
+ *
+ * \param p_failures for counting the failed checks.
+ */
+static void testRAPIDValue(int* p_failures)
+{
+  const std::string poses = "[[[[1,2,3],[1,0,0,0]],[[4,5,6],[1,0,0,0]]],[[[7,8,9],[1,0,0,0]],[[10,11,12],[0,1,0,0]]]]";
+
+  RAPIDValue value(createPoseDescriptor(), 2);
+  checkRoundTrip(value, poses, p_failures);
+  check(value[1][0]["trans"]["x"].asNumber() == 7.0 && value[1][1]["rot"]["q2"].asNumber() == 1.0,
+        "value: wrong components of a two-dimensional pose array", p_failures);
+
+  check(value[1][0]["trans"]["x"].setNumber(9E+09), "value: setNumber(...) failed", p_failures);
+  check(value.constructString() ==
+        "[[[[1,2,3],[1,0,0,0]],[[4,5,6],[1,0,0,0]]],[[[9E+09,8,9],[1,0,0,0]],[[10,11,12],[0,1,0,0]]]]",
+        "value: wrong value string after setNumber(...): " + value.constructString(), p_failures);
+
+  // Malformed input (here, a pose array with a missing dimension) leaves the value untouched.
+  checkParseError(value, "[[[1,2,3],[1,0,0,0]],[[4,5,6],[1,0,0,0]]]", 3, p_failures);
+
+  std::shared_ptr<RAPIDTypeDescriptor> p_record(new RAPIDTypeDescriptor("rec", RAPIDTypeDescriptor::KIND_RECORD));
+  p_record->addComponent("text", RAPIDTypeDescriptor::getBuiltIn("string"));
+  p_record->addComponent("flag", RAPIDTypeDescriptor::getBuiltIn("bool"));
+
+  RAPIDValue record(p_record);
+  checkRoundTrip(record, "[\"a \"\"quoted\"\", text\",TRUE]", p_failures);
+  check(record["text"].asString() == "a \"\"quoted\"\", text" && record["flag"].asBool(),
+        "value: wrong components of a record with a quoted string", p_failures);
+}
+
+/**
+ * \brief A function for testing the change tracking, and the addressing of the changed components.
+ *
+ * \param p_failures for counting the failed checks.
+ */
+static void testSnapshot(int* p_failures)
+{
+  const std::string poses = "[[[[1,2,3],[1,0,0,0]],[[4,5,6],[1,0,0,0]]],[[[7,8,9],[1,0,0,0]],[[10,11,12],[0,1,0,0]]]]";
+  std::shared_ptr<const RAPIDTypeDescriptor> p_pose = createPoseDescriptor();
+
+  RWSClient::RAPIDSymbolMetadata metadata;
+  metadata.data_type = "pose";
+  metadata.number_of_dimensions = 2;
+
+  RAPIDValue value(p_pose, 2);
+  value.parseString(poses);
+
+  RAPIDSnapshot snapshot;
+  std::vector<RAPIDSnapshot::Change> changes;
+  check(snapshot.findChanges(poses, &changes) && changes.size() == 1 && changes[0].path.empty(),
+        "snapshot: an empty snapshot didn't give one complete change", p_failures);
+
+  snapshot.take(value);
+  changes.clear();
+  check(!snapshot.findChanges(value.constructString(), &changes) && changes.empty(),
+        "snapshot: an unchanged value gave changes", p_failures);
+
+  // A single number, i.e. "poses{2,1}.trans.x".
+  value[1][0]["trans"]["x"].setNumber(-7.5);
+  changes.clear();
+  std::string name;
+
+  if (check(snapshot.findChanges(value.constructString(), &changes) && changes.size() == 1,
+            "snapshot: a changed component wasn't found", p_failures))
+  {
+    check(changes[0].path == std::vector<size_t>({1, 0, 0, 0}) && changes[0].value == "-7.5",
+          "snapshot: wrong change of poses{2,1}.trans.x", p_failures);
+    check(RWSClient::getRAPIDComponentName("poses", metadata, *p_pose, changes[0].path, &name) &&
+          name == "poses{2,1}.trans.x", "snapshot: wrong component name " + name, p_failures);
+  }
+
+  // A record with all its components changed is one change, i.e. "poses{1,2}.trans".
+  snapshot.take(value);
+  value[0][1]["trans"]["x"].setNumber(40);
+  value[0][1]["trans"]["y"].setNumber(50);
+  value[0][1]["trans"]["z"].setNumber(60);
+  changes.clear();
+
+  if (check(snapshot.findChanges(value.constructString(), &changes) && changes.size() == 1,
+            "snapshot: wrong number of changes", p_failures))
+  {
+    check(changes[0].path == std::vector<size_t>({0, 1, 0}) && changes[0].value == "[40,50,60]",
+          "snapshot: wrong change of poses{1,2}.trans", p_failures);
+    check(RWSClient::getRAPIDComponentName("poses", metadata, *p_pose, changes[0].path, &name) &&
+          name == "poses{1,2}.trans", "snapshot: wrong component name " + name, p_failures);
+  }
+
+  // So is an array with all its elements (here, both rows) changed, which is then the complete value.
+  snapshot.take(value);
+  value[0][0]["rot"]["q4"].setNumber(0.5);
+  value[1][1]["rot"]["q4"].setNumber(0.5);
+  changes.clear();
+  check(snapshot.findChanges(value.constructString(), &changes) && changes.size() == 1 && changes[0].path.empty() &&
+        changes[0].value == value.constructString(), "snapshot: changed rows didn't give one complete change",
+        p_failures);
+
+  // A row of a two-dimensional array can't be addressed on its own, and neither can a component of a number.
+  check(!RWSClient::getRAPIDComponentName("poses", metadata, *p_pose, std::vector<size_t>({1}), &name),
+        "snapshot: a partial array index was addressed", p_failures);
+  check(!RWSClient::getRAPIDComponentName("poses", metadata, *p_pose, std::vector<size_t>({1, 0, 0, 0, 0}), &name),
+        "snapshot: a component of a number was addressed", p_failures);
+
+  // A changed structure gives one complete change.
+  changes.clear();
+  check(snapshot.findChanges("[[[[1,2,3],[1,0,0,0]]]]", &changes) && changes.size() == 1 && changes[0].path.empty(),
+        "snapshot: a changed structure didn't give one complete change", p_failures);
+
+  // Quoted strings, with delimiters and doubled quotes, are compared as whole components.
+  RAPIDArray<std::string> strings(0, "string");
+  strings.parseString("[\"a,\"\"b\",\"c\"]");
+  snapshot.take(strings);
+  strings.set(1, "c]\"\"");
+  changes.clear();
+  check(snapshot.findChanges(strings.constructString(), &changes) && changes.size() == 1 &&
+        changes[0].path == std::vector<size_t>({1}) && changes[0].value == "\"c]\"\"\"",
+        "snapshot: wrong change of a string array element", p_failures);
+}
+
+} // end namespace rws
+} // end namespace abb
+
+/**
+ * \brief Unit tests of the RAPID data parsing, serialization and change tracking.
+ *
+ * \return int zero if all checks passed.
+ */
+int main()
+{
+  using namespace abb::rws;
+
+  int failures = 0;
+
+  testRoundTrips(&failures);
+  testParseErrors(&failures);
+  testDelimiterKernels(&failures);
+  testRAPIDValue(&failures);
+  testSnapshot(&failures);
+
+  std::cout << (failures == 0 ? "PASSED" : "FAILED") << " (" << failures << " failures)" << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Shared setup (simulator, TLS context) and assertion helpers for the tests.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_TEST_ENVIRONMENT_H
+#define RWS_TEST_ENVIRONMENT_H
+
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "Poco/Exception.h"
+#include "Poco/Net/Context.h"
+
+#include "rws_simulator.h"
+#include "test_check.h"
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Struct definitions: TestEnvironment
+ */
+
+/**
+ * \brief A struct for the tests' environment, i.e. a simulated controller on the loopback interface.
+ *
+ * The simulator serves HTTPS (the library's clients only speak HTTPS), with the certificate and key given by the
+ * ABB_LIBRWS_TEST_CERT and ABB_LIBRWS_TEST_KEY environment variables, or a self-signed pair generated with openssl.
+ */
+struct TestEnvironment
+{
+  /**
+   * \brief A constructor, which starts the simulator.
+   */
+  TestEnvironment()
+  {
+    RWSSimulator::Options options;
+    const char* certificate = std::getenv("ABB_LIBRWS_TEST_CERT");
+    const char* key = std::getenv("ABB_LIBRWS_TEST_KEY");
+
+    if (certificate && key)
+    {
+      options.certificate_file = certificate;
+      options.private_key_file = key;
+    }
+    else
+    {
+      std::filesystem::path directory = std::filesystem::temp_directory_path();
+      options.certificate_file = (directory / "abb_librws_test_cert.pem").string();
+      options.private_key_file = (directory / "abb_librws_test_key.pem").string();
+
+      std::string command = "openssl req -x509 -newkey rsa:2048 -nodes -subj /CN=localhost -days 1"
+                            " -keyout \"" + options.private_key_file + "\" -out \"" + options.certificate_file + "\"" +
+                            " > " + (directory / "abb_librws_test_openssl.log").string() + " 2>&1";
+
+      if (std::system(command.c_str()) != 0)
+      {
+        error = "failed to generate a certificate (set ABB_LIBRWS_TEST_CERT and ABB_LIBRWS_TEST_KEY)";
+        return;
+      }
+    }
+
+    try
+    {
+      p_simulator.reset(new RWSSimulator(options));
+      p_simulator->start();
+      p_context = new Poco::Net::Context(Poco::Net::Context::CLIENT_USE, "", "", "", Poco::Net::Context::VERIFY_NONE);
+    }
+    catch (const Poco::Exception& e)
+    {
+      error = "failed to start the simulator: " + e.displayText();
+    }
+  }
+
+  /**
+   * \brief The simulated controller.
+   */
+  std::unique_ptr<RWSSimulator> p_simulator;
+
+  /**
+   * \brief The clients' SSL context (the simulator's certificate is self-signed, so it is not verified).
+   */
+  Poco::Net::Context::Ptr p_context;
+
+  /**
+   * \brief Container for an error message (empty if the environment is ready).
+   */
+  std::string error;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
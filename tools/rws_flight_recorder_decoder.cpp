@@ -0,0 +1,105 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Command line tool that prints a flight recorder dump in readable form.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "Poco/Exception.h"
+
+#include "abb_librws/rws_flight_recorder.h"
+
+/**
+ * \brief A tool for printing the records of a flight recorder file (see abb::rws::RWSFlightRecorder).
+ *
+ * Usage: rws_flight_recorder_decoder [-v] <file>
+ *
+ * The records are printed the oldest first, in the same format as the RWS client's log text. With -v, the captured
+ * response content is printed as well.
+ */
+int main(int argc, char** argv)
+{
+  bool verbose = false;
+  const char* path = 0;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "-v") == 0)
+    {
+      verbose = true;
+    }
+    else
+    {
+      path = argv[i];
+    }
+  }
+
+  if (!path)
+  {
+    std::cerr << "Usage: " << argv[0] << " [-v] <file>" << std::endl;
+    return 1;
+  }
+
+  try
+  {
+    std::vector<abb::rws::RWSFlightRecorder::Entry> entries = abb::rws::RWSFlightRecorder::read(path);
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+      std::stringstream prefix;
+      prefix << entries[i].sequence << ". ";
+      std::cout << prefix.str()
+                << abb::rws::RWSRequestLog::formatRecord(entries[i].record,
+                                                         entries[i].capture.data(),
+                                                         verbose,
+                                                         prefix.str().size())
+                << std::endl;
+    }
+  }
+  catch (const Poco::Exception& e)
+  {
+    std::cerr << "Failed to read '" << path << "': " << e.displayText() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,996 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: An in-process HTTPS server that simulates a subset of Robot Web Services, for tests and benchmarks.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "Poco/DigestEngine.h"
+#include "Poco/Exception.h"
+#include "Poco/MD5Engine.h"
+#include "Poco/Net/Context.h"
+#include "Poco/Net/HTTPAuthenticationParams.h"
+#include "Poco/Net/HTTPCookie.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPServerRequestImpl.h"
+#include "Poco/Net/NameValueCollection.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Net/SecureServerSocket.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/WebSocket.h"
+#include "Poco/StreamCopier.h"
+
+#include "rws_simulator.h"
+
+using namespace Poco::Net;
+
+namespace abb
+{
+namespace rws
+{
+/***********************************************************************************************************************
+ * Function definitions
+ */
+
+/**
+ * \brief A function for checking if a string starts with a prefix.
+ *
+ * \param s for the string.
+ * \param prefix for the prefix.
+ *
+ * \return bool indicating if the string starts with the prefix.
+ */
+static bool startsWith(const std::string& s, const std::string& prefix)
+{
+  return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+/**
+ * \brief A function for checking if a string ends with a suffix.
+ *
+ * \param s for the string.
+ * \param suffix for the suffix.
+ *
+ * \return bool indicating if the string ends with the suffix.
+ */
+static bool endsWith(const std::string& s, const std::string& suffix)
+{
+  return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * \brief A function for splitting a string by a delimiter.
+ *
+ * \param s for the string.
+ * \param delimiter for the delimiter.
+ *
+ * \return std::vector<std::string> containing the parts.
+ */
+static std::vector<std::string> split(const std::string& s, const char delimiter)
+{
+  std::vector<std::string> result;
+  std::stringstream ss(s);
+  std::string part;
+
+  while (std::getline(ss, part, delimiter))
+  {
+    result.push_back(part);
+  }
+
+  return result;
+}
+
+/**
+ * \brief A function for parsing form encoded content (e.g. "lvalue=1&mode=x").
+ *
+ * Note: The library sends the values as they are (i.e. not percent-encoded), so they aren't decoded.
+ *
+ * \param content for the content.
+ *
+ * \return std::map<std::string, std::string> containing the fields (the last occurrence of a repeated field).
+ */
+static std::map<std::string, std::string> parseForm(const std::string& content)
+{
+  std::map<std::string, std::string> result;
+  std::vector<std::string> fields = split(content, '&');
+
+  for (size_t i = 0; i < fields.size(); ++i)
+  {
+    size_t position = fields[i].find('=');
+
+    if (position != std::string::npos)
+    {
+      result[fields[i].substr(0, position)] = fields[i].substr(position + 1);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * \brief A function for escaping XML text.
+ *
+ * \param text for the text.
+ *
+ * \return std::string containing the escaped text.
+ */
+static std::string escapeXML(const std::string& text)
+{
+  std::string result;
+  result.reserve(text.size());
+
+  for (size_t i = 0; i < text.size(); ++i)
+  {
+    switch (text[i])
+    {
+      case '<':
+        result += "&lt;";
+      break;
+
+      case '>':
+        result += "&gt;";
+      break;
+
+      case '&':
+        result += "&amp;";
+      break;
+
+      default:
+        result += text[i];
+      break;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * \brief A function for creating a XML span element (i.e. a RWS value).
+ *
+ * \param xml_class for the element's class.
+ * \param value for the element's value.
+ *
+ * \return std::string containing the element.
+ */
+static std::string span(const std::string& xml_class, const std::string& value)
+{
+  return "<span class=\"" + xml_class + "\">" + escapeXML(value) + "</span>";
+}
+
+/**
+ * \brief A function for creating a XML list item (i.e. a RWS resource).
+ *
+ * \param xml_class for the item's class.
+ * \param title for the item's title.
+ * \param content for the item's content.
+ *
+ * \return std::string containing the item.
+ */
+static std::string item(const std::string& xml_class, const std::string& title, const std::string& content)
+{
+  return "<li class=\"" + xml_class + "\" title=\"" + escapeXML(title) + "\">" + content + "</li>";
+}
+
+/**
+ * \brief A function for creating a RWS (XHTML) document.
+ *
+ * \param items for the document's list items.
+ *
+ * \return std::string containing the document.
+ */
+static std::string document(const std::string& items)
+{
+  return "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+         "<html xmlns=\"http://www.w3.org/1999/xhtml\"><head><title>RWS Simulator</title></head>"
+         "<body><div class=\"state\"><ul>" + items + "</ul></div></body></html>";
+}
+
+/**
+ * \brief A function for computing the MD5 hash of a string.
+ *
+ * \param s for the string.
+ *
+ * \return std::string containing the hash (in hexadecimal).
+ */
+static std::string md5(const std::string& s)
+{
+  Poco::MD5Engine engine;
+  engine.update(s);
+  return Poco::DigestEngine::digestToHex(engine.digest());
+}
+
+/***********************************************************************************************************************
+ * Class definitions: RWSSimulator::RequestHandler
+ */
+
+/**
+ * \brief A class for handling the server's requests (by forwarding them to the simulator).
+ */
+class RWSSimulator::RequestHandler : public HTTPRequestHandler
+{
+public:
+  /**
+   * \brief A constructor.
+   *
+   * \param simulator for the simulator.
+   */
+  RequestHandler(RWSSimulator& simulator) : simulator_(simulator) {}
+
+  /**
+   * \brief A method for handling a request.
+   *
+   * \param request for the request.
+   * \param response for the response.
+   */
+  void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+  {
+    simulator_.handleRequest(request, response);
+  }
+
+private:
+  /**
+   * \brief The simulator.
+   */
+  RWSSimulator& simulator_;
+};
+
+/***********************************************************************************************************************
+ * Class definitions: RWSSimulator::RequestHandlerFactory
+ */
+
+/**
+ * \brief A class for creating the server's request handlers.
+ */
+class RWSSimulator::RequestHandlerFactory : public HTTPRequestHandlerFactory
+{
+public:
+  /**
+   * \brief A constructor.
+   *
+   * \param simulator for the simulator.
+   */
+  RequestHandlerFactory(RWSSimulator& simulator) : simulator_(simulator) {}
+
+  /**
+   * \brief A method for creating a request handler (the same kind for every request).
+   *
+   * \return HTTPRequestHandler* for the request handler.
+   */
+  HTTPRequestHandler* createRequestHandler(const HTTPServerRequest&)
+  {
+    return new RequestHandler(simulator_);
+  }
+
+private:
+  /**
+   * \brief The simulator.
+   */
+  RWSSimulator& simulator_;
+};
+
+/***********************************************************************************************************************
+ * Class definitions: RWSSimulator
+ */
+
+/************************************************************
+ * Static constants
+ */
+
+const char* const RWSSimulator::REALM = "validusers@robapi.abb";
+const char* const RWSSimulator::SESSION_COOKIE = "-http-session-";
+
+/************************************************************
+ * Primary methods
+ */
+
+RWSSimulator::RWSSimulator(const Options& options)
+:
+options_(options),
+port_(0),
+thread_pool_(2, options.max_threads),
+faults_(options.faults),
+random_generator_(options.seed),
+request_count_(0),
+stopping_(false),
+next_id_(1),
+controller_state_("motoroff"),
+operation_mode_("AUTO"),
+rapid_execution_("stopped"),
+mastership_(false)
+{
+  rapid_tasks_["T_ROB1"] = true;
+}
+
+RWSSimulator::~RWSSimulator()
+{
+  stop();
+}
+
+void RWSSimulator::start()
+{
+  if (p_server_)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    stopping_ = false;
+  }
+
+  SocketAddress address(options_.address, options_.port);
+  ServerSocket socket;
+
+  if (!options_.certificate_file.empty())
+  {
+    Context::Ptr p_context = new Context(Context::SERVER_USE,
+                                         options_.private_key_file,
+                                         options_.certificate_file,
+                                         "",
+                                         Context::VERIFY_NONE);
+    socket = SecureServerSocket(address, 64, p_context);
+  }
+  else
+  {
+    socket = ServerSocket(address);
+  }
+
+  HTTPServerParams::Ptr p_params = new HTTPServerParams();
+  p_params->setMaxThreads(options_.max_threads);
+  p_params->setKeepAlive(true);
+
+  port_ = socket.address().port();
+  p_server_.reset(new HTTPServer(new RequestHandlerFactory(*this), thread_pool_, socket, p_params));
+  p_server_->start();
+}
+
+void RWSSimulator::stop()
+{
+  if (p_server_)
+  {
+    {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      stopping_ = true;
+    }
+    state_condition_.notify_all();
+
+    p_server_->stopAll(true);
+    p_server_.reset();
+    port_ = 0;
+  }
+}
+
+void RWSSimulator::setFaults(const Faults& faults)
+{
+  std::lock_guard<std::mutex> lock(faults_mutex_);
+  faults_ = faults;
+}
+
+void RWSSimulator::setIOSignal(const std::string& iosignal, const std::string& value)
+{
+  std::lock_guard<std::mutex> lock(state_mutex_);
+
+  iosignals_[iosignal] = value;
+  notify("/rw/iosystem/signals/" + iosignal + ";state",
+         item("ios-signalstate-ev", iosignal,
+              "<a href=\"/rw/iosystem/signals/" + iosignal + ";state\" rel=\"self\"></a>" + span("lvalue", value)));
+}
+
+std::string RWSSimulator::getIOSignal(const std::string& iosignal)
+{
+  std::lock_guard<std::mutex> lock(state_mutex_);
+
+  std::map<std::string, std::string>::iterator it = iosignals_.find(iosignal);
+  if (it == iosignals_.end())
+  {
+    it = iosignals_.insert(std::make_pair(iosignal, "0")).first;
+  }
+
+  return it->second;
+}
+
+void RWSSimulator::setRAPIDSymbol(const std::string& task,
+                                  const std::string& module,
+                                  const std::string& name,
+                                  const std::string& value,
+                                  const std::string& data_type)
+{
+  std::lock_guard<std::mutex> lock(state_mutex_);
+
+  RAPIDSymbol& symbol = findRAPIDSymbol(task, module, name);
+  symbol.value = value;
+  symbol.data_type = data_type;
+
+  std::string resource = "/rw/rapid/symbol/RAPID/" + task + "/" + module + "/" + name + ";value";
+  notify(resource, item("rap-value-ev", name, "<a href=\"" + resource + "\" rel=\"self\"></a>" + span("value", value)));
+}
+
+std::string RWSSimulator::getRAPIDSymbol(const std::string& task, const std::string& module, const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  return findRAPIDSymbol(task, module, name).value;
+}
+
+Poco::UInt64 RWSSimulator::getRequestCount()
+{
+  std::lock_guard<std::mutex> lock(faults_mutex_);
+  return request_count_;
+}
+
+/************************************************************
+ * Auxiliary methods
+ */
+
+void RWSSimulator::handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+{
+  if (injectFaults(request, response))
+  {
+    return;
+  }
+
+  if (options_.authentication && !authenticate(request, response))
+  {
+    return;
+  }
+
+  std::string path = request.getURI().substr(0, request.getURI().find('?'));
+
+  if (startsWith(path, "/poll/") && request.get("Upgrade", "") == "websocket")
+  {
+    pollSubscription(path.substr(std::string("/poll/").size()), request, response);
+    return;
+  }
+
+  std::string content;
+  Poco::StreamCopier::copyToString(request.stream(), content);
+
+  std::string body = route(request.getMethod(), path, parseForm(content), content, request.getHost(), response);
+
+  response.sendBuffer(body.data(), body.size());
+}
+
+bool RWSSimulator::authenticate(HTTPServerRequest& request, HTTPServerResponse& response)
+{
+  NameValueCollection cookies;
+  request.getCookies(cookies);
+
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+
+    if (cookies.has(SESSION_COOKIE) && sessions_.count(cookies.get(SESSION_COOKIE)) > 0)
+    {
+      return true;
+    }
+  }
+
+  if (request.has(HTTPRequest::AUTHORIZATION))
+  {
+    try
+    {
+      HTTPAuthenticationParams params(request);
+
+      std::string ha1 = md5(options_.username + ":" + REALM + ":" + options_.password);
+      std::string ha2 = md5(request.getMethod() + ":" + params.get("uri", ""));
+      std::string expected = (params.get("qop", "").empty() ?
+                              md5(ha1 + ":" + params.get("nonce", "") + ":" + ha2) :
+                              md5(ha1 + ":" + params.get("nonce", "") + ":" + params.get("nc", "") + ":" +
+                                  params.get("cnonce", "") + ":" + params.get("qop", "") + ":" + ha2));
+
+      if (params.get("username", "") == options_.username && params.get("response", "") == expected)
+      {
+        std::string session;
+        {
+          std::lock_guard<std::mutex> lock(state_mutex_);
+          session = md5(std::to_string(next_id_++) + REALM);
+          sessions_.insert(session);
+        }
+
+        HTTPCookie session_cookie(SESSION_COOKIE, session);
+        session_cookie.setPath("/");
+        response.addCookie(session_cookie);
+
+        HTTPCookie abbcx_cookie("ABBCX", session.substr(0, 8));
+        abbcx_cookie.setPath("/");
+        response.addCookie(abbcx_cookie);
+
+        return true;
+      }
+    }
+    catch (const Poco::Exception&)
+    {
+      // Malformed credentials are rejected below.
+    }
+  }
+
+  std::string nonce;
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    nonce = md5(std::to_string(next_id_++) + ":nonce");
+  }
+
+  // Discard the content, so that the connection can be kept alive.
+  std::string content;
+  Poco::StreamCopier::copyToString(request.stream(), content);
+
+  response.setStatusAndReason(HTTPResponse::HTTP_UNAUTHORIZED);
+  response.set("WWW-Authenticate", std::string("Digest realm=\"") + REALM + "\", qop=\"auth\", nonce=\"" + nonce + "\"");
+  response.setContentLength(0);
+  response.send();
+
+  return false;
+}
+
+bool RWSSimulator::injectFaults(HTTPServerRequest& request, HTTPServerResponse& response)
+{
+  Poco::Int64 delay = 0;
+  bool fail = false;
+  bool drop = false;
+
+  {
+    std::lock_guard<std::mutex> lock(faults_mutex_);
+
+    ++request_count_;
+
+    delay = faults_.latency;
+    if (faults_.jitter > 0)
+    {
+      delay += std::uniform_int_distribution<Poco::Int64>(-faults_.jitter, faults_.jitter)(random_generator_);
+    }
+
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    drop = (faults_.drop_rate > 0.0 && distribution(random_generator_) < faults_.drop_rate);
+    fail = (!drop && faults_.failure_rate > 0.0 && distribution(random_generator_) < faults_.failure_rate);
+  }
+
+  if (delay > 0)
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds(delay));
+  }
+
+  if (drop)
+  {
+    // Close the connection without answering (the client sees a broken connection).
+    response.setKeepAlive(false);
+    static_cast<HTTPServerRequestImpl&>(request).socket().shutdown();
+  }
+  else if (fail)
+  {
+    std::string content;
+    Poco::StreamCopier::copyToString(request.stream(), content);
+
+    response.setStatusAndReason(HTTPResponse::HTTP_SERVICE_UNAVAILABLE);
+    response.setContentLength(0);
+    response.send();
+  }
+
+  return drop || fail;
+}
+
+std::string RWSSimulator::route(const std::string& method,
+                                const std::string& path,
+                                const std::map<std::string, std::string>& form,
+                                const std::string& content,
+                                const std::string& host,
+                                HTTPServerResponse& response)
+{
+  const std::string SIGNALS = "/rw/iosystem/signals/";
+  const std::string MECHUNITS = "/rw/motionsystem/mechunits/";
+  const std::string SYMBOLS = "/rw/rapid/symbol/RAPID/";
+  const std::string TASKS = "/rw/rapid/tasks";
+  const std::string FILESERVICE = "/fileservice/";
+  const std::string SUBSCRIPTION = "/subscription";
+
+  std::map<std::string, std::string>::const_iterator field;
+  std::string items;
+
+  std::unique_lock<std::mutex> lock(state_mutex_);
+
+  response.setContentType("application/xhtml+xml;v=2.0");
+  response.setStatusAndReason(HTTPResponse::HTTP_OK);
+
+  if (startsWith(path, SIGNALS) && method == HTTPRequest::HTTP_POST && endsWith(path, "/set-value") &&
+      (field = form.find("lvalue")) != form.end())
+  {
+    lock.unlock();
+    setIOSignal(path.substr(SIGNALS.size(), path.size() - SIGNALS.size() - std::string("/set-value").size()),
+                field->second);
+    response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+    return "";
+  }
+  else if (startsWith(path, SIGNALS) && method == HTTPRequest::HTTP_GET)
+  {
+    lock.unlock();
+    std::string name = path.substr(SIGNALS.size());
+    std::string value = getIOSignal(name);
+    return document(item("ios-signal-li", name,
+                         span("name", name) + span("type", "DO") + span("lvalue", value) +
+                         span("lstate", "not simulated")));
+  }
+  else if (startsWith(path, SYMBOLS))
+  {
+    std::vector<std::string> parts = split(path.substr(SYMBOLS.size()), '/');
+
+    if (parts.size() == 4 && method == HTTPRequest::HTTP_GET && parts[3] == "data")
+    {
+      return document(item("rap-data", parts[2], span("value", findRAPIDSymbol(parts[0], parts[1], parts[2]).value)));
+    }
+    else if (parts.size() == 4 && method == HTTPRequest::HTTP_GET && parts[3] == "properties")
+    {
+      const RAPIDSymbol& symbol = findRAPIDSymbol(parts[0], parts[1], parts[2]);
+      return document(item("rap-sympropvar-li", parts[2],
+                           span("symburl", "RAPID/" + parts[0] + "/" + parts[1] + "/" + parts[2]) +
+                           span("name", parts[2]) + span("symtyp", "per") + span("dattyp", symbol.data_type) +
+                           span("ndim", "0") + span("dim", "")));
+    }
+    else if (parts.size() == 4 && method == HTTPRequest::HTTP_POST && parts[3] == "data" &&
+             (field = form.find("value")) != form.end())
+    {
+      std::string data_type = findRAPIDSymbol(parts[0], parts[1], parts[2]).data_type;
+      lock.unlock();
+      setRAPIDSymbol(parts[0], parts[1], parts[2], field->second, data_type);
+      response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+      return "";
+    }
+  }
+  else if (startsWith(path, MECHUNITS) && method == HTTPRequest::HTTP_GET && endsWith(path, "/jointtarget"))
+  {
+    return document(item("ms-jointtarget", "jointtarget",
+                         span("rax_1", "0") + span("rax_2", "0") + span("rax_3", "0") + span("rax_4", "0") +
+                         span("rax_5", "30") + span("rax_6", "0") + span("eax_a", "9E+09") +
+                         span("eax_b", "9E+09") + span("eax_c", "9E+09") + span("eax_d", "9E+09") +
+                         span("eax_e", "9E+09") + span("eax_f", "9E+09")));
+  }
+  else if (startsWith(path, MECHUNITS) && method == HTTPRequest::HTTP_GET && endsWith(path, "/robtarget"))
+  {
+    return document(item("ms-robtargets", "robtarget",
+                         span("x", "515") + span("y", "0") + span("z", "712") + span("q1", "0.5") +
+                         span("q2", "0") + span("q3", "0.866025") + span("q4", "0") + span("cf1", "0") +
+                         span("cf4", "0") + span("cf6", "0") + span("cfx", "0") + span("eax_a", "9E+09") +
+                         span("eax_b", "9E+09") + span("eax_c", "9E+09") + span("eax_d", "9E+09") +
+                         span("eax_e", "9E+09") + span("eax_f", "9E+09")));
+  }
+  else if (startsWith(path, MECHUNITS) && method == HTTPRequest::HTTP_POST && endsWith(path, "/lead-through"))
+  {
+    response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+    return "";
+  }
+  else if (path == "/rw/panel/ctrl-state" && method == HTTPRequest::HTTP_GET)
+  {
+    return document(item("pnl-ctrlstate", "ctrlstate", span("ctrlstate", controller_state_)));
+  }
+  else if (path == "/rw/panel/ctrl-state" && method == HTTPRequest::HTTP_POST &&
+           (field = form.find("ctrl-state")) != form.end() &&
+           (field->second == "motoron" || field->second == "motoroff"))
+  {
+    controller_state_ = field->second;
+    response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+    return "";
+  }
+  else if (path == "/rw/panel/opmode" && method == HTTPRequest::HTTP_GET)
+  {
+    return document(item("pnl-opmode", "opmode", span("opmode", operation_mode_)));
+  }
+  else if (path == "/rw/rapid/execution" && method == HTTPRequest::HTTP_GET)
+  {
+    return document(item("rap-execution", "execution",
+                         span("ctrlexecstate", rapid_execution_) + span("cycle", "forever")));
+  }
+  else if (path == "/rw/rapid/execution/start" && method == HTTPRequest::HTTP_POST)
+  {
+    if (controller_state_ != "motoron")
+    {
+      response.setStatusAndReason(HTTPResponse::HTTP_BAD_REQUEST);
+      return document(item("status", "status", span("code", "-1073445865") + span("msg", "Motors are off")));
+    }
+
+    rapid_execution_ = "running";
+    response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+    return "";
+  }
+  else if ((path == "/rw/rapid/execution/stop" || path == "/rw/rapid/execution/resetpp") &&
+           method == HTTPRequest::HTTP_POST)
+  {
+    if (path == "/rw/rapid/execution/stop")
+    {
+      rapid_execution_ = "stopped";
+    }
+
+    response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+    return "";
+  }
+  else if (path == TASKS && method == HTTPRequest::HTTP_GET)
+  {
+    for (std::map<std::string, bool>::const_iterator it = rapid_tasks_.begin(); it != rapid_tasks_.end(); ++it)
+    {
+      items += item("rap-task-li", it->first,
+                    span("name", it->first) + span("type", "normal") + span("taskstate", "initiated") +
+                    span("excstate", (rapid_execution_ == "running" ? "started" : "stopped")) +
+                    span("active", "On") + span("motiontask", (it->second ? "TRUE" : "FALSE")));
+    }
+
+    return document(items);
+  }
+  else if (startsWith(path, TASKS + "/") && endsWith(path, "/modules") && method == HTTPRequest::HTTP_GET)
+  {
+    std::string task = path.substr(TASKS.size() + 1, path.size() - TASKS.size() - 1 - std::string("/modules").size());
+    std::set<std::string> modules;
+
+    for (std::map<std::string, RAPIDSymbol>::const_iterator it = rapid_symbols_.begin();
+         it != rapid_symbols_.end();
+         ++it)
+    {
+      if (startsWith(it->first, task + "/"))
+      {
+        modules.insert(split(it->first, '/').at(1));
+      }
+    }
+
+    items += item("rap-module-info-li", "BASE", span("name", "BASE") + span("type", "SysMod"));
+    items += item("rap-module-info-li", "user", span("name", "user") + span("type", "SysMod"));
+    for (std::set<std::string>::const_iterator it = modules.begin(); it != modules.end(); ++it)
+    {
+      items += item("rap-module-info-li", *it, span("name", *it) + span("type", "ProgMod"));
+    }
+
+    return document(items);
+  }
+  else if (path == "/rw/system" && method == HTTPRequest::HTTP_GET)
+  {
+    return document(item("sys-system-li", "system",
+                         span("major", "6") + span("minor", "8") + span("name", "RWS_Simulator") +
+                         span("rwversion", "6.08.0000") + span("rwversionname", "6.08.00.00")));
+  }
+  else if (path == "/rw/cfg/sys/present_options/instances" && method == HTTPRequest::HTTP_GET)
+  {
+    const char* const OPTIONS[][2] = {{"689-1", "Externally Guided Motion (EGM)"},
+                                      {"616-1", "PC Interface"},
+                                      {"623-1", "Multitasking"}};
+
+    for (size_t i = 0; i < sizeof(OPTIONS) / sizeof(OPTIONS[0]); ++i)
+    {
+      items += item("cfg-ia-t-li", "name", span("attribute", "name") + span("value", OPTIONS[i][0]));
+      items += item("cfg-ia-t-li", "desc", span("attribute", "desc") + span("value", OPTIONS[i][1]));
+    }
+
+    return document(items);
+  }
+  else if (startsWith(path, "/rw/cfg/") && endsWith(path, "/instances") && method == HTTPRequest::HTTP_GET)
+  {
+    return document("");
+  }
+  else if ((path == "/rw/mastership/edit/request" || path == "/rw/mastership/edit/release") &&
+           method == HTTPRequest::HTTP_POST)
+  {
+    mastership_ = (path == "/rw/mastership/edit/request");
+    response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+    return "";
+  }
+  else if (startsWith(path, FILESERVICE))
+  {
+    std::string file = path.substr(FILESERVICE.size());
+    std::map<std::string, std::string>::iterator it = files_.find(file);
+
+    if (method == HTTPRequest::HTTP_GET && it != files_.end())
+    {
+      response.setContentType("text/plain");
+      return it->second;
+    }
+    else if (method == HTTPRequest::HTTP_PUT)
+    {
+      response.setStatusAndReason(it == files_.end() ? HTTPResponse::HTTP_CREATED : HTTPResponse::HTTP_OK);
+      files_[file] = content;
+      return "";
+    }
+    else if (method == HTTPRequest::HTTP_DELETE && it != files_.end())
+    {
+      files_.erase(it);
+      response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+      return "";
+    }
+  }
+  else if (path == SUBSCRIPTION && method == HTTPRequest::HTTP_POST)
+  {
+    std::string id = std::to_string(next_id_++);
+    SubscriptionGroup& group = subscription_groups_[id];
+
+    // The resources are numbered fields (e.g. "0=/rw/iosystem/signals/DO1;state").
+    for (field = form.begin(); field != form.end(); ++field)
+    {
+      if (!field->first.empty() && field->first.find_first_not_of("0123456789") == std::string::npos)
+      {
+        group.resources.insert(field->second);
+      }
+    }
+
+    response.setStatusAndReason(HTTPResponse::HTTP_CREATED);
+    response.set("Location", "http://" + host + "/poll/" + id);
+    return "";
+  }
+  else if (startsWith(path, SUBSCRIPTION + "/") && method == HTTPRequest::HTTP_DELETE)
+  {
+    std::map<std::string, SubscriptionGroup>::iterator it =
+      subscription_groups_.find(path.substr(SUBSCRIPTION.size() + 1));
+
+    if (it != subscription_groups_.end())
+    {
+      it->second.ended = true;
+      state_condition_.notify_all();
+      return "";
+    }
+  }
+  else if (path == "/users" && method == HTTPRequest::HTTP_POST)
+  {
+    response.setStatusAndReason(HTTPResponse::HTTP_CREATED);
+    return "";
+  }
+  else if (path == "/logout" && method == HTTPRequest::HTTP_GET)
+  {
+    // The session ends with this request (the client's cookie is no longer accepted).
+    sessions_.clear();
+    return document(item("logout", "logout", span("status", "logged out")));
+  }
+
+  response.setStatusAndReason(HTTPResponse::HTTP_NOT_FOUND);
+  return document(item("status", "status", span("code", "-1073442815") + span("msg", "Resource not found")));
+}
+
+void RWSSimulator::pollSubscription(const std::string& id,
+                                    HTTPServerRequest& request,
+                                    HTTPServerResponse& response)
+{
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+
+    if (subscription_groups_.find(id) == subscription_groups_.end())
+    {
+      response.setStatusAndReason(HTTPResponse::HTTP_NOT_FOUND);
+      response.setContentLength(0);
+      response.send();
+      return;
+    }
+  }
+
+  try
+  {
+    response.set("Sec-WebSocket-Protocol", "rws_subscription");
+    WebSocket websocket(request, response);
+    std::vector<std::string> events;
+    bool ended = false;
+
+    while (!ended)
+    {
+      {
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        SubscriptionGroup& group = subscription_groups_[id];
+
+        state_condition_.wait_for(lock, std::chrono::milliseconds(500),
+                                  [&] { return stopping_ || group.ended || !group.events.empty(); });
+
+        events.assign(group.events.begin(), group.events.end());
+        group.events.clear();
+        ended = stopping_ || group.ended;
+
+        if (group.ended)
+        {
+          subscription_groups_.erase(id);
+        }
+      }
+
+      for (size_t i = 0; i < events.size(); ++i)
+      {
+        std::string frame = document(events[i]);
+        websocket.sendFrame(frame.data(), static_cast<int>(frame.size()), WebSocket::FRAME_TEXT);
+      }
+
+      // Answer pings, and detect clients that closed (or dropped) the connection.
+      if (!ended && websocket.poll(Poco::Timespan(0), Socket::SELECT_READ))
+      {
+        char buffer[1024];
+        int flags = 0;
+        int received = websocket.receiveFrame(buffer, sizeof(buffer), flags);
+
+        if (received <= 0 || (flags & WebSocket::FRAME_OP_BITMASK) == WebSocket::FRAME_OP_CLOSE)
+        {
+          break;
+        }
+        else if ((flags & WebSocket::FRAME_OP_BITMASK) == WebSocket::FRAME_OP_PING)
+        {
+          websocket.sendFrame(buffer, received, WebSocket::FRAME_FLAG_FIN | WebSocket::FRAME_OP_PONG);
+        }
+      }
+    }
+
+    websocket.shutdown();
+  }
+  catch (const Poco::Exception&)
+  {
+    // The connection was closed (or the upgrade failed), which ends the polling.
+  }
+
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  subscription_groups_.erase(id);
+}
+
+void RWSSimulator::notify(const std::string& resource, const std::string& event)
+{
+  bool notified = false;
+
+  for (std::map<std::string, SubscriptionGroup>::iterator it = subscription_groups_.begin();
+       it != subscription_groups_.end();
+       ++it)
+  {
+    if (it->second.resources.count(resource) > 0)
+    {
+      it->second.events.push_back(event);
+      notified = true;
+    }
+  }
+
+  if (notified)
+  {
+    state_condition_.notify_all();
+  }
+}
+
+RWSSimulator::RAPIDSymbol& RWSSimulator::findRAPIDSymbol(const std::string& task,
+                                                         const std::string& module,
+                                                         const std::string& name)
+{
+  std::map<std::string, RAPIDSymbol>::iterator it = rapid_symbols_.find(task + "/" + module + "/" + name);
+
+  if (it == rapid_symbols_.end())
+  {
+    RAPIDSymbol symbol;
+    symbol.value = "0";
+    symbol.data_type = "num";
+
+    it = rapid_symbols_.insert(std::make_pair(task + "/" + module + "/" + name, symbol)).first;
+    rapid_tasks_.insert(std::make_pair(task, false));
+  }
+
+  return it->second;
+}
+
+} // end namespace rws
+} // end namespace abb
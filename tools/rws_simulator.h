@@ -0,0 +1,534 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: An in-process HTTPS server that simulates a subset of Robot Web Services, for tests and benchmarks.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#ifndef RWS_SIMULATOR_H
+#define RWS_SIMULATOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Types.h"
+
+namespace abb
+{
+namespace rws
+{
+/**
+ * \brief A class for simulating (the subset of) a robot controller's Robot Web Services 2.0 that the library uses.
+ *
+ * The simulator is a local, in-process stand-in for a controller (or RobotStudio), for offline tests and benchmarks.
+ * It implements:
+ * - Digest authentication, and session cookies.
+ * - IO signals (read/write), RAPID symbol data and properties, and mechanical unit joint/robot targets.
+ * - The panel's controller state and operation mode, and RAPID execution (start/stop/reset program pointer).
+ * - The file service (get/upload/delete), users, mastership and logout.
+ * - Subscriptions (IO signal states and RAPID symbol values), with events pushed over WebSockets.
+ *
+ * IO signals and RAPID symbols that don't exist are created on first access (with the value "0"), so any RAPID
+ * program's variables can be used without configuration. Latency, jitter and failures can be injected, and changed
+ * while the simulator is running.
+ *
+ * The library's clients use HTTPS, so a certificate and a private key (e.g. self-signed) must be provided for them.
+ * Without a certificate, plain HTTP is served.
+ */
+class RWSSimulator
+{
+public:
+  /**
+   * \brief Static constant for the realm used by the digest authentication.
+   */
+  static const char* const REALM;
+
+  /**
+   * \brief Static constant for the name of the session cookie.
+   */
+  static const char* const SESSION_COOKIE;
+
+  /**
+   * \brief A struct for the injected faults.
+   */
+  struct Faults
+  {
+    /**
+     * \brief A default constructor (no faults).
+     */
+    Faults() : latency(0), jitter(0), failure_rate(0.0), drop_rate(0.0) {}
+
+    /**
+     * \brief The delay added to each HTTP request [microseconds].
+     */
+    Poco::Int64 latency;
+
+    /**
+     * \brief The maximum random deviation from the latency [microseconds] (uniformly distributed).
+     */
+    Poco::Int64 jitter;
+
+    /**
+     * \brief The probability [0, 1] of answering a HTTP request with 503 Service Unavailable.
+     */
+    double failure_rate;
+
+    /**
+     * \brief The probability [0, 1] of closing the connection instead of answering a HTTP request.
+     */
+    double drop_rate;
+  };
+
+  /**
+   * \brief A struct for the simulator's options.
+   */
+  struct Options
+  {
+    /**
+     * \brief A default constructor.
+     */
+    Options()
+    :
+    address("127.0.0.1"),
+    port(0),
+    username("Default User"),
+    password("robotics"),
+    authentication(true),
+    max_threads(16),
+    seed(0)
+    {}
+
+    /**
+     * \brief The address to listen on.
+     */
+    std::string address;
+
+    /**
+     * \brief The port to listen on (0 selects a free port, see getPort()).
+     */
+    Poco::UInt16 port;
+
+    /**
+     * \brief The accepted user name.
+     */
+    std::string username;
+
+    /**
+     * \brief The accepted password.
+     */
+    std::string password;
+
+    /**
+     * \brief Flag indicating if the requests must be authenticated.
+     */
+    bool authentication;
+
+    /**
+     * \brief The certificate file (PEM) for serving HTTPS (if empty, HTTP is served).
+     */
+    std::string certificate_file;
+
+    /**
+     * \brief The private key file (PEM) for serving HTTPS.
+     */
+    std::string private_key_file;
+
+    /**
+     * \brief The maximum number of concurrent connections (each WebSocket occupies one).
+     */
+    int max_threads;
+
+    /**
+     * \brief The seed for the injected faults' random generator.
+     */
+    unsigned int seed;
+
+    /**
+     * \brief The injected faults.
+     */
+    Faults faults;
+  };
+
+  /**
+   * \brief A constructor.
+   *
+   * \param options for the simulator's options.
+   */
+  RWSSimulator(const Options& options = Options());
+
+  /**
+   * \brief A destructor, which stops the simulator.
+   */
+  ~RWSSimulator();
+
+  /**
+   * \brief A method for starting the simulator.
+   *
+   * \throw Poco::Exception if the server can't be started (e.g. the port is in use).
+   */
+  void start();
+
+  /**
+   * \brief A method for stopping the simulator (closing all connections).
+   */
+  void stop();
+
+  /**
+   * \brief A method for retrieving the port the simulator listens on.
+   *
+   * \return Poco::UInt16 containing the port (0 if the simulator isn't started).
+   */
+  Poco::UInt16 getPort() const { return port_; }
+
+  /**
+   * \brief A method for changing the injected faults.
+   *
+   * \param faults for the faults.
+   */
+  void setFaults(const Faults& faults);
+
+  /**
+   * \brief A method for setting an IO signal (notifying its subscribers).
+   *
+   * \param iosignal for the IO signal's name.
+   * \param value for the IO signal's value.
+   */
+  void setIOSignal(const std::string& iosignal, const std::string& value);
+
+  /**
+   * \brief A method for retrieving an IO signal.
+   *
+   * \param iosignal for the IO signal's name.
+   *
+   * \return std::string containing the value (created as "0" if the IO signal doesn't exist).
+   */
+  std::string getIOSignal(const std::string& iosignal);
+
+  /**
+   * \brief A method for setting a RAPID symbol (notifying its subscribers).
+   *
+   * \param task for the RAPID task's name.
+   * \param module for the RAPID module's name.
+   * \param name for the RAPID symbol's name.
+   * \param value for the RAPID symbol's value (in RAPID syntax).
+   * \param data_type for the RAPID symbol's data type (e.g. "num", "robtarget").
+   */
+  void setRAPIDSymbol(const std::string& task,
+                      const std::string& module,
+                      const std::string& name,
+                      const std::string& value,
+                      const std::string& data_type = "num");
+
+  /**
+   * \brief A method for retrieving a RAPID symbol's value.
+   *
+   * \param task for the RAPID task's name.
+   * \param module for the RAPID module's name.
+   * \param name for the RAPID symbol's name.
+   *
+   * \return std::string containing the value (created as "0" if the symbol doesn't exist).
+   */
+  std::string getRAPIDSymbol(const std::string& task, const std::string& module, const std::string& name);
+
+  /**
+   * \brief A method for retrieving the number of handled HTTP requests (including failed and dropped ones).
+   *
+   * \return Poco::UInt64 containing the number of requests.
+   */
+  Poco::UInt64 getRequestCount();
+
+private:
+  /**
+   * \brief A class for handling the server's requests (defined in the source file).
+   */
+  class RequestHandler;
+
+  /**
+   * \brief A class for creating the server's request handlers (defined in the source file).
+   */
+  class RequestHandlerFactory;
+
+  /**
+   * \brief A struct for a simulated RAPID symbol.
+   */
+  struct RAPIDSymbol
+  {
+    /**
+     * \brief The symbol's value (in RAPID syntax).
+     */
+    std::string value;
+
+    /**
+     * \brief The symbol's data type.
+     */
+    std::string data_type;
+  };
+
+  /**
+   * \brief A struct for a subscription group.
+   */
+  struct SubscriptionGroup
+  {
+    /**
+     * \brief A default constructor.
+     */
+    SubscriptionGroup() : ended(false) {}
+
+    /**
+     * \brief The subscribed resources (e.g. "/rw/iosystem/signals/DO1;state").
+     */
+    std::set<std::string> resources;
+
+    /**
+     * \brief The pending events (as XML list items).
+     */
+    std::deque<std::string> events;
+
+    /**
+     * \brief Flag indicating if the subscription has been ended.
+     */
+    bool ended;
+  };
+
+  /**
+   * \brief A method for handling a request (or a WebSocket upgrade).
+   *
+   * \param request for the request.
+   * \param response for the response.
+   */
+  void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response);
+
+  /**
+   * \brief A method for checking a request's authentication (session cookie or digest credentials).
+   *
+   * \param request for the request.
+   * \param response for the response (a new session's cookie is added to it).
+   *
+   * \return bool indicating if the request is authenticated.
+   */
+  bool authenticate(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response);
+
+  /**
+   * \brief A method for applying the injected faults to a request.
+   *
+   * \param request for the request.
+   * \param response for the response.
+   *
+   * \return bool indicating if the request was answered (or dropped) by a fault.
+   */
+  bool injectFaults(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response);
+
+  /**
+   * \brief A method for routing a (authenticated) RWS request to the simulated resources.
+   *
+   * \param method for the HTTP method.
+   * \param path for the request's path (without a query).
+   * \param form for the request's (form encoded) content.
+   * \param content for the request's (raw) content.
+   * \param host for the request's host (for the subscriptions' locations).
+   * \param response for the response.
+   *
+   * \return std::string containing the response's content.
+   */
+  std::string route(const std::string& method,
+                    const std::string& path,
+                    const std::map<std::string, std::string>& form,
+                    const std::string& content,
+                    const std::string& host,
+                    Poco::Net::HTTPServerResponse& response);
+
+  /**
+   * \brief A method for streaming a subscription group's events over a WebSocket (until it is ended).
+   *
+   * \param id for the subscription group's id.
+   * \param request for the WebSocket upgrade request.
+   * \param response for the response.
+   */
+  void pollSubscription(const std::string& id,
+                        Poco::Net::HTTPServerRequest& request,
+                        Poco::Net::HTTPServerResponse& response);
+
+  /**
+   * \brief A method for notifying the subscription groups about a changed resource.
+   *
+   * Note: The state mutex must be held by the caller.
+   *
+   * \param resource for the changed resource (e.g. "/rw/iosystem/signals/DO1;state").
+   * \param event for the event (as a XML list item).
+   */
+  void notify(const std::string& resource, const std::string& event);
+
+  /**
+   * \brief A method for finding (or creating) a RAPID symbol.
+   *
+   * Note: The state mutex must be held by the caller.
+   *
+   * \param task for the RAPID task's name.
+   * \param module for the RAPID module's name.
+   * \param name for the RAPID symbol's name.
+   *
+   * \return RAPIDSymbol& reference to the symbol.
+   */
+  RAPIDSymbol& findRAPIDSymbol(const std::string& task, const std::string& module, const std::string& name);
+
+  /**
+   * \brief The simulator's options.
+   */
+  const Options options_;
+
+  /**
+   * \brief The port the simulator listens on.
+   */
+  Poco::UInt16 port_;
+
+  /**
+   * \brief The server's thread pool.
+   */
+  Poco::ThreadPool thread_pool_;
+
+  /**
+   * \brief The server.
+   */
+  std::unique_ptr<Poco::Net::HTTPServer> p_server_;
+
+  /**
+   * \brief A mutex for protecting the injected faults, the random generator and the request count.
+   */
+  std::mutex faults_mutex_;
+
+  /**
+   * \brief The injected faults.
+   */
+  Faults faults_;
+
+  /**
+   * \brief The random generator for the injected faults.
+   */
+  std::mt19937 random_generator_;
+
+  /**
+   * \brief The number of handled HTTP requests.
+   */
+  Poco::UInt64 request_count_;
+
+  /**
+   * \brief A mutex for protecting the simulated controller state.
+   */
+  std::mutex state_mutex_;
+
+  /**
+   * \brief A condition for signaling new subscription events (or stopping).
+   */
+  std::condition_variable state_condition_;
+
+  /**
+   * \brief Flag indicating if the simulator is stopping.
+   */
+  bool stopping_;
+
+  /**
+   * \brief The active sessions' ids.
+   */
+  std::set<std::string> sessions_;
+
+  /**
+   * \brief The id for the next session, subscription group or nonce.
+   */
+  Poco::UInt64 next_id_;
+
+  /**
+   * \brief The IO signals (name to value).
+   */
+  std::map<std::string, std::string> iosignals_;
+
+  /**
+   * \brief The RAPID symbols ("task/module/name" to symbol).
+   */
+  std::map<std::string, RAPIDSymbol> rapid_symbols_;
+
+  /**
+   * \brief The RAPID tasks (name to a flag indicating if it is a motion task).
+   */
+  std::map<std::string, bool> rapid_tasks_;
+
+  /**
+   * \brief The files ("directory/name" to content).
+   */
+  std::map<std::string, std::string> files_;
+
+  /**
+   * \brief The subscription groups (id to group).
+   */
+  std::map<std::string, SubscriptionGroup> subscription_groups_;
+
+  /**
+   * \brief The controller state ("motoron" or "motoroff").
+   */
+  std::string controller_state_;
+
+  /**
+   * \brief The operation mode (e.g. "AUTO").
+   */
+  std::string operation_mode_;
+
+  /**
+   * \brief The RAPID execution state ("running" or "stopped").
+   */
+  std::string rapid_execution_;
+
+  /**
+   * \brief Flag indicating if the edit mastership is held.
+   */
+  bool mastership_;
+};
+
+} // end namespace rws
+} // end namespace abb
+
+#endif
@@ -0,0 +1,163 @@
+/***********************************************************************************************************************
+ *
+ * Copyright (c) 
+ * 2015, ABB Schweiz AG
+ * 2021, JOiiNT LAB, Fondazione Istituto Italiano di Tecnologia, Intellimech Consorzio per la Meccatronica.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with
+ * or without modification, are permitted provided that
+ * the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the
+ *      above copyright notice, this list of conditions
+ *      and the following disclaimer in the documentation
+ *      and/or other materials provided with the
+ *      distribution.
+ *    * Neither the name of ABB nor the names of its
+ *      contributors may be used to endorse or promote
+ *      products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ***********************************************************************************************************************
+ * 
+ * Description: Command line entry point that runs the RWS simulator as a standalone server.
+ * 
+ ***********************************************************************************************************************
+ */
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "Poco/Exception.h"
+
+#include "rws_simulator.h"
+
+/**
+ * \brief Flag indicating if the simulator should stop (set by SIGINT/SIGTERM).
+ */
+static std::atomic<bool> stop_requested(false);
+
+/**
+ * \brief A function for handling the stop signals (SIGINT and SIGTERM).
+ */
+static void handleSignal(int)
+{
+  stop_requested = true;
+}
+
+/**
+ * \brief A tool for running a simulated robot controller (see abb::rws::RWSSimulator).
+ *
+ * Usage: rws_simulator [--port <port>] [--cert <file> --key <file>] [--no-auth] [--latency-ms <ms>]
+ *                      [--jitter-ms <ms>] [--failure-rate <p>] [--drop-rate <p>] [--seed <n>]
+ *
+ * The simulator runs until it is interrupted (e.g. with Ctrl+C).
+ */
+int main(int argc, char** argv)
+{
+  abb::rws::RWSSimulator::Options options;
+  options.port = 8080;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char* value = (i + 1 < argc ? argv[i + 1] : 0);
+
+    if (std::strcmp(argv[i], "--no-auth") == 0)
+    {
+      options.authentication = false;
+    }
+    else if (value && std::strcmp(argv[i], "--port") == 0)
+    {
+      options.port = static_cast<Poco::UInt16>(std::atoi(value));
+      ++i;
+    }
+    else if (value && std::strcmp(argv[i], "--cert") == 0)
+    {
+      options.certificate_file = value;
+      ++i;
+    }
+    else if (value && std::strcmp(argv[i], "--key") == 0)
+    {
+      options.private_key_file = value;
+      ++i;
+    }
+    else if (value && std::strcmp(argv[i], "--latency-ms") == 0)
+    {
+      options.faults.latency = static_cast<Poco::Int64>(std::atof(value) * 1000);
+      ++i;
+    }
+    else if (value && std::strcmp(argv[i], "--jitter-ms") == 0)
+    {
+      options.faults.jitter = static_cast<Poco::Int64>(std::atof(value) * 1000);
+      ++i;
+    }
+    else if (value && std::strcmp(argv[i], "--failure-rate") == 0)
+    {
+      options.faults.failure_rate = std::atof(value);
+      ++i;
+    }
+    else if (value && std::strcmp(argv[i], "--drop-rate") == 0)
+    {
+      options.faults.drop_rate = std::atof(value);
+      ++i;
+    }
+    else if (value && std::strcmp(argv[i], "--seed") == 0)
+    {
+      options.seed = static_cast<unsigned int>(std::atoi(value));
+      ++i;
+    }
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [--port <port>] [--cert <file> --key <file>] [--no-auth]"
+                << " [--latency-ms <ms>] [--jitter-ms <ms>] [--failure-rate <p>] [--drop-rate <p>] [--seed <n>]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  std::signal(SIGINT, handleSignal);
+  std::signal(SIGTERM, handleSignal);
+
+  try
+  {
+    abb::rws::RWSSimulator simulator(options);
+    simulator.start();
+
+    std::cout << "Simulating a robot controller on " << (options.certificate_file.empty() ? "http" : "https")
+              << "://" << options.address << ":" << simulator.getPort() << " (Ctrl+C to stop)" << std::endl;
+
+    while (!stop_requested)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    std::cout << "Stopping after " << simulator.getRequestCount() << " requests" << std::endl;
+  }
+  catch (const Poco::Exception& e)
+  {
+    std::cerr << "Failed to run the simulator: " << e.displayText() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}